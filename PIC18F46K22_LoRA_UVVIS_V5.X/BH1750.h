@@ -21,6 +21,8 @@
 #include "i2c1.h" //I2c library
 #include <stdint.h>
 
+extern uint8_t bh1750Address;
+
 /**
  * Writes the continuous reading HResolution mode to the device
  * @param 
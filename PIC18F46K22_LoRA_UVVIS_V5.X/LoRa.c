@@ -2,6 +2,10 @@
 #include "LoRa.h"
 #include <stdint.h>
 #include <stdio.h>
+#include "lowpower.h"
+#include "backoff.h"
+#include "trace.h"
+#include "hal.h"
 
 #define DEBUG 0
 
@@ -14,30 +18,7 @@ void LoRaStart(float freq, uint8_t syncWord){
     ANSELAbits.ANSA2=0; //Digital input buffer enabled
     
     
-    //Configure SPI2 as master
-    //Set up SPI pins first
-    TRISDbits.RD1=1; //SDIx must have corresponding TRIS bit set (input)
-    TRISDbits.RD4=0; //SDOx must have corresponding TRIS bit cleared (output)
-    TRISDbits.RD0=0; //SCKx (Master mode) must have corresponding TRIS bit cleared (output)
-    TRISDbits.RD3=0; //#SS must have corresponding TRIS bit cleared (output)
-    ANSELDbits.ANSD1=0; //Input buffer enabled
-    ANSELDbits.ANSD4=0; //Digital
-    ANSELDbits.ANSD3=0; //Digital
-    ANSELDbits.ANSD0=0; //Digital
-    LATDbits.LATD3=1; //Set SS high so chip is not selected
-    
-    //Clock polarity
-    SSP2CON1bits.CKP=0; //Clock idle low, active high
-    SSP2STATbits.CKE=1; //Active to idle 1
-    
-    //Input data sampling
-    SSP2STATbits.SMP=1; //Input data sampled at end of data output time 1
-    
-    //SPI Mode and clock
-    SSP2CON1bits.SSPM=0b0010; //SPI Master Mode, clock = Fosc/64
-    
-    //SPI Enable
-    SSP2CON1bits.SSPEN=1; //Enabled
+    SPI2Start(); //Configure SPI2 as master
     
     LoRaReset();
     __delay_ms(10);
@@ -56,6 +37,7 @@ void LoRaReset(){
     //Perform reset
     TRISCbits.RC6=0; //Configure port as an output
     LATCbits.LATC6=0; //Set low
+    HAL_KICK(HAL_LORA_RESET);
     __delay_ms(1);
     TRISCbits.RC6=1; //Configure port as input (goes high-Z)
     __delay_ms(5);
@@ -83,81 +65,153 @@ void LoRaMode_RXActive(){
 }
 
 /**
- * SPI2WriteByte
- * Writes an address byte, then writes a data byte
- * @param address
- * @param data
+ * Reads the last received packet out of the FIFO.
+ * @param data      Buffer for the packet
+ * @param maxLength Size of the buffer
+ * @return          Number of bytes received (may be more than was read)
  */
-void SPI2WriteByte(uint8_t address, uint8_t data){
-    SSP2IF=0; //Clear interrupt flag
-    LATDbits.LATD3=0; //Set SS low
-    __delay_us(5);
-    address = address|0x80; //bit 7 set to indicate a register write
-    SSP2BUF=address; //Write address to SPI buffer 
-    while(!SSP2IF){
-        //Wait for transmission to complete
+uint8_t LoRaRXData(uint8_t* data, uint8_t maxLength){
+    uint8_t length = SPI2ReadByte(RX_NB_BYTES_REG);
+    SPI2WriteByte(FIFO_ADD_PTR_REG, SPI2ReadByte(FIFO_RX_CURRENT_REG)); //Start of last packet
+    if(length<maxLength){
+        SPI2ReadBurst(FIFO_REG, data, length);
     }
-    SSP2IF=0; //Clear interrupt flag
-    __delay_us(5);
-    SSP2BUF=data; 
-    while(!SSP2IF){
-        //Wait for transmission and reception to complete
+    else{
+        SPI2ReadBurst(FIFO_REG, data, maxLength);
     }
-    __delay_us(5);
-    LATDbits.LATD3=1; //Set SS high
-    SSP2IF=0; //Clear interrupt flag
-    uint8_t dataByte = SSP2BUF; //A byte has been received but this is not used.
+    return length;
 }
 
 /**
- * SPI2ReadByte
- * Writes an address byte then reads a byte back.  0 is sent as a dummy value
- * for the second transfer.
- * @param address
- * @return 
+ * Opens a single receive window and reads the packet if one arrives with a
+ * good header.  The radio must be in standby and is left in standby.
+ * The radio times the window, the polls only stop waiting if it never ends:
+ * the window plus a packet of maxLength that starts at the end of it, at the
+ * spreading factor in use (33.5s for 1023 symbols at SF12).
+ * @param symbols   Window length in symbols (SYMB_TIMEOUT, 4 to 1023)
+ * @param data      Buffer for the packet
+ * @param maxLength Size of the buffer
+ * @return          Number of bytes received, 0 if nothing arrived
  */
-uint8_t SPI2ReadByte(uint8_t address){
-    SSP2IF=0; //Clear interrupt flag
-    LATDbits.LATD3=0; //Set SS low
-    SSP2BUF=address; //Write data to SPI buffer
-    while(!SSP2IF){
-        //Wait for transmission to complete
+uint8_t LoRaReceiveWindow(uint16_t symbols, uint8_t* data, uint8_t maxLength){
+    uint8_t modemConfig2 = SPI2ReadByte(MODEM_CONFIG_2_REG);
+    uint8_t symbTimeout = SPI2ReadByte(SYMB_TIMEOUT_LSB_REG);
+    //A symbol is 2^SF/125000 seconds, 2ms polls
+    uint32_t polls = (((uint32_t)symbols<<(modemConfig2>>4))/125 + LoRaAirtimeMs(maxLength) + RX_WINDOW_MARGIN_MS)/2;
+    SPI2WriteByte(MODEM_CONFIG_2_REG, (modemConfig2 & 0b11111100) | ((symbols>>8) & 0b11));
+    SPI2WriteByte(SYMB_TIMEOUT_LSB_REG, symbols & 0xFF);
+    LoRaClearIRQFlags();
+    LoRaRXSingleMode();
+    
+    uint8_t flags = 0;
+    for(uint32_t i=0;i<polls;i++){
+        flags = LoRaGetIRQFlags();
+        if(flags & (IRQ_RX_DONE|IRQ_RX_TIMEOUT)){
+            break;
+        }
+        __delay_ms(2);
     }
-    SSP2IF=0; //Clear interrupt flag
-    SSP2BUF=0; //Data byte - for a read, set to 0
-    while(!SSP2IF){
-        //Wait for transmission and reception to complete
+    uint8_t length = 0;
+    if((flags & IRQ_RX_DONE) && !(flags & IRQ_PAYLOAD_CRC_ERROR)){
+        length = LoRaRXData(data, maxLength);
     }
-    SSP2IF=0; //Clear interrupt flag
-    //__delay_us(20);
-    LATDbits.LATD3=1; //Set SS high
-    uint8_t dataByte = SSP2BUF;
-    return dataByte;
+    LoRaStandbyMode(); //In case the window never closed
+    LoRaClearIRQFlags();
+    SPI2WriteByte(MODEM_CONFIG_2_REG, modemConfig2);
+    SPI2WriteByte(SYMB_TIMEOUT_LSB_REG, symbTimeout);
+    return length;
 }
 
 /* 
  * Transmits a data packet.
+ * If LBT_ENABLED is set the channel is checked with CAD first and the packet
+ * is not sent if the channel stays busy.
+ * Returns 1 if transmission was started, 0 if the channel was busy.
  */
-void LoRaTXData(uint8_t* data, uint8_t dataLength){
+uint8_t LoRaTXData(uint8_t* data, uint8_t dataLength){
     //Must be in standby mode for this to work
     LoRaStandbyMode();
     if(DEBUG){
-        printf("Transmitting.... ");
+        TraceEvent(TRACE_TX_START, dataLength);
     }
     SPI2WriteByte(FIFO_ADD_PTR_REG, 0);
     SPI2WriteByte(PAYLOAD_LENGTH_REG, 0);
     
 
-    for(uint8_t i=0;i<dataLength;i++){
-        SPI2WriteByte(FIFO_REG, data[i]);
-    }
+    SPI2WriteBurst(FIFO_REG, data, dataLength);
     SPI2WriteByte(PAYLOAD_LENGTH_REG, dataLength);
-    LoRaTXMode(); //Set TX mode to send the message
-    if(DEBUG){
-        printf("Done.\r\n");
+    if(LBT_ENABLED){
+        //FIFO contents are kept through CAD and standby
+        if(!LoRaListenBeforeTalk()){
+            if(DEBUG){
+                TraceEvent(TRACE_CHANNEL_BUSY, 0);
+            }
+            return 0;
+        }
     }
+    LoRaTXMode(); //Set TX mode to send the message
     //Will return to standby mode automatically when finished.
     //You can check TxDone interrupt to see if it's finished.
+    return 1;
+}
+
+/**
+ * Runs a single channel activity detection.  Module must be in standby.
+ * CAD takes about 2 symbols, 2ms at SF7 and 66ms at SF12 (125kHz), so the
+ * poll budget doubles with each step of spreading factor.
+ * @return CAD_CLEAR, CAD_BUSY or CAD_TIMEOUT
+ */
+uint8_t LoRaChannelActivity(){
+    uint8_t sf = LoRaGetSpreadingFactor();
+    uint16_t polls = LBT_CAD_POLLS;
+    if(sf>7){
+        polls = polls << (sf-7);
+    }
+    LoRaClearIRQFlags();
+    LoRaCADMode();
+    uint8_t flags = 0;
+    for(uint16_t i=0;i<polls;i++){
+        flags = LoRaGetIRQFlags();
+        if(flags & IRQ_CAD_DONE){
+            break;
+        }
+        __delay_us(50);
+    }
+    LoRaClearIRQFlags(); //Module returns to standby by itself after CAD
+    if(!(flags & IRQ_CAD_DONE)){
+        LoRaStandbyMode();
+        return CAD_TIMEOUT;
+    }
+    if(flags & IRQ_CAD_DETECTED){
+        return CAD_BUSY;
+    }
+    return CAD_CLEAR;
+}
+
+/**
+ * Checks the channel is clear, backing off in low power idle while it is busy.
+ * The backoff doubles on each attempt with a random component, limited by
+ * LBT_MAX_TRIES and LBT_MAX_TIME_MS.  A CAD that does not finish is taken as
+ * busy rather than sending blind.
+ * @return 1 if the channel is clear, 0 if it stayed busy
+ */
+uint8_t LoRaListenBeforeTalk(){
+    uint16_t waited = 0;
+    uint16_t backoff = LBT_BACKOFF_MS;
+    for(uint8_t tries=0;tries<LBT_MAX_TRIES;tries++){
+        uint8_t result = LoRaChannelActivity();
+        if(result==CAD_CLEAR){
+            return 1;
+        }
+        uint16_t delay = backoff + (BackoffRandom() % backoff);
+        if(waited + delay > LBT_MAX_TIME_MS){
+            break;
+        }
+        LowPowerDelayMs(delay);
+        waited = waited + delay;
+        backoff = backoff * 2;
+    }
+    return 0;
 }
 
 /**
@@ -193,7 +247,7 @@ void LoRaFreqSynthTXMode(){
 
 void LoRaTXMode(){
     if(DEBUG){
-        printf("TX Mode\r\n");
+        TraceEvent(TRACE_TX_MODE, 0);
     }
     uint8_t regValue = readOpModeRegister(); //Read whats in there already
     regValue = regValue & 0b11111000; //Blank out other modes
@@ -201,6 +255,20 @@ void LoRaTXMode(){
     writeOpModeRegister(regValue); //Write the value back
 }
 
+void LoRaCADMode(){
+    uint8_t regValue = readOpModeRegister(); //Read whats in there already
+    regValue = regValue & 0b11111000; //Blank out other modes
+    regValue = regValue | CAD_MODE; //Channel activity detection
+    writeOpModeRegister(regValue); //Write the value back
+}
+
+void LoRaRXSingleMode(){
+    uint8_t regValue = readOpModeRegister(); //Read whats in there already
+    regValue = regValue & 0b11111000; //Blank out other modes
+    regValue = regValue | RX_SINGLE_MODE; //Receive one packet or time out, then back to standby
+    writeOpModeRegister(regValue); //Write the value back
+}
+
 void LoRaRXContinuousMode(){
     uint8_t regValue = readOpModeRegister(); //Read whats in there already
     regValue = regValue & 0b11111000; //Blank out other modes
@@ -251,6 +319,69 @@ void LoRaClearIRQFlags(){
 }
 
 
+/**
+ * Sets the power amplifier configuration register.
+ * @param paConfig  PaSelect (bit 7), MaxPower (6-4), OutputPower (3-0)
+ */
+void LoRaSetPAConfig(uint8_t paConfig){
+    SPI2WriteByte(PA_CONFIG_REG, paConfig);
+}
+
+/**
+ * Sets the spreading factor (7 to 12) and the low data rate optimisation
+ * which is required for SF11 and SF12 at 125kHz.
+ * @param sf    Spreading factor
+ */
+void LoRaSetSpreadingFactor(uint8_t sf){
+    uint8_t regValue = SPI2ReadByte(MODEM_CONFIG_2_REG);
+    regValue = (regValue & 0x0F) | (uint8_t)(sf<<4);
+    SPI2WriteByte(MODEM_CONFIG_2_REG, regValue);
+    regValue = SPI2ReadByte(MODEM_CONFIG_3_REG);
+    if(sf>=11){
+        regValue = regValue | 0b00001000; //LowDataRateOptimize on
+    }
+    else{
+        regValue = regValue & 0b11110111;
+    }
+    SPI2WriteByte(MODEM_CONFIG_3_REG, regValue);
+}
+
+/**
+ * @return Spreading factor in use (6 to 12)
+ */
+uint8_t LoRaGetSpreadingFactor(){
+    return SPI2ReadByte(MODEM_CONFIG_2_REG)>>4;
+}
+
+/**
+ * LoRa time on air at the current settings (SX1276 datasheet 4.1.1.7),
+ * assuming the 125kHz bandwidth LoRaOptimalLoad sets.  97.5ms for a 50 byte
+ * packet at SF7, 2.3s at SF12.
+ * @param length    Payload length in bytes
+ * @return          Time on air in milliseconds, rounded up
+ */
+uint16_t LoRaAirtimeMs(uint8_t length){
+    uint8_t modemConfig1 = SPI2ReadByte(MODEM_CONFIG_1_REG);
+    uint8_t modemConfig2 = SPI2ReadByte(MODEM_CONFIG_2_REG);
+    uint8_t sf = modemConfig2>>4;
+    uint8_t cr = (modemConfig1>>1) & 0x07; //1 to 4 for 4/5 to 4/8
+    uint8_t ldro = (SPI2ReadByte(MODEM_CONFIG_3_REG)>>3) & 0x01;
+    int16_t bits = 8*(int16_t)length - 4*sf + 28;
+    if(modemConfig2 & 0b00000100){
+        bits += 16; //Payload CRC
+    }
+    if(modemConfig1 & 0x01){
+        bits -= 20; //Implicit header
+    }
+    //In quarter symbols: the preamble plus 4.25, then the 8 symbol header
+    uint16_t quarters = 4*(uint16_t)SPI2ReadByte(PREAMBLE_LSB_REG) + 49;
+    if(bits>0){
+        uint8_t perSymbol = 4*(sf-2*ldro);
+        quarters += 4*(uint16_t)((bits+perSymbol-1)/perSymbol)*(cr+4);
+    }
+    return (uint16_t)((((uint32_t)quarters<<sf)*2 + 999)/1000); //A symbol is 2^SF*8us at 125kHz
+}
+
 /**
  * Dumps the contents of all registers to printf
  */
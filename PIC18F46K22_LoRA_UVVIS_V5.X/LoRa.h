@@ -11,8 +11,9 @@
 #define	LORA_H
 
 #include <stdint.h>
+#include "spi2.h"
 
-#define _XTAL_FREQ 64000000
+#define _XTAL_FREQ 16000000
 //NB ONLY LoRa REGISTERS ARE DEFINED - FSK/OOK MODE REGISTERS ARE NOT!
 #define FIFO_REG 0x00
 #define OP_MODE_REG 0x01
@@ -91,6 +92,30 @@
 #define BW250k 0b1000
 #define BW500k 0b1001
 
+//IRQ flags register bits
+#define IRQ_RX_TIMEOUT 0b10000000
+#define IRQ_RX_DONE 0b01000000
+#define IRQ_PAYLOAD_CRC_ERROR 0b00100000
+#define IRQ_VALID_HEADER 0b00010000
+#define IRQ_TX_DONE 0b00001000
+#define IRQ_CAD_DONE 0b00000100
+#define IRQ_FHSS_CHANGE_CHANNEL 0b00000010
+#define IRQ_CAD_DETECTED 0b00000001
+
+//Listen before talk (channel activity detection before each transmission)
+#define LBT_ENABLED 1
+#define LBT_MAX_TRIES 5       //Number of CAD attempts before giving up
+#define LBT_BACKOFF_MS 100    //Base backoff when the channel is busy (about one packet)
+#define LBT_MAX_TIME_MS 2000  //Upper limit on the total time spent backing off
+#define LBT_CAD_POLLS 100     //50us polls at SF7, doubled for each SF above (CAD is about 2 symbols)
+
+//Receive windows (RX single)
+#define RX_WINDOW_MARGIN_MS 20 //Added to the window and the packet time before giving up on the radio
+
+//Results from LoRaChannelActivity
+#define CAD_CLEAR 0
+#define CAD_BUSY 1
+#define CAD_TIMEOUT 2
 
 
 void LoRaStart(float, uint8_t);
@@ -106,21 +131,25 @@ void LoRaFreqSynthRXMode();
 void LoRaFreqSynthTXMode();
 void LoRaTXMode();
 void LoRaRXContinuousMode();
+void LoRaRXSingleMode();
 void LoRaMode_RXActive(); //Set LoRa mode with receiver always active
+void LoRaCADMode();
+uint8_t LoRaChannelActivity(); //Runs a single CAD
+uint8_t LoRaListenBeforeTalk(); //Waits for a clear channel
 
 //int8_t LoRaGetTemp();
-void LoRaTXData(uint8_t* , uint8_t); //Sends a data packet of length dataLength
+uint8_t LoRaTXData(uint8_t* , uint8_t); //Sends a data packet of length dataLength
 //void LoRaSetPreamble(uint16_t);
 //uint16_t LoRaGetPreamble();
-void SPI2WriteByte(uint8_t, uint8_t);
-uint8_t SPI2ReadByte(uint8_t);
+uint8_t LoRaRXData(uint8_t*, uint8_t); //Reads the last received packet
+uint8_t LoRaReceiveWindow(uint16_t, uint8_t*, uint8_t); //Listens for one packet
 void LoRaSetFrequency(float);
 float LoRaGetFrequency(void);
 //void LoRaSetBandwidth(uint8_t);
 //uint8_t LoRaGetBandwidth();
 uint8_t LoRaGetIRQFlags();
 void LoRaClearIRQFlags();
-//void LoRaSetPAConfig(uint8_t);
+void LoRaSetPAConfig(uint8_t);
 //uint8_t LoRaGetPAConfig();
 //void LoRaSetPABoostOn();
 //uint8_t LoRaGetPABoostOn();
@@ -135,8 +164,9 @@ void LoRaClearIRQFlags();
 //uint8_t LoRaGetCodingRate();
 //void LoRaImplicitHeaderMode();
 //void LoRaExplicitHeaderMode();
-//void LoRaSetSpreadingFactor(uint8_t);
-//uint8_t LoRaGetSpreadingFactor();
+void LoRaSetSpreadingFactor(uint8_t);
+uint8_t LoRaGetSpreadingFactor();
+uint16_t LoRaAirtimeMs(uint8_t);
 //uint8_t LoRaGetSyncWord();
 //void LoRaSetSyncWord(uint8_t);
 //void LoRaSetPayloadLength(uint8_t);
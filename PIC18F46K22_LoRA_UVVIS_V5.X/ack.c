@@ -0,0 +1,83 @@
+/**
+ * ack.c
+ * Listens for ACK frames and keeps a small queue of packets that have not
+ * been acknowledged yet.  The queue is in RAM so is lost on power failure.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <xc.h>
+#include <stdint.h>
+#include "ack.h"
+#include "LoRa.h"
+#include "CRC16.h"
+
+static uint8_t ackQueue[ACK_QUEUE_LENGTH][ACK_PACKET_LENGTH];
+static uint8_t ackQueueHead = 0; //Oldest packet
+uint8_t ackQueueCount = 0;
+
+/**
+ * Opens the ACK window after a transmission.  Radio must be in standby.
+ * @param packet    The packet that was just sent (address and count are taken from it)
+ * @return 1 if the packet was acknowledged
+ */
+uint8_t AckReceive(const uint8_t* packet){
+    uint8_t rxData[ACK_LENGTH];
+    uint8_t length = LoRaReceiveWindow(ACK_RX_SYMBOLS, rxData, ACK_LENGTH);
+    if(length!=ACK_LENGTH || rxData[0]!=ACK_LENGTH){
+        return 0;
+    }
+    if(rxData[1]!=ACK_ID0 || rxData[2]!=ACK_ID1){
+        return 0;
+    }
+    for(uint8_t i=0;i<8;i++){
+        if(rxData[i+3]!=packet[i+3]){
+            return 0; //For another node
+        }
+    }
+    for(uint8_t i=0;i<4;i++){
+        if(rxData[i+11]!=packet[i+12]){
+            return 0; //For another message
+        }
+    }
+    unsigned short int calcCRC = CRC16(rxData, ACK_LENGTH-2);
+    uint16_t rxCRC = rxData[ACK_LENGTH-2] | (uint16_t)rxData[ACK_LENGTH-1]<<8;
+    return calcCRC==rxCRC;
+}
+
+/**
+ * Queues a packet to send again next cycle.  If the queue is full the oldest
+ * packet is dropped.
+ * @param packet    ACK_PACKET_LENGTH bytes
+ */
+void AckQueuePush(const uint8_t* packet){
+    if(ackQueueCount==ACK_QUEUE_LENGTH){
+        AckQueuePop(); //Drop the oldest
+    }
+    uint8_t slot = (ackQueueHead + ackQueueCount) % ACK_QUEUE_LENGTH;
+    for(uint8_t i=0;i<ACK_PACKET_LENGTH;i++){
+        ackQueue[slot][i] = packet[i];
+    }
+    ackQueueCount++;
+}
+
+/**
+ * Oldest queued packet, or 0 if the queue is empty.
+ */
+uint8_t* AckQueuePeek(void){
+    if(ackQueueCount==0){
+        return 0;
+    }
+    return ackQueue[ackQueueHead];
+}
+
+/**
+ * Removes the oldest queued packet.
+ */
+void AckQueuePop(void){
+    if(ackQueueCount==0){
+        return;
+    }
+    ackQueueHead = (ackQueueHead + 1) % ACK_QUEUE_LENGTH;
+    ackQueueCount--;
+}
@@ -0,0 +1,44 @@
+/* 
+ * File:   ack.h
+ * Author: Andy Page
+ * Comments: Acknowledged delivery.  After each packet the node listens
+ *           briefly for an ACK from the base station and keeps packets that
+ *           were not acknowledged to send again next cycle.
+ * Revision history: 1, 19th October 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef INC_ACK_H
+#define	INC_ACK_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+
+/*
+ * ACK frame (CRC16 as used for the uplink, LSB first)
+ * 0        Length (ACK_LENGTH)
+ * 1        ID0 (0x00 base receiver)
+ * 2        ACK_ID1 (ACK for a type 2 sensor)
+ * 3-10     Address of the node being acknowledged
+ * 11-14    Message count being acknowledged (MSB first, as in the uplink)
+ * 15-16    CRC16 of bytes 0-14
+ */
+#define ACK_LENGTH 17
+#define ACK_ID0 0x00
+#define ACK_ID1 0x42
+#define ACK_RX_SYMBOLS 50       //ACK window, 51ms at SF7/125kHz
+#define ACK_MAX_RETRIES 3       //Retransmissions after the first attempt
+#define ACK_BACKOFF_MS 200      //First retry backoff, doubles each retry
+#define ACK_QUEUE_LENGTH 4      //Unacknowledged packets kept for the next cycle
+#define ACK_PACKET_LENGTH 50    //Same as DATA_PACKET_LENGTH
+
+extern uint8_t ackQueueCount;
+
+uint8_t AckReceive(const uint8_t*);
+void AckQueuePush(const uint8_t*);
+uint8_t* AckQueuePeek(void);
+void AckQueuePop(void);
+
+#endif	/* INC_ACK_H */
+
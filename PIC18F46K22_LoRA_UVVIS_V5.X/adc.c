@@ -0,0 +1,106 @@
+/**
+ * adc.c
+ * A to D converter for battery and temperature readings.
+ * Each conversion is started and the core put to sleep (or Idle if running
+ * from the crystal, so that it doesn't have to wait for the crystal to
+ * restart).  The FRC clock keeps the conversion going and ADIF wakes us.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <xc.h>
+#include <stdint.h>
+#include "defines.h"
+#include "adc.h"
+
+static uint8_t adcReference = 0xFF; //Reference used for the last conversion
+
+/**
+ * Sets up AN0 and AN1 and turns on the fixed voltage reference.  Call this
+ * early so the FVR has settled by the time it is used.
+ */
+void ADCStart(void){
+    //Set ANSELbit to disable digital input buffer
+    ANSELAbits.ANSA0=1;
+    ANSELAbits.ANSA1=1;
+    
+    //Set TRISXbit to disable digital output driver
+    TRISAbits.RA0=1;
+    TRISAbits.RA1=1;
+    
+    //Set voltage references
+    ADCON1bits.PVCFG=ADC_REF_VDD; //A/D Vref+ connected to Vdd
+    ADCON1bits.NVCFG=0; //A/D Vref- connected to internal signal AVss
+    VREFCON0bits.FVRS=0b01; //Fixed voltage reference is 1.024V
+    VREFCON0bits.FVREN=1; //Enable internal reference
+    adcReference = 0xFF; //First conversion after power up is thrown away
+    
+    //Select channel 0 for A to D
+    ADCON0bits.CHS=ADC_CH_BATTERY;
+    
+    //Set A to D acquisition time (done automatically before each conversion)
+    ADCON2bits.ACQT=0b101; //Tacq = 12 Tad (about 20us with FRC)
+    
+    //Set A to D clock period
+    ADCON2bits.ADCS=0b111; //FRC, runs with the core asleep
+    
+    //Set result format
+    ADCON2bits.ADFM = 1; //Data is mostly in the ADRESL register with 2 bits in the ADRESH register
+    
+    //Turn on the A to D module
+    ADCON0bits.ADON=1;
+}
+
+/**
+ * Turns off the A to D and the FVR to save power.
+ */
+void ADCStop(void){
+    ADCON0bits.ADON=0; //Turn off A to D module
+    VREFCON0bits.FVREN=0; //Disable internal reference
+}
+
+/**
+ * Does one conversion with the core asleep.
+ */
+static uint16_t adcConvert(void){
+    uint8_t idle = OSCCONbits.IDLEN;
+    OSCCONbits.IDLEN = OSCCONbits.OSTS; //Idle if running from the crystal, sleep otherwise
+    PIR1bits.ADIF=0;
+    PIE1bits.ADIE=1; //Allows the A to D to wake the core
+    INTCONbits.PEIE=1; //Peripheral wake up enabled (no vectoring unless the debug UART has GIE on)
+    ADCON0bits.GO_NOT_DONE=1; //Start the A to D process
+    SLEEP(); //FRC conversion starts one cycle later, ADIF wakes us
+    while(ADCON0bits.GO_NOT_DONE){
+        //In case something else woke us
+    }
+    PIE1bits.ADIE=0;
+    PIR1bits.ADIF=0;
+    OSCCONbits.IDLEN = idle;
+    return (uint16_t)ADRESH * 256 + ADRESL; //Read A to D result
+}
+
+/**
+ * Reads a channel, oversampled by 2^ADC_SAMPLES_LOG2 and decimated to
+ * 10+ADC_EXTRA_BITS bits.
+ * @param channel   ADC_CH_BATTERY or ADC_CH_TEMPERATURE
+ * @param reference ADC_REF_VDD or ADC_REF_FVR
+ * @return          The reading
+ */
+uint16_t ADCRead(uint8_t channel, uint8_t reference){
+    if(reference==ADC_REF_FVR){
+        for(uint8_t i=0;i<ADC_FVR_TIMEOUT && !VREFCON0bits.FVRST;i++){
+            __delay_us(25); //FVR takes up to 25us (typ) to start
+        }
+    }
+    ADCON1bits.PVCFG=reference;
+    ADCON0bits.CHS=channel;
+    if(reference!=adcReference){
+        adcConvert(); //Throw away the first conversion after the reference changes
+        adcReference=reference;
+    }
+    uint32_t sum = 0;
+    for(uint8_t i=0;i<(1u<<ADC_SAMPLES_LOG2);i++){
+        sum = sum + adcConvert();
+    }
+    return (uint16_t)(sum >> (ADC_SAMPLES_LOG2 - ADC_EXTRA_BITS));
+}
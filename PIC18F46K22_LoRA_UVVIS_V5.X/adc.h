@@ -0,0 +1,36 @@
+/* 
+ * File:   adc.h
+ * Author: Andy Page
+ * Comments: A to D converter.  Conversions use the FRC clock so they carry on
+ *           with the core asleep, and are oversampled to reduce noise.
+ * Revision history: 1, 19th October 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef INC_ADC_H
+#define	INC_ADC_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+
+#define ADC_CH_BATTERY 0        //AN0, battery through divider R4/R13
+#define ADC_CH_TEMPERATURE 1    //AN1, NTC RT1 and R14 divider from Vdd
+
+#define ADC_REF_VDD 0b00        //PVCFG value for Vdd
+#define ADC_REF_FVR 0b10        //PVCFG value for FVR BUF2 (1.024V)
+
+#define ADC_SAMPLES_LOG2 4      //16 samples per reading
+#define ADC_EXTRA_BITS 0        //Extra bits kept after decimation (0 = 10-bit result, same scale as a single conversion)
+#define ADC_FVR_TIMEOUT 200     //Polls of FVRST before giving up (about 25us each)
+
+#if 2*ADC_EXTRA_BITS > ADC_SAMPLES_LOG2
+#error "ADC_EXTRA_BITS can't be more than ADC_SAMPLES_LOG2/2, each extra bit takes 4 times the samples"
+#endif
+
+void ADCStart(void);
+void ADCStop(void);
+uint16_t ADCRead(uint8_t, uint8_t);
+
+#endif	/* INC_ADC_H */
+
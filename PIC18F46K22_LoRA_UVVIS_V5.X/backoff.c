@@ -0,0 +1,60 @@
+/**
+ * backoff.c
+ * Transmit backoff using a 32-bit xorshift pseudo random generator.
+ * The generator is seeded from the node address and the message count so that
+ * every node picks a different delay every time, even when they all power up
+ * together after a brown-out.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <xc.h>
+#include <stdint.h>
+#include "backoff.h"
+#include "lowpower.h"
+
+static uint32_t backoffState = 1;
+
+/**
+ * Seeds the generator.
+ * @param address       8-byte node address
+ * @param messageCount  Current message count
+ */
+void BackoffSeed(const uint8_t* address, uint32_t messageCount){
+    uint32_t seed = 0x811C9DC5; //FNV-1a offset basis
+    for(uint8_t i=0;i<8;i++){
+        seed = (seed ^ address[i]) * 0x01000193; //FNV-1a prime
+    }
+    seed = seed ^ messageCount;
+    if(seed==0){
+        seed = 1; //xorshift must never be seeded with 0
+    }
+    backoffState = seed;
+    BackoffRandom(); //Stir once so consecutive counts are not correlated
+}
+
+/**
+ * Returns the next 16-bit pseudo random number.
+ */
+uint16_t BackoffRandom(void){
+    uint32_t x = backoffState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    backoffState = x;
+    return (uint16_t)(x>>16);
+}
+
+/**
+ * Waits a random number of packet slots (0 to nodeCount-1) in low power idle,
+ * plus a random fraction of a slot so that slots do not line up exactly.
+ * @param nodeCount Number of nodes sharing the channel
+ */
+void BackoffJitter(uint8_t nodeCount){
+    if(nodeCount<2){
+        return;
+    }
+    uint16_t slot = BackoffRandom() % nodeCount;
+    uint16_t fraction = BackoffRandom() % BACKOFF_SLOT_MS;
+    LowPowerDelayMs(slot*BACKOFF_SLOT_MS + fraction);
+}
@@ -0,0 +1,24 @@
+/* 
+ * File:   backoff.h
+ * Author: Andy Page
+ * Comments: Pseudo random transmit backoff so that nodes woken at the same
+ *           time do not keep transmitting on top of each other.
+ * Revision history: 1, 19th October 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef INC_BACKOFF_H
+#define	INC_BACKOFF_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+
+#define BACKOFF_SLOT_MS 100 //About one 50 byte packet at SF7/125kHz (97.5ms)
+
+void BackoffSeed(const uint8_t*, uint32_t);
+uint16_t BackoffRandom(void);
+void BackoffJitter(uint8_t);
+
+#endif	/* INC_BACKOFF_H */
+
@@ -0,0 +1,61 @@
+/**
+ * clock.c
+ * Switches the system clock between HFINTOSC, the crystal and LFINTOSC.
+ * The crystal drive is only turned on while the crystal is selected
+ * (PRICLKEN=OFF), the 4x PLL is not used.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <xc.h>
+#include <stdint.h>
+#include "clock.h"
+#include "usart2.h"
+#include "hal.h"
+
+uint8_t clockSource = CLOCK_CRYSTAL; //Reset runs from the primary oscillator (IESO=OFF)
+
+/**
+ * Selects the system clock.  Returns when the new clock is running.
+ * If the crystal fails to start the clock stays on HFINTOSC.
+ * @param source    CLOCK_HFINTOSC, CLOCK_CRYSTAL or CLOCK_LFINTOSC
+ * @return The clock that was selected before
+ */
+uint8_t ClockSelect(uint8_t source){
+    uint8_t previous = clockSource;
+    if(source==previous){
+        return previous;
+    }
+    USART2_Flush(); //Debug output would come out at the wrong baud rate
+    if(source==CLOCK_CRYSTAL){
+        OSCCON2bits.PRISD=1; //Crystal drive on
+        OSCCONbits.SCS=0b00; //Primary clock as set by FOSC
+        HAL_KICK(HAL_OSC);
+        uint16_t polls = CLOCK_OST_TIMEOUT;
+        while(!OSCCONbits.OSTS && polls>0){
+            polls--; //Runs on HFINTOSC until the start-up timer expires
+        }
+        if(OSCCONbits.OSTS){
+            clockSource = CLOCK_CRYSTAL;
+            return previous;
+        }
+        source = CLOCK_HFINTOSC; //No crystal, carry on from the internal oscillator
+    }
+    if(source==CLOCK_LFINTOSC){
+        OSCTUNEbits.INTSRC=0; //31kHz comes from LFINTOSC
+        OSCCONbits.IRCF=0b000; //31kHz
+    }
+    else{
+        OSCCONbits.IRCF=0b111; //16MHz
+    }
+    OSCCONbits.SCS=0b10; //Run from internal oscillator block
+    HAL_KICK(HAL_OSC);
+    if(source==CLOCK_HFINTOSC){
+        while(!OSCCONbits.HFIOFS){
+            //HFINTOSC stable (immediate with HFOFST=ON)
+        }
+    }
+    OSCCON2bits.PRISD=0; //Crystal drive off
+    clockSource = source;
+    return previous;
+}
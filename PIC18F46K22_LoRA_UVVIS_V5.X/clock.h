@@ -0,0 +1,32 @@
+/* 
+ * File:   clock.h
+ * Author: Andy Page
+ * Comments: System clock manager.  Each wake starts on the 16MHz HFINTOSC
+ *           (HFOFST=ON so there is no start-up wait) and only switches to the
+ *           16MHz crystal for things that need its accuracy (the debug UART).
+ *           Both run at _XTAL_FREQ so every compile time delay and baud rate
+ *           stays correct whichever one is selected.  LFINTOSC is only used
+ *           for low power waits, nothing timed by _XTAL_FREQ runs on it.
+ * Revision history: 1, 19th October 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef INC_CLOCK_H
+#define	INC_CLOCK_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+
+//Clock sources for ClockSelect
+#define CLOCK_HFINTOSC 0 //16MHz internal, ready straight after wake (the default)
+#define CLOCK_CRYSTAL 1  //16MHz crystal, waits for the oscillator start-up timer
+#define CLOCK_LFINTOSC 2 //31kHz internal, for low power waits only
+
+#define CLOCK_OST_TIMEOUT 50000 //Crystal start-up polls before falling back to HFINTOSC
+
+extern uint8_t clockSource; //Clock currently selected
+
+uint8_t ClockSelect(uint8_t);
+
+#endif	/* INC_CLOCK_H */
@@ -10,12 +10,12 @@
 #ifndef INC_CONFIG_H
 #define	INC_CONFIG_H
 
-#define _XTAL_FREQ 64000000
+#define _XTAL_FREQ 16000000 //HFINTOSC and the crystal both run at 16MHz, see clock.h
 
 // CONFIG1H
 #pragma config FOSC = HSMP        // Oscillator Selection bits (High speed crystal oscillator)
-#pragma config PLLCFG = ON      // 4X PLL Enable (Oscillator multiplied by 4)
-#pragma config PRICLKEN = ON    // Primary clock enable bit (Primary clock is always enabled)
+#pragma config PLLCFG = OFF     // 4X PLL Enable (Oscillator used directly)
+#pragma config PRICLKEN = OFF   // Primary clock enable bit (Primary clock can be disabled by software)
 #pragma config FCMEN = OFF      // Fail-Safe Clock Monitor Enable bit (Fail-Safe Clock Monitor disabled)
 #pragma config IESO = OFF       // Internal/External Oscillator Switchover bit (Oscillator Switchover mode disabled)
 
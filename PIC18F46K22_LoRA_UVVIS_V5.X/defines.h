@@ -8,7 +8,9 @@
 #ifndef INC_DEFINES_H
 #define	INC_DEFINES_H
 
-#define _XTAL_FREQ 64000000
+#define _XTAL_FREQ 16000000
+#define TX_FREQ 866.5       //Sensor channel (MHz), away from LoRaWAN
+#define SYNC_WORD 0x55      //Private sync word, away from LoRaWAN
 #define GREEN_LED LATEbits.LATE1 //Green LED output port
 #define RED_LED LATEbits.LATE2 //Red LED output port
 #define INT_TIME 400   //UV Sensor integration time
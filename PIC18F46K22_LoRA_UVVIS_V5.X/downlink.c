@@ -0,0 +1,46 @@
+/**
+ * downlink.c
+ * Opens a single receive window (RX_SINGLE, length set by SYMB_TIMEOUT) and
+ * applies any settings frame addressed to this node.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <xc.h>
+#include <stdint.h>
+#include "downlink.h"
+#include "settings.h"
+#include "LoRa.h"
+#include "CRC16.h"
+
+/**
+ * Listens for a settings frame.  The radio must be in standby (it returns to
+ * standby by itself after TX).
+ * @param address   8-byte node address
+ * @return DOWNLINK_NONE, DOWNLINK_APPLIED or DOWNLINK_REJECTED
+ */
+uint8_t DownlinkReceive(const uint8_t* address){
+    uint8_t rxData[DOWNLINK_LENGTH];
+    uint8_t length = LoRaReceiveWindow(DOWNLINK_RX_SYMBOLS, rxData, DOWNLINK_LENGTH);
+    
+    if(length!=DOWNLINK_LENGTH || rxData[0]!=DOWNLINK_LENGTH){
+        return DOWNLINK_NONE;
+    }
+    if(rxData[1]!=DOWNLINK_ID0 || rxData[2]!=DOWNLINK_ID1){
+        return DOWNLINK_NONE;
+    }
+    for(uint8_t i=0;i<8;i++){
+        if(rxData[i+3]!=address[i]){
+            return DOWNLINK_NONE; //For another node
+        }
+    }
+    unsigned short int calcCRC = CRC16(rxData, DOWNLINK_LENGTH-2);
+    uint16_t rxCRC = rxData[DOWNLINK_LENGTH-2] | (uint16_t)rxData[DOWNLINK_LENGTH-1]<<8;
+    if(calcCRC!=rxCRC){
+        return DOWNLINK_REJECTED;
+    }
+    if(!SettingsApply(rxData+11)){
+        return DOWNLINK_REJECTED;
+    }
+    return DOWNLINK_APPLIED;
+}
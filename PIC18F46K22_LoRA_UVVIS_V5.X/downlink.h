@@ -0,0 +1,40 @@
+/* 
+ * File:   downlink.h
+ * Author: Andy Page
+ * Comments: Short receive window after transmitting so the base station can
+ *           send new settings to a node.
+ * Revision history: 1, 19th October 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef INC_DOWNLINK_H
+#define	INC_DOWNLINK_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+#include "settings.h"
+
+/*
+ * Downlink frame (CRC16 as used for the uplink, LSB first)
+ * 0        Length (DOWNLINK_LENGTH)
+ * 1        ID0 (0x00 base receiver)
+ * 2        DOWNLINK_ID1 (settings for a type 2 sensor)
+ * 3-10     Address of the node the settings are for
+ * 11-16    Parameter block (see settings.h)
+ * 17-18    CRC16 of bytes 0-16
+ */
+#define DOWNLINK_LENGTH (11+SETTINGS_BLOCK_LENGTH+2)
+#define DOWNLINK_ID0 0x00
+#define DOWNLINK_ID1 0x82
+#define DOWNLINK_RX_SYMBOLS 255 //RX window length (SYMB_TIMEOUT), 261ms at SF7/125kHz
+
+//Results from DownlinkReceive
+#define DOWNLINK_NONE 0
+#define DOWNLINK_APPLIED 1
+#define DOWNLINK_REJECTED 2
+
+uint8_t DownlinkReceive(const uint8_t*);
+
+#endif	/* INC_DOWNLINK_H */
+
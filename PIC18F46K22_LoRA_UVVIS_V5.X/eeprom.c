@@ -0,0 +1,54 @@
+/**
+ * eeprom.c
+ * Byte read and write for the data EEPROM.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <xc.h>
+#include <stdint.h>
+#include "eeprom.h"
+#include "hal.h"
+
+/**
+ * Reads a byte from data EEPROM
+ * @param address   EEPROM address
+ * @return          The byte stored there
+ */
+uint8_t EEPROMReadByte(uint8_t address){
+    EEADR = address;
+    EECON1bits.EEPGD=0; //Data EEPROM, not flash
+    EECON1bits.CFGS=0; //Not configuration registers
+    EECON1bits.RD=1; //Start read (completes in one cycle)
+    HAL_KICK(HAL_EEPROM);
+    return EEDATA;
+}
+
+/**
+ * Writes a byte to data EEPROM.  The write is skipped if the byte already
+ * holds the value to save wear.  Blocks for about 4ms while the write happens.
+ * @param address   EEPROM address
+ * @param data      Byte to write
+ */
+void EEPROMWriteByte(uint8_t address, uint8_t data){
+    if(EEPROMReadByte(address)==data){
+        return; //Nothing to do
+    }
+    EEADR = address;
+    EEDATA = data;
+    EECON1bits.EEPGD=0; //Data EEPROM, not flash
+    EECON1bits.CFGS=0; //Not configuration registers
+    EECON1bits.WREN=1; //Allow writes
+    uint8_t gie = INTCONbits.GIE;
+    INTCONbits.GIE=0; //Unlock sequence must not be interrupted
+    EECON2 = 0x55;
+    EECON2 = 0xAA;
+    EECON1bits.WR=1; //Start the write
+    HAL_KICK(HAL_EEPROM);
+    INTCONbits.GIE=gie;
+    while(EECON1bits.WR){
+        //Wait for write to complete
+    }
+    EECON1bits.WREN=0; //Prevent accidental writes
+    PIR2bits.EEIF=0;
+}
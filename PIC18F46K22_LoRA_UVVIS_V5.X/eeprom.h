@@ -0,0 +1,26 @@
+/* 
+ * File:   eeprom.h
+ * Author: Andy Page
+ * Comments: Read and write the 256 byte data EEPROM of the PIC18F46K22
+ * Revision history: 1, 19th October 2026
+ * 
+ * EEPROM map
+ * 0x00-0x0F Settings (see settings.h)
+ * 0x10-0x37 Message count checkpoints (see samplelog.h)
+ * 0x38-0xF7 Sample log, 12 records of 16 bytes (see samplelog.h)
+ * 0xF8-0xFF Unused
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef INC_EEPROM_H
+#define	INC_EEPROM_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+
+uint8_t EEPROMReadByte(uint8_t);
+void EEPROMWriteByte(uint8_t, uint8_t);
+
+#endif	/* INC_EEPROM_H */
+
@@ -0,0 +1,36 @@
+/* 
+ * File:   hal.h
+ * Author: Andy Page
+ * Comments: Hardware abstraction for the host simulator (sim/ in the
+ *           repository).  The drivers keep writing SFRs directly.  On the PIC
+ *           HAL_KICK() is empty and costs nothing.  In the host build
+ *           (HOST_SIM defined) the SFRs are plain memory, so each write that
+ *           starts something in a peripheral (a byte into SSPxBUF, a start
+ *           bit, an EEPROM read, a clock switch) is followed by HAL_KICK()
+ *           to tell the simulator to act on it.
+ * Revision history: 1, 19th October 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef INC_HAL_H
+#define	INC_HAL_H
+
+//Peripherals for HAL_KICK
+#define HAL_SSP1 0          //I2C1 control bit set or SSP1BUF written
+#define HAL_SSP2 1          //SSP2BUF written
+#define HAL_SPI2_NSS 2      //Radio deselected, end of SPI transaction
+#define HAL_OSC 3           //OSCCON SCS written
+#define HAL_EEPROM 4        //EECON1 RD or WR set
+#define HAL_USART2 5        //TXREG2 written
+#define HAL_INTERRUPT 6     //Interrupt enable set, check for pending interrupts
+#define HAL_LORA_RESET 7    //Radio reset line driven
+
+#ifdef HOST_SIM
+void SimKick(unsigned char);
+#define HAL_KICK(p) SimKick(p)
+#else
+#define HAL_KICK(p)
+#endif
+
+#endif	/* INC_HAL_H */
@@ -0,0 +1,71 @@
+/**
+ * history.c
+ * Keeps the last HISTORY_DEPTH samples and writes them compressed into the
+ * spare packet bytes, see history.h.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <xc.h>
+#include <stdint.h>
+#include "history.h"
+#include "adc.h"
+
+static uint8_t history[HISTORY_DEPTH][HISTORY_SAMPLE_BYTES]; //Newest first, already encoded
+static uint8_t historyCount = 0; //Samples held since reset
+
+/**
+ * Compresses a 16-bit reading to an 8-bit float (4-bit exponent, 4-bit
+ * mantissa with a hidden leading 1).  0 to 31 are exact.
+ * @param value Reading
+ * @return      Code
+ */
+uint8_t HistoryEncode(uint16_t value){
+    uint8_t e = 1;
+    if(value<32){
+        return (uint8_t)value;
+    }
+    while(value>31){
+        value = value>>1;
+        e++;
+    }
+    return (uint8_t)(e<<4 | (value&0x0F));
+}
+
+/**
+ * Writes the previous samples into a packet (call before HistoryPush for
+ * the current sample).
+ * @param dest  HISTORY_BYTES bytes
+ */
+void HistoryWrite(uint8_t* dest){
+    for(uint8_t s=0;s<HISTORY_DEPTH;s++){
+        for(uint8_t i=0;i<HISTORY_SAMPLE_BYTES;i++){
+            if(s<historyCount){
+                dest[s*HISTORY_SAMPLE_BYTES+i] = history[s][i];
+            }
+            else{
+                dest[s*HISTORY_SAMPLE_BYTES+i] = HISTORY_UNKNOWN;
+            }
+        }
+    }
+}
+
+/**
+ * Adds the sample in a packet to the history.
+ * @param packet    Uplink packet (v5 layout)
+ */
+void HistoryPush(const uint8_t* packet){
+    for(uint8_t s=HISTORY_DEPTH-1;s>0;s--){
+        for(uint8_t i=0;i<HISTORY_SAMPLE_BYTES;i++){
+            history[s][i] = history[s-1][i];
+        }
+    }
+    for(uint8_t i=0;i<5;i++){
+        history[0][i] = HistoryEncode((uint16_t)packet[24+i*2]<<8 | packet[25+i*2]); //UVA, UVB, COMP1, COMP2, VIS
+    }
+    history[0][5] = (uint8_t)(((uint16_t)packet[16]<<8 | packet[17])>>(2+ADC_EXTRA_BITS)); //Battery
+    history[0][6] = (uint8_t)(((uint16_t)packet[18]<<8 | packet[19])>>(2+ADC_EXTRA_BITS)); //Temperature
+    if(historyCount<HISTORY_DEPTH){
+        historyCount++;
+    }
+}
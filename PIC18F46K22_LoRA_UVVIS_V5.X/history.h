@@ -0,0 +1,39 @@
+/* 
+ * File:   history.h
+ * Author: Andy Page
+ * Comments: Redundant history.  Each packet also carries compressed copies
+ *           of the previous HISTORY_DEPTH samples in the spare bytes 34 to 47
+ *           so the gateway can fill in isolated lost packets.
+ * Revision history: 1, 19th October 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef INC_HISTORY_H
+#define	INC_HISTORY_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+
+#define HISTORY 0 //1 = send history in the spare packet bytes (can't be used with PROFILE)
+
+/*
+ * Packet bytes 34-40 hold message count-1, bytes 41-47 message count-2
+ * 0-4      UVA, UVB, COMP1, COMP2, VIS as 8-bit floats:
+ *          code<32 is the value, otherwise e=code>>4, m=code&15 and the
+ *          value is ((16+m)<<(e-1)) to ((17+m)<<(e-1))-1, the middle of
+ *          that range is within 3%
+ * 5        Battery A to D >> 2
+ * 6        Temperature A to D >> 2
+ * A sample that isn't known (after a reset) is sent as all HISTORY_UNKNOWN.
+ */
+#define HISTORY_DEPTH 2
+#define HISTORY_SAMPLE_BYTES 7
+#define HISTORY_BYTES (HISTORY_DEPTH*HISTORY_SAMPLE_BYTES)
+#define HISTORY_UNKNOWN 0xFF //Not a valid 8-bit float (largest is 0xCF)
+
+void HistoryWrite(uint8_t*);
+void HistoryPush(const uint8_t*);
+uint8_t HistoryEncode(uint16_t);
+
+#endif	/* INC_HISTORY_H */
@@ -8,6 +8,7 @@
 
 #include <xc.h>
 #include "defines.h"
+#include "hal.h"
 
 //Sets up the i2c bus
 void I2C1_Initialize(const unsigned long c){
@@ -52,6 +53,7 @@ void I2C1_Wait(){
 void I2C1_Start(void){
     I2C1_Wait();
     SSP1CON2bits.SEN1=1;
+    HAL_KICK(HAL_SSP1);
 }
 
 /**
@@ -60,6 +62,7 @@ void I2C1_Start(void){
 void I2C1_Repeated_Start(void){
     I2C1_Wait();
     SSP1CON2bits.RSEN1=1; //Send repeated start condition
+    HAL_KICK(HAL_SSP1);
 }
 
 //Write a byte and return the acknowledge bit (good for checking if a device is present)
@@ -67,6 +70,7 @@ unsigned char I2C1_Write_Byte_Read_Ack(unsigned char d){
     I2C1_Wait();
     PIR1bits.SSP1IF=0; //Clear interrupt flag first otherwise the bit may already be set
     SSP1BUF=d; //Put the data in the transmit buffer (it will begin sending immediately)
+    HAL_KICK(HAL_SSP1);
     unsigned char tries=0;
     while(!PIR1bits.SSP1IF && tries<150){
         //Wait for transmission to complete and ack bit to be read back or timeout
@@ -78,6 +82,7 @@ unsigned char I2C1_Write_Byte_Read_Ack(unsigned char d){
 void I2C1_Stop(){
     I2C1_Wait();
     SSP1CON2bits.PEN1=1;
+    HAL_KICK(HAL_SSP1);
 }
 
 //Receives a byte
@@ -85,11 +90,13 @@ unsigned char I2C1_Read_Byte(unsigned char a){
     unsigned char temp;
     I2C1_Wait();
     RCEN1 = 1;
+    HAL_KICK(HAL_SSP1);
     I2C1_Wait();
     temp = SSPBUF;      //Read data from SSPBUF
     I2C1_Wait();
     ACKDT1 = (a)?0:1;    //Acknowledge bit
     ACKEN1 = 1;          //Acknowledge sequence
+    HAL_KICK(HAL_SSP1);
     return temp;
 }
 
@@ -0,0 +1,60 @@
+/**
+ * lowpower.c
+ * Low power delays.  The CPU clock is switched to the 31kHz LFINTOSC (the
+ * crystal drive is off) and the core is put into Idle mode.  Timer1
+ * keeps running from Fosc/4 and wakes the core when it overflows.
+ * Interrupts are not used - the core just carries on after SLEEP().
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <xc.h>
+#include <stdint.h>
+#include "defines.h"
+#include "lowpower.h"
+#include "clock.h"
+
+uint16_t lpTickRate = LP_NOMINAL_TICK_RATE;
+uint32_t lowPowerElapsedMs = 0;
+
+/**
+ * Waits for approximately the given number of milliseconds with the core
+ * idling at 31kHz.  LFINTOSC is only accurate to about 15% unless lpTickRate
+ * has been calibrated against something better.
+ * @param ms    Delay in milliseconds
+ */
+void LowPowerDelayMs(uint16_t ms){
+    if(ms==0){
+        return;
+    }
+    lowPowerElapsedMs = lowPowerElapsedMs + ms;
+    uint8_t previousClock = ClockSelect(CLOCK_LFINTOSC); //Restored on the way out
+    PMD0bits.TMR1MD=0; //Turn Timer1 on
+    T1CON=0; //Fosc/4, 1:1 prescale, stopped
+    T1GCON=0; //No gate
+    INTCONbits.PEIE=1; //Peripheral wake up enabled (no vectoring unless the debug UART has GIE on)
+    OSCCONbits.IDLEN=1; //SLEEP() enters Idle mode so that Timer1 keeps running
+    while(ms>0){
+        uint16_t chunk = ms;
+        if(chunk>LP_MAX_CHUNK_MS){
+            chunk=LP_MAX_CHUNK_MS;
+        }
+        uint16_t ticks = (uint16_t)(((uint32_t)chunk*lpTickRate)/1000);
+        uint16_t start = 0u-ticks; //Count up to overflow
+        TMR1H = (uint8_t)(start>>8);
+        TMR1L = (uint8_t)(start&0xFF);
+        PIR1bits.TMR1IF=0;
+        PIE1bits.TMR1IE=1; //Allows Timer1 to wake the core (the interrupt handler clears it)
+        T1CONbits.TMR1ON=1;
+        while(!PIR1bits.TMR1IF){
+            SLEEP(); //Idle until Timer1 overflows
+        }
+        T1CONbits.TMR1ON=0;
+        ms = ms - chunk;
+    }
+    PIR1bits.TMR1IF=0;
+    PIE1bits.TMR1IE=0;
+    OSCCONbits.IDLEN=0; //SLEEP() is a full sleep again
+    ClockSelect(previousClock); //Back to the clock we were using
+    PMD0bits.TMR1MD=1; //Turn Timer1 off
+}
@@ -0,0 +1,28 @@
+/* 
+ * File:   lowpower.h
+ * Author: Andy Page
+ * Comments: Short low power delays using Idle mode clocked from the 31kHz
+ *           LFINTOSC.  The watchdog postscaler is fixed at 64 seconds so it
+ *           cannot be used for short sleeps.
+ * Revision history: 1, 19th October 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef INC_LOWPOWER_H
+#define	INC_LOWPOWER_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+
+//Timer1 runs from Fosc/4 = 31.25kHz/4 while idling
+#define LP_NOMINAL_TICK_RATE 7812 //Timer1 ticks per second at the nominal LFINTOSC frequency
+#define LP_MAX_CHUNK_MS 5000 //Largest delay that fits in a single Timer1 count (LFINTOSC up to +40%)
+
+extern uint16_t lpTickRate; //Timer1 ticks per second, can be calibrated
+extern uint32_t lowPowerElapsedMs; //Total time spent in LowPowerDelayMs, cleared by the caller
+
+void LowPowerDelayMs(uint16_t);
+
+#endif	/* INC_LOWPOWER_H */
+
@@ -42,6 +42,19 @@
  *           19th April 2021: Moved setupAtoD() to configIO() so that reference is up and stable by the time the A to D is used.
  * Version 4 16th May 2021:  Added UVLO to prevent transmitter operation with flat batteries.
  * Version 5 18th Sept 2021: New data format, 50 byte fixed packet length for all sensors.
+ *           19th Oct 2026: Added random transmit jitter seeded from address and message count.
+ *           19th Oct 2026: Added listen before talk using CAD.
+ *           19th Oct 2026: Added optional fixed period transmit slots (SLOT_SCHEDULING).
+ *           19th Oct 2026: Added downlink receive window for settings held in EEPROM.
+ *           19th Oct 2026: Added optional acknowledged delivery with retransmission (ACK_MODE).
+ *           19th Oct 2026: A to D moved to adc.c, oversampled conversions with the core asleep.
+ *           19th Oct 2026: Split cold boot set up from the warm wake path, init time timed in DEBUG.
+ *           19th Oct 2026: Wakes run from the 16MHz HFINTOSC, crystal only for the debug UART, no PLL.
+ *           19th Oct 2026: Debug output is binary trace events on an interrupt driven USART2 (tools/tracedecode.py).
+ *           19th Oct 2026: Optional wake phase profile in the spare packet bytes (PROFILE in profile.h).
+ *           19th Oct 2026: Unsent samples kept in an EEPROM log and sent later, message count kept through resets.
+ *           19th Oct 2026: Optional redundant history of the last 2 samples in the spare packet bytes (HISTORY in history.h).
+ *           19th Oct 2026: Sensors probed until they ACK after the rail turns on instead of assuming they are ready.
  */          
 
 
@@ -52,6 +65,7 @@
 #include <pic18f46k22.h>
 #include "config.h"
 #include "usart2.h"
+#include "clock.h"
 #include "LoRa.h"
 #include "VEML6075.h"
 #include "defines.h"
@@ -59,25 +73,43 @@
 #include "uv.h"
 #include "BH1750.h"
 #include "CRC16.h"
+#include "backoff.h"
+#include "slots.h"
+#include "settings.h"
+#include "downlink.h"
+#include "ack.h"
+#include "lowpower.h"
+#include "adc.h"
+#include "trace.h"
+#include "profile.h"
+#include "samplelog.h"
+#include "history.h"
+#include "rail.h"
 
 #define DEBUG 0
-#define TX_FREQ 866.5
-#define SYNC_WORD 0x55
-#define BATT_UVLO 2100 //2V UVLO below which transmitter operation is prevented
-#define BATT_UVLO_ATOD BATT_UVLO/4
 #define DATA_PACKET_LENGTH 50
 #define ID0 0x00
 #define ID1 0x02
 #define SOFTWARE_VERSION 0x05
+#define NODE_COUNT 8 //Number of nodes sharing the channel, sets the spread of the transmit jitter
+#define SLOT_SCHEDULING 0 //1 = fixed period transmit slots (see slots.h) instead of random jitter
+#define ACK_MODE 0 //1 = wait for an ACK after each packet and retransmit (see ack.h)
+
+#if PROFILE && HISTORY
+#error "PROFILE and HISTORY both use packet bytes 34 to 47"
+#endif
 
 void configureIO();
+void wakeIO();
+void peripheralsOn();
 void readVisValue();
+void buildPacket();
 void transmitValues();
+void sendLog();
+uint8_t sendPacket(uint8_t*);
+uint8_t sendWithAck(uint8_t*, uint8_t);
 void turnStuffOff();
 void disablePeripherals();
-uint16_t readBattery();
-uint16_t readTemperature();
-void setupAtoD();
 
 uint8_t txData[DATA_PACKET_LENGTH]; //Transmit buffer
 uint8_t address[8] = {0x6E,0xDA,0x82,0x33,0x33,0x66,0xF5,0xE6}; //This should be unique
@@ -90,39 +122,121 @@ uint16_t vis=0;
 uint16_t batt=0;
 uint16_t temp=0;
 uint32_t messageCount=0;
+uint8_t wakeCount=0; //Wakes since the last measurement
+uint8_t coldBoot=1; //Set until the first full set up after a reset
+uint8_t resetCause=0; //RCON as found at reset
+uint16_t initTicks=0; //Timer3 ticks (0.5us) spent in set up this wake
+
+/**
+ * Only the debug UART uses interrupts (GIE is off otherwise).  ADIE and TMR1IE
+ * are turned on to wake from SLEEP(), if they vector here their enable is
+ * cleared and the waiting code sees the flag.
+ */
+void __interrupt() interruptHandler(void){
+    USART2_TxISR();
+    if(PIE1bits.ADIE && PIR1bits.ADIF){
+        PIE1bits.ADIE=0;
+    }
+    if(PIE1bits.TMR1IE && PIR1bits.TMR1IF){
+        PIE1bits.TMR1IE=0;
+    }
+}
 
 void main(void) {
+    resetCause=RCON; //Keep the reason we reset for the debug output
+    RCONbits.nPOR=1; //Re-arm so the next POR/BOR can be told apart from other resets
+    RCONbits.nBOR=1;
+    ClockSelect(CLOCK_HFINTOSC); //Reset starts on the crystal, run from the internal oscillator from now on
+    SettingsLoad(); //Tunable parameters from EEPROM (UVLO, TX power, SF, intervals)
+    messageCount = SampleLogLoadCount(); //Carry on from the last checkpoint
+    SampleLogSaveCount(messageCount); //Checkpoint it now, or a second reset before the next would repeat counts
     start:
-    configureIO();  //Sets up all the required I/O pins to talk to stuff
+    if(SLOT_SCHEDULING){
+        SlotsWake(address); //Waits (in low power) for the start of our slot
+    }
+    wakeCount++;
+    if(!coldBoot && wakeCount<settings[SETTING_TX_EVERY]){
+        goto sleep; //Not our turn to measure, straight back to sleep
+    }
+    wakeCount=0;
+    if(PROFILE){
+        ProfileStart();
+    }
+    PMD0bits.TMR3MD=0; //Timer3 on to time the set up
+    T3CON=0b00010000; //Fosc/4, 1:2 prescale, 0.5us per tick
+    TMR3H=0;
+    TMR3L=0;
+    T3CONbits.TMR3ON=1;
+    if(coldBoot){
+        configureIO();  //Sets up all the required I/O pins to talk to stuff
+    }
+    else{
+        wakeIO(); //Only what disablePeripherals() turned off
+    }
+    //Paused for the rail wait, its low power delays run from LFINTOSC and
+    //it is timed on its own in railReadyMs
+    T3CONbits.TMR3ON=0;
+    RailWaitReady(); //Until both sensors ACK
+    T3CONbits.TMR3ON=1;
+    VEML6075Start();
+    T3CONbits.TMR3ON=0;
+    initTicks=TMR3L; //Read low byte first to latch the high byte
+    initTicks|=(uint16_t)TMR3H<<8;
+    if(PROFILE){
+        ProfileMark(PROFILE_INIT);
+    }
 
     
     if(DEBUG){
-        printf("LoRa868 UV/Visible Light Sensor\r\n");
+        if(coldBoot){
+            TraceEvent(TRACE_BOOT, resetCause);
+            TraceEvent(TRACE_COLD_INIT_US, initTicks>>1);
+        }
+        else{
+            TraceEvent(TRACE_WARM_INIT_US, initTicks>>1);
+        }
+        TraceEvent(TRACE_VEML6075_READY, railReadyMs[RAIL_VEML6075]);
+        TraceEvent(TRACE_BH1750_READY, railReadyMs[RAIL_BH1750]);
     }
+    coldBoot=0;
     setBH1750ContinuousHResolutionMode(); //Set visible light sensor to x1
     __delay_ms(180); //Need to wait for visible light sensor to take a measurement
+    if(PROFILE){
+        ProfileMark(PROFILE_BH1750);
+    }
     readUV(); //Reads the needed values from the UV sensor
+    if(PROFILE){
+        ProfileMark(PROFILE_VEML6075);
+    }
     if(DEBUG){
-        printf("UVA %d\r\n", uvaReading);
-        printf("UVB %d\r\n", uvbReading);
-        printf("CMP1 %d\r\n", comp1Reading);
-        printf("CMP2 %d\r\n", comp2Reading);
+        TraceEvent(TRACE_UVA, uvaReading);
+        TraceEvent(TRACE_UVB, uvbReading);
+        TraceEvent(TRACE_COMP1, comp1Reading);
+        TraceEvent(TRACE_COMP2, comp2Reading);
     }
     readVisValue(); //Reads the value from the visible light sensor
+    if(PROFILE){
+        ProfileMark(PROFILE_BH1750);
+    }
     if(DEBUG){
-        printf("VIS %d\r\n", vis);
+        TraceEvent(TRACE_VIS, vis);
     }
     
-    batt = readBattery();
-    temp = readTemperature();
+    batt = ADCRead(ADC_CH_BATTERY, ADC_REF_FVR); //Battery against the 1.024V reference
+    temp = ADCRead(ADC_CH_TEMPERATURE, ADC_REF_VDD); //NTC divider is ratiometric to Vdd
+    if(PROFILE){
+        ProfileMark(PROFILE_ADC);
+    }
     if(DEBUG){
-        printf("BATT %d\r\n", batt);
-        printf("TEMP %d\r\n", temp);
+        TraceEvent(TRACE_BATT, batt);
+        TraceEvent(TRACE_TEMP, temp);
     }
-    if(batt>BATT_UVLO_ATOD){
+    buildPacket(); //Puts the values into txData
+    if(batt>SettingsUVLO()){
         transmitValues(); //Transmits the required bytes
     }
     else{
+        SampleLogAppend(txData); //Keep it to send when the battery recovers
         //Flash the red LED 3 times to indicate flat battery
         RED_LED=1; //Red LED on
         __delay_ms(300);
@@ -137,10 +251,28 @@ void main(void) {
         RED_LED=0;
         __delay_ms(300);
     }
+    if(PROFILE){
+        ProfileMark(PROFILE_NONE); //ACK, downlink, log sends and the flat battery flashes are not profiled
+    }
     turnStuffOff(); //Turns everything off and prepares to sleep
     messageCount++;
+    SampleLogSaveCount(messageCount); //Checkpoints now and again
+    if(PROFILE){
+        ProfileMark(PROFILE_SLEEP);
+    }
     if(DEBUG){
-        printf("Sleeping\r\n");
+        if(SLOT_SCHEDULING){
+            TraceEvent(TRACE_SLOT_DELAY, slotsDelayMs);
+            TraceEvent(TRACE_WDT_MS, (uint16_t)SlotsWDTPeriodMs());
+        }
+        TraceEvent(TRACE_SLEEP, (uint16_t)messageCount);
+    }
+    if(PROFILE){
+        ProfileEnd(); //Sent in the next packet
+    }
+    sleep:
+    if(SLOT_SCHEDULING){
+        SlotsSleep(); //Records awake time for the next slot delay
     }
     
     SLEEP(); //Go to sleep until the watchdog times out.
@@ -149,31 +281,50 @@ void main(void) {
     goto start;
 }
 
+/**
+ * Cold boot set up, only run once after a reset.  ANSEL selections, the LED
+ * and RA2 pin directions and the BH1750 address all survive sleep.  main
+ * waits for the sensor rail and starts the VEML6075 afterwards.
+ */
 void configureIO(){
-    PMD2bits.ADCMD=0; //Turn ADC on
-    if(DEBUG){
-        PMD0bits.UART2MD=0; //Turn UART2 on
-    }
-    PMD1bits.MSSP1MD=0; //Turn I2C on
-    PMD1bits.MSSP2MD=0; //Turn SPI2 on
     ANSELAbits.ANSA2=0; //Analogue off
     TRISAbits.RA2=0; //Output
-    LATAbits.LATA2=0; //External circuitry on
     ANSELEbits.ANSE1=0; //Turn off analogue on RE1
     ANSELEbits.ANSE2=0; //Turn off analogue on RE2
     ANSELBbits.ANSB4=0; //Turn off analogue on RB4
     TRISEbits.RE1=0; //Green LED for status
     TRISEbits.RE2=0; //Red LED for status
     RED_LED=0; //Red LED off
+    setBH1750Address(LOW); //Set address of BH1750 assuming ADDR pin is pulled low
+    peripheralsOn();
+    I2C1_Check_Data_Stuck(); //Check if bus is stuck and attempt to unstick it.
+}
+/**
+ * Warm wake set up, run after every sleep.  The sensors lose their settings
+ * when Q1 turns off so the VEML6075 is set up again once the rail is ready
+ * (the BH1750 mode is set in main just before the measurement).
+ */
+void wakeIO(){
+    peripheralsOn();
+}
+/**
+ * Turns back on what disablePeripherals() turned off.  Modules held off by
+ * PMD come back with reset register values so each one is set up again.
+ */
+void peripheralsOn(){
+    PMD2bits.ADCMD=0; //Turn ADC on
+    if(DEBUG){
+        PMD0bits.UART2MD=0; //Turn UART2 on
+    }
+    PMD1bits.MSSP1MD=0; //Turn I2C on
+    PMD1bits.MSSP2MD=0; //Turn SPI2 on
+    LATAbits.LATA2=0; //External circuitry on
     if(DEBUG){
+        ClockSelect(CLOCK_CRYSTAL); //HFINTOSC is only good to 2% so use the crystal for the UART
         USART2_Start(BAUD_57600); //Start USART2
     }
-    setupAtoD(); //Setup to read AN0 (reads supply voltage [battery])
+    ADCStart(); //Setup to read AN0 and AN1 (battery and temperature), FVR on early so it settles
     I2C1_Initialize(100000); //Starts I2C module 1 (100kHz fixed)
-    I2C1_Check_Data_Stuck(); //Check if bus is stuck and attempt to unstick it.
-    VEML6075Start();
-    setBH1750Address(LOW); //Set address of BH1750 assuming ADDR pin is pulled low
-    setBH1750ContinuousHResolutionMode(); //Set the device mode
 }
 
 void readVisValue(){
@@ -183,9 +334,9 @@ void readVisValue(){
 
 
 /**
- * Transmits the sensor values as a sequence of bytes
+ * Puts the sensor values into txData as a sequence of bytes
  */
-void transmitValues(){
+void buildPacket(){
     txData[0] = DATA_PACKET_LENGTH;
     txData[1] = ID0; //Copy in the ID
     txData[2] = ID1; //Copy in the ID
@@ -240,56 +391,205 @@ void transmitValues(){
     for(uint8_t i=34;i<48;i++){
         txData[i] = 0;
     }
+    if(PROFILE){
+        ProfileWrite(&txData[34]); //Phase times of the last wake
+    }
+    if(HISTORY){
+        HistoryWrite(&txData[34]); //Previous samples
+        HistoryPush(txData); //This sample goes in the next packets
+    }
     
     //Calculate CRC16 and add to end of message
     unsigned short int calcCRC = CRC16(txData, DATA_PACKET_LENGTH-2);
     txData[49] = (calcCRC&0xFF00u)>>8u; //MSB
     txData[48] = (calcCRC&0xFF); //LSB
-    
-    
-    if(DEBUG){
-        printf("Starting transmitter...\r\n");
+}
+
+/**
+ * Transmits the packet in txData, then any logged samples
+ */
+void transmitValues(){
+    BackoffSeed(address, messageCount); //Random numbers for jitter and retry backoff
+    if(!SLOT_SCHEDULING){
+        //Random delay so nodes that woke together do not collide
+        BackoffJitter(NODE_COUNT);
     }
+    if(PROFILE){
+        ProfileMark(PROFILE_NONE); //Packet build and jitter are not profiled
+    }
+    
     LoRaStart(TX_FREQ, SYNC_WORD); //Configure module
+    LoRaSetPAConfig(settings[SETTING_PA_CONFIG]);
+    LoRaSetSpreadingFactor(settings[SETTING_SF]);
+    if(PROFILE){
+        ProfileMark(PROFILE_RADIO_START);
+    }
     if(DEBUG){
-        printf("TXF: %f\r\n", LoRaGetFrequency());
+        TraceEvent(TRACE_RADIO_START, (uint16_t)(LoRaGetFrequency()*10));
+    }
+    uint8_t sent;
+    if(ACK_MODE){
+        sent = sendWithAck(txData, ACK_MAX_RETRIES);
+        if(!sent){
+            AckQueuePush(txData); //Try again next cycle
+        }
+        else{
+            //Link is working, send anything left over from earlier cycles (one try each)
+            while(ackQueueCount>0 && sendWithAck(AckQueuePeek(), 0)){
+                AckQueuePop();
+            }
+        }
+        if(DEBUG){
+            TraceEvent(TRACE_ACK, (uint16_t)sent<<8 | ackQueueCount);
+        }
+    }
+    else{
+        sent = sendPacket(txData);
+        if(!sent){
+            SampleLogAppend(txData); //Try again once the link is working
+        }
+    }
+    if(sent){
+        sendLog(); //Link is working, send some of the backlog
+    }
+    if(sent && settings[SETTING_RX_EVERY]>0 && (messageCount % settings[SETTING_RX_EVERY])==0){
+        //Listen for new settings from the base station, they take effect next cycle
+        uint8_t result = DownlinkReceive(address);
+        if(DEBUG){
+            if(result!=DOWNLINK_NONE){
+                TraceEvent(TRACE_DOWNLINK, result);
+            }
+        }
+    }
+    if(SLOT_SCHEDULING){
+        SlotsCalibrate(); //Measures LFINTOSC against the radio crystal now and again
+    }
+    LoRaSleepMode(); //Put module to sleep
+    __delay_ms(10);
+}
+
+/**
+ * Sends up to LOG_DRAIN_PACKETS log packets from the sample log.  Radio must
+ * be started.  Records are only marked as sent once their packet has gone
+ * (or been acknowledged in ACK_MODE).
+ */
+void sendLog(){
+    for(uint8_t p=0;p<LOG_DRAIN_PACKETS;p++){
+        for(uint8_t i=0;i<DATA_PACKET_LENGTH;i++){
+            txData[i] = 0;
+        }
+        uint8_t n = SampleLogRead(&txData[17], LOG_RECORDS_PER_PACKET);
+        if(n==0){
+            return; //Nothing left
+        }
+        txData[0] = DATA_PACKET_LENGTH;
+        txData[1] = ID0;
+        txData[2] = LOG_ID1;
+        for(uint8_t i=0;i<8;i++){
+            txData[i+3] = address[i];
+        }
+        txData[11] = SOFTWARE_VERSION;
+        //Full message count of the first record, from its low 16 bits
+        uint32_t count = (messageCount & 0xFFFF0000UL) | ((uint16_t)txData[17]<<8 | txData[18]);
+        if(count>messageCount){
+            count = count - 0x10000UL;
+        }
+        txData[12]=(uint8_t)((count>>24)&0xFF); //MSB
+        txData[13]=(uint8_t)((count>>16)&0xFF);
+        txData[14]=(uint8_t)((count>>8)&0xFF);
+        txData[15]=(uint8_t)(count & 0xFF); //LSB
+        txData[16] = n;
+        unsigned short int calcCRC = CRC16(txData, DATA_PACKET_LENGTH-2);
+        txData[49] = (calcCRC&0xFF00u)>>8u; //MSB
+        txData[48] = (calcCRC&0xFF); //LSB
+        uint8_t sent;
+        if(ACK_MODE){
+            sent = sendWithAck(txData, 0);
+        }
+        else{
+            sent = sendPacket(txData);
+        }
+        if(!sent){
+            return; //Leave them for next time
+        }
+        SampleLogMarkSent();
+    }
+}
+
+/**
+ * Sends one packet (after listen before talk) and waits for it to go.
+ * @param packet    DATA_PACKET_LENGTH bytes
+ * @return 1 if the radio reported TxDone
+ */
+uint8_t sendPacket(uint8_t* packet){
+    if(PROFILE){
+        ProfileMark(PROFILE_NONE); //ACK windows and retry backoff are not profiled
     }
     LoRaClearIRQFlags();
     RED_LED=1; //Red LED on (saves battery power by doing it here!)
-    LoRaTXData(txData, DATA_PACKET_LENGTH); //Send data
+    uint8_t sent = LoRaTXData(packet, DATA_PACKET_LENGTH); //Send data (checks channel is clear first)
     RED_LED=0; //Red LED off (saves battery power by doing it here!)
-    if(DEBUG){
-        printf("Wait for end of transmission...\r\n");
+    if(PROFILE){
+        ProfileMark(PROFILE_FIFO);
     }
-    uint8_t j=0;
-    for(j=0;j<50;j++){
+    if(!sent){
+        return 0; //LoRaTXData() has traced it
+    }
+    //10ms polls, 1.5 times the time on air at this spreading factor plus 100ms
+    uint16_t maxPolls = LoRaAirtimeMs(DATA_PACKET_LENGTH)/20*3 + 10;
+    uint16_t j=0;
+    for(j=0;j<maxPolls;j++){
         uint8_t flags = LoRaGetIRQFlags();
         //printf("IRQ %d %d \r\n",j, flags);
-        if(flags>0){
+        if(flags & IRQ_TX_DONE){
             break;
         }
         __delay_ms(10); //We are done with transmission
     }
+    if(PROFILE){
+        ProfileMark(PROFILE_TX_WAIT);
+    }
+    if(j>=maxPolls){
+        if(DEBUG){
+            TraceEvent(TRACE_TX_FAIL, 0);
+        }
+        return 0;
+    }
     if(DEBUG){
-        if(j>48){
-            printf("TX Fail\r\n");
+        TraceEvent(TRACE_TX_DONE, j);
+    }
+    return 1;
+}
+
+/**
+ * Sends a packet and waits for the base station to acknowledge it,
+ * retransmitting with exponential backoff (in low power idle).
+ * @param packet    DATA_PACKET_LENGTH bytes
+ * @param retries   Number of retransmissions allowed
+ * @return 1 if acknowledged
+ */
+uint8_t sendWithAck(uint8_t* packet, uint8_t retries){
+    uint16_t backoff = ACK_BACKOFF_MS;
+    for(uint8_t i=0;;i++){
+        if(sendPacket(packet) && AckReceive(packet)){
+            return 1;
         }
-        else{
-            printf("Done.\r\n");
+        if(i>=retries){
+            return 0;
         }
+        LowPowerDelayMs(backoff + (BackoffRandom() % backoff));
+        backoff = backoff * 2;
     }
-    LoRaSleepMode(); //Put module to sleep
-    __delay_ms(10);
 }
 
 void turnStuffOff(){
     USART2_Stop();
+    ClockSelect(CLOCK_HFINTOSC); //Wake up on HFINTOSC, no crystal start-up
     disablePeripherals();
 }
 
 void disablePeripherals(){
-    ADCON0bits.ADON=0; //Turn off A to D module
-    VREFCON0bits.FVREN=0; //Disable internal reference
+    ADCStop(); //Turn off A to D module and internal reference
     //Set all pins as outputs
     TRISA=0;
     TRISB=0;
@@ -325,61 +625,3 @@ void disablePeripherals(){
     PMD1=0xFF; //Turn off all peripherals in PMD1
     PMD2=0xFF; //Turn off all peripherals in PMD2 (ADC, comparators, CTMU)
 }
-
-/**
- * Reads the supply voltage A to D
- */
-uint16_t readBattery(){
-    ADCON1bits.PVCFG=0b10; //A/D Vref+ connected to internal reference FVR BUF2
-    ADCON0bits.GO_NOT_DONE=1; //Start the A to D process
-    while(ADCON0bits.GO_NOT_DONE){
-        //Wait for conversion to complete (about 15s)
-    }
-    uint16_t result = ADRESH * 256 + ADRESL; //Read A to D result
-    return result;
-}
-
-uint16_t readTemperature(){
-    ADCON1bits.PVCFG=0; //A/D Vref+ connected to Vdd
-    //Select channel 1 for A to D
-    ADCON0bits.CHS=1;
-    ADCON0bits.GO_NOT_DONE=1; //Start the A to D process
-    while(ADCON0bits.GO_NOT_DONE){
-        //Wait for conversion to complete (about 15s)
-    }
-    uint16_t result = ADRESH * 256 + ADRESL; //Read A to D result
-    return result;
-}
-
-void setupAtoD(){
-    //Setup AN0 for a to d converter (RA0)
-    
-    //Set ANSELbit to disable digital input buffer
-    ANSELAbits.ANSA0=1;
-    ANSELAbits.ANSA1=1;
-    
-    //Set TRISXbit to disable digital output driver
-    TRISAbits.RA0=1;
-    TRISAbits.RA1=1;
-    
-    //Set voltage references
-    ADCON1bits.PVCFG=0; //A/D Vref+ connected to Vdd
-    ADCON1bits.NVCFG=0; //A/D Vref- connected to internal signal AVss
-    VREFCON0bits.FVRS=0b01; //Fixed voltage reference is 1.024V
-    VREFCON0bits.FVREN=1; //Enable internal reference
-    
-    //Select channel 0 for A to D
-    ADCON0bits.CHS=0;
-    
-    //Set A to D acquisition time
-    ADCON2bits.ACQT=0b010; //Tacq = 4 Tad (4s)
-    
-    //Set A to D clock period
-    ADCON2bits.ADCS=0b110; //Clock period set to Fosc/64 = 1s (64MHz clock)
-    
-    //Set result format
-    ADCON2bits.ADFM = 1; //Data is mostly in the ADRESL register with 2 bits in the ADRESH register
-    
-    //Turn on the A to D module
-    ADCON0bits.ADON=1;
-}
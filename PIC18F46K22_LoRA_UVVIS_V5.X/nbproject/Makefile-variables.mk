@@ -11,3 +11,10 @@ CND_ARTIFACT_PATH_default=dist/default/production/PIC18F46K22_LoRA_UVVIS_V5.X.pr
 CND_PACKAGE_DIR_default=${CND_DISTDIR}/default/package
 CND_PACKAGE_NAME_default=pic18f46k22lorauvvisv5.x.tar
 CND_PACKAGE_PATH_default=${CND_DISTDIR}/default/package/pic18f46k22lorauvvisv5.x.tar
+# receiver configuration
+CND_ARTIFACT_DIR_receiver=dist/receiver/production
+CND_ARTIFACT_NAME_receiver=PIC18F46K22_LoRA_UVVIS_V5.X.production.hex
+CND_ARTIFACT_PATH_receiver=dist/receiver/production/PIC18F46K22_LoRA_UVVIS_V5.X.production.hex
+CND_PACKAGE_DIR_receiver=${CND_DISTDIR}/receiver/package
+CND_PACKAGE_NAME_receiver=pic18f46k22lorauvvisv5.x.tar
+CND_PACKAGE_PATH_receiver=${CND_DISTDIR}/receiver/package/pic18f46k22lorauvvisv5.x.tar
@@ -0,0 +1,88 @@
+/**
+ * profile.c
+ * Wake cycle phase profiler, see profile.h.  Timer0 is shared with slots.c,
+ * it is only read here (never cleared) so the slot awake time is unaffected.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <xc.h>
+#include <stdint.h>
+#include "defines.h"
+#include "profile.h"
+#include "lowpower.h"
+
+static uint16_t profilePhase[PROFILE_PHASES]; //This wake, PROFILE_UNIT_US units
+static uint16_t profileLast[PROFILE_PHASES]; //Last complete wake, sent in the packet
+static uint16_t profileTicks = 0; //Timer0 at the last boundary
+static uint32_t profileLowPowerMs = 0; //lowPowerElapsedMs at the last boundary
+
+static uint16_t profileTimer0(void){
+    uint8_t low = TMR0L; //Reading TMR0L latches TMR0H
+    return (uint16_t)TMR0H<<8 | low;
+}
+
+/**
+ * Call at the start of each wake, after SlotsWake() if it is used.
+ */
+void ProfileStart(void){
+    if(!T0CONbits.TMR0ON){
+        //Not started by slots.c, 16-bit, 1:256 prescale
+        T0CON = 0;
+        T0CONbits.T0PS = 0b111;
+        TMR0H = 0;
+        TMR0L = 0;
+        T0CONbits.TMR0ON = 1;
+    }
+    for(uint8_t i=0;i<PROFILE_PHASES;i++){
+        profilePhase[i] = 0;
+    }
+    profileTicks = profileTimer0();
+    profileLowPowerMs = lowPowerElapsedMs;
+}
+
+/**
+ * Ends a phase, the time since the last boundary is added to it.
+ * @param phase PROFILE_INIT to PROFILE_SLEEP, or PROFILE_NONE
+ */
+void ProfileMark(uint8_t phase){
+    uint16_t ticks = profileTimer0();
+    uint32_t lowPowerMs = lowPowerElapsedMs;
+    if(phase<PROFILE_PHASES){
+        uint32_t time = ((uint32_t)(uint16_t)(ticks-profileTicks)*PROFILE_T0_US)/PROFILE_UNIT_US;
+        time = time + (lowPowerMs-profileLowPowerMs)*(1000/PROFILE_UNIT_US);
+        time = time + profilePhase[phase];
+        if(time>=(1UL<<PROFILE_BITS)){
+            time = (1UL<<PROFILE_BITS)-1;
+        }
+        profilePhase[phase] = (uint16_t)time;
+    }
+    profileTicks = ticks;
+    profileLowPowerMs = lowPowerMs;
+}
+
+/**
+ * Call just before sleep.  Keeps this wake's phases for the next packet.
+ */
+void ProfileEnd(void){
+    for(uint8_t i=0;i<PROFILE_PHASES;i++){
+        profileLast[i] = profilePhase[i];
+    }
+}
+
+/**
+ * Copies the last complete wake's phases into a packet.
+ * @param dest  PROFILE_BYTES bytes
+ */
+void ProfileWrite(uint8_t* dest){
+    uint32_t bits = 0; //Not written yet in the bottom pending bits
+    uint8_t pending = 0;
+    for(uint8_t i=0;i<PROFILE_PHASES;i++){
+        bits = bits<<PROFILE_BITS | profileLast[i];
+        pending = pending + PROFILE_BITS;
+        while(pending>=8){
+            pending = pending - 8;
+            *dest++ = (uint8_t)(bits>>pending); //MSB first
+        }
+    }
+}
@@ -0,0 +1,45 @@
+/* 
+ * File:   profile.h
+ * Author: Andy Page
+ * Comments: Wake cycle phase profiler.  Timer0 (Fosc/4, 1:256) is read at
+ *           each phase boundary and the time since the last boundary added to
+ *           that phase, time spent in low power delays is added from
+ *           lowPowerElapsedMs.  The phases of the last complete wake are
+ *           sent in packet bytes 34 to 47, 8 x 14-bit in 200us units (3.2s
+ *           at most) packed one after the other, MSB first.
+ * Revision history: 1, 19th October 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef INC_PROFILE_H
+#define	INC_PROFILE_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+
+#define PROFILE 0 //1 = send phase times in the spare packet bytes
+
+//Phases, in packet order
+#define PROFILE_INIT 0          //Wake to peripherals and sensor power up
+#define PROFILE_BH1750 1        //Visible light mode, measurement wait and read
+#define PROFILE_VEML6075 2      //UV readings
+#define PROFILE_ADC 3           //Battery and temperature
+#define PROFILE_RADIO_START 4   //LoRaStart and settings
+#define PROFILE_FIFO 5          //FIFO load, listen before talk, TX start
+#define PROFILE_TX_WAIT 6       //Waiting for TxDone
+#define PROFILE_SLEEP 7         //Sleep entry, peripherals off and the count checkpoint
+#define PROFILE_PHASES 8
+#define PROFILE_NONE 0xFF       //Moves the boundary without adding to a phase
+
+#define PROFILE_BITS 14         //Per phase in the packet
+#define PROFILE_UNIT_US 200
+#define PROFILE_BYTES (PROFILE_PHASES*PROFILE_BITS/8)
+#define PROFILE_T0_US (1024000000UL/_XTAL_FREQ) //Timer0 microseconds per tick
+
+void ProfileStart(void);
+void ProfileMark(uint8_t);
+void ProfileEnd(void);
+void ProfileWrite(uint8_t*);
+
+#endif	/* INC_PROFILE_H */
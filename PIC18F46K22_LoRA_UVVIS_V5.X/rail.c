@@ -0,0 +1,61 @@
+/**
+ * rail.c
+ * Waits for the sensors on the Q1 rail to answer on I2C, see rail.h.
+ * I2C1 must be initialised and the rail turned on just before.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <xc.h>
+#include <stdint.h>
+#include "rail.h"
+#include "i2c1.h"
+#include "lowpower.h"
+#include "VEML6075.h"
+#include "BH1750.h"
+
+uint8_t railReadyMs[RAIL_DEVICES];
+
+/**
+ * Address only write, the device is there if it ACKs.
+ * @param address   8-bit write address
+ * @return 1 if the device ACKed
+ */
+static uint8_t railProbe(uint8_t address){
+    I2C1_Start();
+    uint8_t nack = I2C1_Write_Byte_Read_Ack(address);
+    I2C1_Stop();
+    return !nack;
+}
+
+/**
+ * Probes each sensor until it ACKs or RAIL_TIMEOUT_MS has passed, waiting in
+ * low power between tries.  Ready times are left in railReadyMs.
+ * @return 1 if all the sensors are ready
+ */
+uint8_t RailWaitReady(void){
+    uint8_t address[RAIL_DEVICES];
+    address[RAIL_VEML6075] = VEML6075_SLAVE_ADDRESS;
+    address[RAIL_BH1750] = bh1750Address;
+    uint8_t waiting = RAIL_DEVICES;
+    uint8_t ms = 0;
+    for(uint8_t i=0;i<RAIL_DEVICES;i++){
+        railReadyMs[i] = RAIL_NOT_READY;
+    }
+    while(1){
+        for(uint8_t i=0;i<RAIL_DEVICES;i++){
+            if(railReadyMs[i]==RAIL_NOT_READY && railProbe(address[i])){
+                railReadyMs[i] = ms;
+                waiting--;
+            }
+        }
+        if(waiting==0){
+            return 1;
+        }
+        if(ms>=RAIL_TIMEOUT_MS){
+            return 0; //Slow or faulty sensor, carry on without it
+        }
+        LowPowerDelayMs(RAIL_STEP_MS);
+        ms = ms + RAIL_STEP_MS;
+    }
+}
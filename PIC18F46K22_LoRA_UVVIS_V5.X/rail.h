@@ -0,0 +1,31 @@
+/* 
+ * File:   rail.h
+ * Author: Andy Page
+ * Comments: Sensor rail bring up.  After Q1 turns on, each sensor is probed
+ *           with an address only write until it ACKs, with low power waits in
+ *           between, so the sensors are only talked to once they are ready.
+ * Revision history: 1, 19th October 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef INC_RAIL_H
+#define	INC_RAIL_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+
+#define RAIL_STEP_MS 1          //Low power wait between probes
+#define RAIL_TIMEOUT_MS 50      //Give up on a sensor after this long
+#define RAIL_NOT_READY 0xFF     //Ready time for a sensor that never ACKed
+
+//Devices, index into railReadyMs
+#define RAIL_VEML6075 0
+#define RAIL_BH1750 1
+#define RAIL_DEVICES 2
+
+extern uint8_t railReadyMs[RAIL_DEVICES]; //Time from rail on to first ACK (ms) this wake
+
+uint8_t RailWaitReady(void);
+
+#endif	/* INC_RAIL_H */
@@ -0,0 +1,160 @@
+/**
+ * receiver.c
+ * Base receiver entry point, used instead of main.c by the receiver build
+ * (see receiver.h for the frame format).  The base is mains powered so it
+ * never sleeps, the radio is polled for RX done (DIO pins aren't connected)
+ * and each packet is read out in one FIFO burst.  Frames are queued on the
+ * USART2 ring and sent by the interrupt, so the next packet is already being
+ * received while the last one goes out.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <xc.h>
+#include <stdint.h>
+#include "config.h"
+#include "defines.h"
+#include "usart2.h"
+#include "clock.h"
+#include "LoRa.h"
+#include "CRC16.h"
+#include "settings.h"
+#include "ack.h"
+#include "samplelog.h"
+#include "receiver.h"
+
+static uint8_t rxData[RECEIVER_MAX_PACKET];
+
+static void receiverStart(void);
+static uint8_t receiverValid(uint8_t);
+static void receiverSend(uint8_t, uint8_t, uint8_t);
+static void receiverAck(void);
+
+void __interrupt() interruptHandler(void){
+    USART2_TxISR();
+}
+
+void main(void){
+    uint16_t polls = 0;
+    ClockSelect(CLOCK_CRYSTAL); //UART needs the crystal accuracy, no need to save power
+    ANSELAbits.ANSA2=0; //Analogue off
+    TRISAbits.RA2=0; //Output
+    LATAbits.LATA2=0; //Q1 on, RS232 driver supply
+    ANSELEbits.ANSE1=0; //Turn off analogue on RE1
+    ANSELEbits.ANSE2=0; //Turn off analogue on RE2
+    TRISEbits.RE1=0; //Green LED for status
+    TRISEbits.RE2=0; //Red LED for status
+    GREEN_LED=0;
+    RED_LED=0;
+    TRISDbits.RD7=1; //RX on UART2
+    USART2_Start(RECEIVER_BAUD);
+    receiverStart();
+    while(1){
+        CLRWDT(); //Watchdog is always on
+        uint8_t flags = LoRaGetIRQFlags();
+        if(flags & IRQ_RX_DONE){
+            SPI2WriteByte(IRQ_FLAGS_REG, flags); //Clear only what was seen
+            if(flags & IRQ_PAYLOAD_CRC_ERROR){
+                RED_LED=!RED_LED;
+                continue;
+            }
+            uint8_t length = LoRaRXData(rxData, RECEIVER_MAX_PACKET); //One burst from the start of the packet
+            uint8_t rssi = SPI2ReadByte(PKT_RSSI_VALUE_REG);
+            uint8_t snr = SPI2ReadByte(PKT_SNR_VALUE_REG);
+            if(receiverValid(length)){
+                receiverSend(length, rssi, snr);
+                GREEN_LED=!GREEN_LED;
+                if(RECEIVER_ACK && length==ACK_PACKET_LENGTH && (rxData[2]==RECEIVER_ACK_ID1 || rxData[2]==LOG_ID1)){
+                    receiverAck();
+                }
+            }
+            else{
+                RED_LED=!RED_LED;
+            }
+            polls = 0;
+        }
+        else if(++polls>=RECEIVER_MODE_CHECK){
+            polls = 0;
+            if((readOpModeRegister() & 0b10000111)!=(LORA_MODE | RX_CONT_MODE)){
+                receiverStart(); //Radio has been reset (brown out or ESD), set it up again
+            }
+        }
+    }
+}
+
+/**
+ * Resets the radio and leaves it listening in RX continuous on the sensor
+ * channel.  The sensors' default spreading factor is used, a sensor moved
+ * to another one by a downlink isn't heard here.
+ */
+static void receiverStart(void){
+    LoRaStart(TX_FREQ, SYNC_WORD);
+    LoRaSetSpreadingFactor(DEFAULT_SF);
+    SPI2WriteByte(FIFO_RX_BASE_ADDR_REG, 0); //Whole FIFO for receive
+    SPI2WriteByte(MAX_PAYLOAD_LENGTH_REG, RECEIVER_MAX_PACKET);
+    LoRaClearIRQFlags();
+    LoRaRXContinuousMode();
+}
+
+/**
+ * Checks the packet's own length byte and the CRC16 in its last two bytes
+ * (LSB first), as sent by every sensor.
+ * @param length Number of bytes received
+ * @return       1 if the packet is good
+ */
+static uint8_t receiverValid(uint8_t length){
+    if(length<RECEIVER_MIN_PACKET || rxData[0]!=length){
+        return 0;
+    }
+    uint16_t crc = CRC16(rxData, length-2);
+    return (uint8_t)crc==rxData[length-2] && (uint8_t)(crc>>8)==rxData[length-1];
+}
+
+/**
+ * Queues one frame on the USART2 ring.  putch only waits if the ring is full.
+ */
+static void receiverSend(uint8_t length, uint8_t rssi, uint8_t snr){
+    uint8_t sum = length + rssi + snr;
+    putch(RECEIVER_SYNC0);
+    putch(RECEIVER_SYNC1);
+    putch(length);
+    putch(rssi);
+    putch(snr);
+    for(uint8_t i=0;i<length;i++){
+        putch(rxData[i]);
+        sum = sum + rxData[i];
+    }
+    putch(sum);
+}
+
+/**
+ * Acknowledges the sensor or log packet in rxData with an ACK frame (see ack.h),
+ * once the node has had time to open its ACK window, then goes back to RX
+ * continuous.  Packets that arrive meanwhile are missed.
+ */
+static void receiverAck(void){
+    uint8_t ack[ACK_LENGTH];
+    ack[0] = ACK_LENGTH;
+    ack[1] = ACK_ID0;
+    ack[2] = ACK_ID1;
+    for(uint8_t i=0;i<8;i++){
+        ack[i+3] = rxData[i+3]; //Address
+    }
+    for(uint8_t i=0;i<4;i++){
+        ack[i+11] = rxData[i+12]; //Message count
+    }
+    unsigned short int calcCRC = CRC16(ack, ACK_LENGTH-2);
+    ack[ACK_LENGTH-2] = (uint8_t)(calcCRC&0xFF); //LSB
+    ack[ACK_LENGTH-1] = (uint8_t)(calcCRC>>8); //MSB
+    __delay_ms(RECEIVER_ACK_DELAY_MS);
+    LoRaClearIRQFlags();
+    if(LoRaTXData(ack, ACK_LENGTH)){
+        uint16_t maxPolls = LoRaAirtimeMs(ACK_LENGTH) + 10; //1ms polls
+        for(uint16_t i=0;i<maxPolls && !(LoRaGetIRQFlags() & IRQ_TX_DONE);i++){
+            __delay_ms(1);
+        }
+    }
+    LoRaStandbyMode(); //In case TxDone never came
+    LoRaClearIRQFlags();
+    LoRaRXContinuousMode();
+}
@@ -0,0 +1,43 @@
+/* 
+ * File:   receiver.h
+ * Author: Andy Page
+ * Comments: Base receiver (sensor type 0).  Built from the same source tree
+ *           as the UV/visible sensor by the "receiver" configuration, which
+ *           defines BASE_RECEIVER and uses receiver.c in place of main.c.
+ *           The radio stays in RX continuous, every packet with a good LoRa
+ *           CRC and a good CRC16 is sent out of USART2 as one frame:
+ *
+ *           0x55 0xAA  Sync
+ *           N          Payload length (the packet's own byte 0)
+ *           RSSI       PKT_RSSI_VALUE, dBm = RSSI - 157 (+ SNR/4 if SNR < 0)
+ *           SNR        PKT_SNR_VALUE, signed, quarter dB
+ *           Payload    N bytes as received, CRC16 included
+ *           Checksum   Sum of N, RSSI, SNR and the payload, modulo 256
+ *
+ *           With RECEIVER_ACK set, each UV/visible sensor reading or log
+ *           packet is answered with an ACK frame (see ack.h) for nodes built
+ *           with ACK_MODE.
+ *           Downlinks (downlink.h) are never sent: nothing gives the base
+ *           settings to send yet.
+ * Revision history: 1, 19th October 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef INC_RECEIVER_H
+#define	INC_RECEIVER_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+
+#define RECEIVER_SYNC0 0x55
+#define RECEIVER_SYNC1 0xAA
+#define RECEIVER_MAX_PACKET 255     //Largest LoRa payload
+#define RECEIVER_MIN_PACKET 3       //Length byte and CRC16
+#define RECEIVER_BAUD BAUD_115200   //About 5ms per 50 byte packet, airtime at SF7 is about 100ms
+#define RECEIVER_MODE_CHECK 50000   //Polls between checks that the radio is still in RX continuous
+#define RECEIVER_ACK 0              //1 = acknowledge sensor packets (nodes built with ACK_MODE)
+#define RECEIVER_ACK_ID1 0x02       //UV/visible sensor readings, their log packets (LOG_ID1) are acknowledged too
+#define RECEIVER_ACK_DELAY_MS 10    //The node polls TxDone every 10ms, its ACK window is open by then
+
+#endif	/* INC_RECEIVER_H */
@@ -0,0 +1,139 @@
+/**
+ * samplelog.c
+ * Store and forward sample log and message count checkpoints, see samplelog.h.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <xc.h>
+#include <stdint.h>
+#include "samplelog.h"
+#include "eeprom.h"
+#include "adc.h"
+
+static uint8_t logNext = 0; //Next record to write, the oldest one
+static uint8_t logReadMask[2]; //Records returned by the last SampleLogRead (bit per record)
+
+static uint8_t logRecordAddress(uint8_t record){
+    return LOG_ADDRESS + record*LOG_RECORD_LENGTH;
+}
+
+static uint8_t logPending(uint8_t record){
+    return EEPROMReadByte(logRecordAddress(record))==LOG_PENDING;
+}
+
+/**
+ * Finds the last message count checkpoint.  Also finds where the log
+ * carries on from, so call once after a reset.
+ * @return Message count to carry on from
+ */
+uint32_t SampleLogLoadCount(void){
+    uint32_t count = 0;
+    uint8_t found = 0;
+    for(uint8_t slot=0;slot<LOG_COUNT_SLOTS;slot++){
+        uint8_t address = LOG_COUNT_ADDRESS + slot*LOG_COUNT_SLOT_LENGTH;
+        uint32_t value = 0;
+        uint8_t sum = 0;
+        for(uint8_t i=0;i<4;i++){
+            uint8_t b = EEPROMReadByte(address+i);
+            value = (value<<8) | b;
+            sum = sum + b;
+        }
+        if((uint8_t)(sum ^ 0x5A)==EEPROMReadByte(address+4) && (!found || value>count)){
+            count = value;
+            found = 1;
+        }
+    }
+    //Carry on writing after the newest pending record
+    for(uint8_t record=0;record<LOG_RECORDS;record++){
+        if(logPending(record) && !logPending((record+1)%LOG_RECORDS)){
+            logNext = (record+1)%LOG_RECORDS;
+        }
+    }
+    if(found){
+        count = count + LOG_COUNT_INTERVAL; //Anything after the checkpoint was lost
+    }
+    return count;
+}
+
+/**
+ * Saves the message count every LOG_COUNT_INTERVAL messages.
+ * @param count Message count
+ */
+void SampleLogSaveCount(uint32_t count){
+    if(count % LOG_COUNT_INTERVAL){
+        return;
+    }
+    uint8_t address = LOG_COUNT_ADDRESS + ((count/LOG_COUNT_INTERVAL)%LOG_COUNT_SLOTS)*LOG_COUNT_SLOT_LENGTH;
+    uint8_t sum = 0;
+    for(uint8_t i=0;i<4;i++){
+        uint8_t b = (uint8_t)(count>>(24-8*i));
+        EEPROMWriteByte(address+i, b);
+        sum = sum + b;
+    }
+    EEPROMWriteByte(address+4, sum ^ 0x5A); //Written last so a torn write is ignored
+}
+
+/**
+ * Adds a sample to the log, overwriting the oldest if the log is full.
+ * @param packet    Uplink packet holding the sample (v5 layout)
+ */
+void SampleLogAppend(const uint8_t* packet){
+    uint8_t record[LOG_DATA_LENGTH];
+    uint16_t batt = ((uint16_t)packet[16]<<8 | packet[17])>>ADC_EXTRA_BITS; //Top 10 bits
+    uint16_t temp = ((uint16_t)packet[18]<<8 | packet[19])>>ADC_EXTRA_BITS;
+    record[0] = packet[14]; //Message count, low 16 bits
+    record[1] = packet[15];
+    record[2] = (uint8_t)(batt>>2);
+    record[3] = (uint8_t)((batt&0x03)<<6 | ((temp>>4)&0x3F));
+    record[4] = (uint8_t)((temp&0x0F)<<4);
+    for(uint8_t i=0;i<10;i++){
+        record[5+i] = packet[24+i]; //UVA, UVB, COMP1, COMP2, VIS
+    }
+    uint8_t address = logRecordAddress(logNext);
+    EEPROMWriteByte(address, LOG_SENT); //Not valid while it is being written
+    for(uint8_t i=0;i<LOG_DATA_LENGTH;i++){
+        EEPROMWriteByte(address+1+i, record[i]);
+    }
+    EEPROMWriteByte(address, LOG_PENDING);
+    logNext = (logNext+1)%LOG_RECORDS;
+}
+
+/**
+ * Copies the oldest pending records (bytes 1-15 of each) for a log packet.
+ * SampleLogMarkSent() then marks them as sent once the packet has gone.
+ * @param dest  max * LOG_DATA_LENGTH bytes
+ * @param max   Most records to copy
+ * @return Number of records copied
+ */
+uint8_t SampleLogRead(uint8_t* dest, uint8_t max){
+    uint8_t n = 0;
+    logReadMask[0] = 0;
+    logReadMask[1] = 0;
+    for(uint8_t i=0;i<LOG_RECORDS && n<max;i++){
+        uint8_t record = (logNext+i)%LOG_RECORDS; //Oldest first
+        if(!logPending(record)){
+            continue;
+        }
+        uint8_t address = logRecordAddress(record);
+        for(uint8_t j=0;j<LOG_DATA_LENGTH;j++){
+            dest[n*LOG_DATA_LENGTH+j] = EEPROMReadByte(address+1+j);
+        }
+        logReadMask[record>>3] |= (uint8_t)(1<<(record&7));
+        n++;
+    }
+    return n;
+}
+
+/**
+ * Marks the records returned by the last SampleLogRead() as sent.
+ */
+void SampleLogMarkSent(void){
+    for(uint8_t record=0;record<LOG_RECORDS;record++){
+        if(logReadMask[record>>3] & (1<<(record&7))){
+            EEPROMWriteByte(logRecordAddress(record), LOG_SENT);
+        }
+    }
+    logReadMask[0] = 0;
+    logReadMask[1] = 0;
+}
@@ -0,0 +1,72 @@
+/* 
+ * File:   samplelog.h
+ * Author: Andy Page
+ * Comments: Store and forward sample log in data EEPROM.  Samples that could
+ *           not be sent (UVLO or failed transmission) are kept in a circular
+ *           log and sent in log packets once the link is working again.  The
+ *           message count is checkpointed so it carries on after a reset.
+ * Revision history: 1, 19th October 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef INC_SAMPLELOG_H
+#define	INC_SAMPLELOG_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+
+/*
+ * Message count checkpoints, LOG_COUNT_SLOTS x 5 bytes from LOG_COUNT_ADDRESS
+ * 0-3      Message count (MSB first)
+ * 4        Check byte (sum of bytes 0-3 XOR 0x5A)
+ * Slot (count/LOG_COUNT_INTERVAL) % LOG_COUNT_SLOTS is written each time, the
+ * highest valid count is used after a reset (plus LOG_COUNT_INTERVAL so that
+ * counts are never repeated) and checkpointed straight away, so a blank
+ * EEPROM starts at 0 and each reset moves on by LOG_COUNT_INTERVAL.
+ */
+#define LOG_COUNT_ADDRESS 0x10
+#define LOG_COUNT_SLOTS 8
+#define LOG_COUNT_SLOT_LENGTH 5
+#define LOG_COUNT_INTERVAL 64 //Messages between checkpoints, each slot is written every 512 messages
+
+/*
+ * Sample records, LOG_RECORDS x LOG_RECORD_LENGTH bytes from LOG_ADDRESS
+ * 0        Flag (LOG_PENDING once the rest has been written, LOG_SENT after)
+ * 1-2      Message count, low 16 bits (MSB first)
+ * 3-5      Battery and temperature, 10 bits each (batt 9..0, temp 9..0, 4 bits 0),
+ *          the top 10 bits of the reading whatever ADC_EXTRA_BITS is
+ * 6-15     UVA, UVB, COMP1, COMP2, VIS (MSB first)
+ * Records are written round robin so the wear is spread over the whole log.
+ * The log packets carry bytes 1-15 of each record.
+ */
+#define LOG_ADDRESS 0x38
+#define LOG_RECORDS 12
+#define LOG_RECORD_LENGTH 16
+#define LOG_DATA_LENGTH 15
+#define LOG_PENDING 0xA5
+#define LOG_SENT 0x00
+
+/*
+ * Log packet, same 50 byte frame as the uplink
+ * 0        Length
+ * 1-2      ID0, LOG_ID1
+ * 3-10     Address
+ * 11       Software version
+ * 12-15    Message count of the first record (MSB first)
+ * 16       Number of records
+ * 17-46    Up to LOG_RECORDS_PER_PACKET records (bytes 1-15 of each)
+ * 47       0
+ * 48-49    CRC16 (LSB first)
+ */
+#define LOG_ID1 0x22
+#define LOG_RECORDS_PER_PACKET 2
+#define LOG_DRAIN_PACKETS 3 //Log packets sent per wake at most
+
+uint32_t SampleLogLoadCount(void);
+void SampleLogSaveCount(uint32_t);
+void SampleLogAppend(const uint8_t*);
+uint8_t SampleLogRead(uint8_t*, uint8_t);
+void SampleLogMarkSent(void);
+
+#endif	/* INC_SAMPLELOG_H */
@@ -0,0 +1,92 @@
+/**
+ * settings.c
+ * Loads, validates and saves the tunable parameters held in data EEPROM.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <xc.h>
+#include <stdint.h>
+#include "settings.h"
+#include "eeprom.h"
+#include "CRC16.h"
+
+uint8_t settings[SETTINGS_BLOCK_LENGTH];
+
+static void settingsDefaults(void){
+    settings[SETTING_TX_EVERY] = DEFAULT_TX_EVERY;
+    settings[SETTING_PA_CONFIG] = DEFAULT_PA_CONFIG;
+    settings[SETTING_SF] = DEFAULT_SF;
+    settings[SETTING_UVLO_MSB] = (DEFAULT_UVLO>>8)&0xFF;
+    settings[SETTING_UVLO_LSB] = DEFAULT_UVLO&0xFF;
+    settings[SETTING_RX_EVERY] = DEFAULT_RX_EVERY;
+}
+
+/**
+ * Checks a parameter block is sensible before it is used.
+ * @return 1 if valid
+ */
+static uint8_t settingsValid(const uint8_t* block){
+    if(block[SETTING_TX_EVERY]==0){
+        return 0;
+    }
+    if(block[SETTING_SF]<7 || block[SETTING_SF]>12){
+        return 0;
+    }
+    if(!(block[SETTING_PA_CONFIG] & 0x80)){
+        return 0; //RFO output is not connected on the RFM95W, must use PA_BOOST
+    }
+    return 1;
+}
+
+/**
+ * Loads settings from EEPROM, falling back to defaults if the magic byte or
+ * CRC is wrong.
+ */
+void SettingsLoad(void){
+    uint8_t buffer[SETTINGS_BLOCK_LENGTH+3];
+    for(uint8_t i=0;i<sizeof(buffer);i++){
+        buffer[i] = EEPROMReadByte(SETTINGS_EEPROM_ADDRESS+i);
+    }
+    unsigned short int calcCRC = CRC16(buffer, SETTINGS_BLOCK_LENGTH+1);
+    uint16_t storedCRC = buffer[SETTINGS_BLOCK_LENGTH+1] | (uint16_t)buffer[SETTINGS_BLOCK_LENGTH+2]<<8;
+    if(buffer[0]==SETTINGS_MAGIC && calcCRC==storedCRC && settingsValid(buffer+1)){
+        for(uint8_t i=0;i<SETTINGS_BLOCK_LENGTH;i++){
+            settings[i] = buffer[i+1];
+        }
+    }
+    else{
+        settingsDefaults();
+    }
+}
+
+/**
+ * Validates a new parameter block and saves it to EEPROM.
+ * @param block     SETTINGS_BLOCK_LENGTH bytes
+ * @return 1 if applied, 0 if rejected
+ */
+uint8_t SettingsApply(const uint8_t* block){
+    if(!settingsValid(block)){
+        return 0;
+    }
+    uint8_t buffer[SETTINGS_BLOCK_LENGTH+1];
+    buffer[0] = SETTINGS_MAGIC;
+    for(uint8_t i=0;i<SETTINGS_BLOCK_LENGTH;i++){
+        settings[i] = block[i];
+        buffer[i+1] = block[i];
+    }
+    unsigned short int calcCRC = CRC16(buffer, SETTINGS_BLOCK_LENGTH+1);
+    for(uint8_t i=0;i<SETTINGS_BLOCK_LENGTH+1;i++){
+        EEPROMWriteByte(SETTINGS_EEPROM_ADDRESS+i, buffer[i]);
+    }
+    EEPROMWriteByte(SETTINGS_EEPROM_ADDRESS+SETTINGS_BLOCK_LENGTH+1, calcCRC&0xFF); //LSB
+    EEPROMWriteByte(SETTINGS_EEPROM_ADDRESS+SETTINGS_BLOCK_LENGTH+2, (calcCRC&0xFF00u)>>8u); //MSB
+    return 1;
+}
+
+/**
+ * UVLO threshold in battery A to D counts
+ */
+uint16_t SettingsUVLO(void){
+    return (uint16_t)settings[SETTING_UVLO_MSB]<<8 | settings[SETTING_UVLO_LSB];
+}
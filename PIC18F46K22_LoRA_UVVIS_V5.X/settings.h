@@ -0,0 +1,44 @@
+/* 
+ * File:   settings.h
+ * Author: Andy Page
+ * Comments: Tunable parameters kept in data EEPROM so they can be changed
+ *           over the air (see downlink.c) without reflashing.
+ * Revision history: 1, 19th October 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef INC_SETTINGS_H
+#define	INC_SETTINGS_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+
+//EEPROM layout: magic, parameter block, CRC16 (LSB first)
+#define SETTINGS_EEPROM_ADDRESS 0x00
+#define SETTINGS_MAGIC 0x5A
+#define SETTINGS_BLOCK_LENGTH 6 //Bytes in the parameter block
+
+//Parameter block layout (same in EEPROM and in downlink frames)
+#define SETTING_TX_EVERY 0      //Transmit every N wakes (1-255)
+#define SETTING_PA_CONFIG 1     //Value for PA_CONFIG_REG
+#define SETTING_SF 2            //Spreading factor 7-12
+#define SETTING_UVLO_MSB 3      //UVLO threshold in battery A to D counts
+#define SETTING_UVLO_LSB 4
+#define SETTING_RX_EVERY 5      //Open a downlink window every N transmissions (0 = never)
+
+//Defaults used when EEPROM is blank or corrupt
+#define DEFAULT_TX_EVERY 1
+#define DEFAULT_PA_CONFIG 0x8F  //PA_BOOST, max power
+#define DEFAULT_SF 7
+#define DEFAULT_UVLO (2100/4)   //2.1V UVLO below which transmitter operation is prevented
+#define DEFAULT_RX_EVERY 60     //About once an hour
+
+extern uint8_t settings[SETTINGS_BLOCK_LENGTH];
+
+void SettingsLoad(void);
+uint8_t SettingsApply(const uint8_t*);
+uint16_t SettingsUVLO(void);
+
+#endif	/* INC_SETTINGS_H */
+
@@ -0,0 +1,173 @@
+/**
+ * slots.c
+ * Keeps each node transmitting at a fixed period so that nodes started
+ * together spread over the slots rather than landing on each other.
+ * 
+ * The start of each cycle is delayed (in low power idle) so that the time from
+ * one cycle start to the next is SLOT_FRAME_MS:
+ *     delay = SLOT_FRAME_MS - watchdog period - awake time of the last cycle
+ * The awake time is measured with Timer0 from the crystal.  The watchdog
+ * period comes from the LFINTOSC frequency, which is measured by counting
+ * LFINTOSC/4 on Timer1 across a radio RX timeout of known length (the radio
+ * runs from its own 32MHz crystal).  The LFINTOSC can't be compared to the
+ * PIC crystal directly because all the PIC timers run from the system clock,
+ * and the radio's DIO pins aren't connected so Timer1 gate or CCP capture
+ * can't time the timeout edge.  It is polled over SPI instead, which at 31kHz
+ * leaves each calibration good to about +/-0.2%, up to +/-150ms in a cycle.
+ * Nothing is received from the gateway to line nodes up again (no beacon), so
+ * each node's position wanders by that much a cycle and neighbouring slots
+ * can meet after a few cycles.  The slots keep the period steady and spread
+ * nodes that start together; they don't keep them apart indefinitely.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <xc.h>
+#include <stdint.h>
+#include "defines.h"
+#include "slots.h"
+#include "lowpower.h"
+#include "clock.h"
+#include "LoRa.h"
+
+uint16_t slotsDelayMs = 0;
+static uint8_t slotsRunning = 0;
+static uint16_t slotsAwakeMs = SLOT_AWAKE_GUESS_MS; //Cycle start to sleep, last cycle
+static uint16_t slotsCalCountdown = 0; //Calibrate on the first transmission
+static uint16_t slotsCalMs = 0; //Time spent calibrating this cycle (Timer0 misses it)
+
+/**
+ * Slot number for this node, from an FNV-1a hash of the address.
+ */
+static uint8_t slotNumber(const uint8_t* address){
+    uint32_t hash = 0x811C9DC5;
+    for(uint8_t i=0;i<8;i++){
+        hash = (hash ^ address[i]) * 0x01000193;
+    }
+    return (uint8_t)(hash % SLOT_COUNT);
+}
+
+/**
+ * Watchdog period in milliseconds at the current LFINTOSC calibration.
+ */
+uint32_t SlotsWDTPeriodMs(void){
+    return (WDT_LF_TICKS*1000)/lpTickRate;
+}
+
+/**
+ * Call first thing after waking.  Waits until the start of this node's
+ * cycle, then starts Timer0 to measure how long we stay awake.
+ * @param address   8-byte node address
+ */
+void SlotsWake(const uint8_t* address){
+    int32_t delay;
+    if(!slotsRunning){
+        //First cycle after power up, move into our slot
+        delay = (int32_t)slotNumber(address) * SLOT_MS;
+        slotsRunning = 1;
+    }
+    else{
+        delay = (int32_t)SLOT_FRAME_MS - (int32_t)SlotsWDTPeriodMs() - slotsAwakeMs;
+    }
+    if(delay<0){
+        delay = 0; //Watchdog slower than the frame allows, slot will slip
+    }
+    if(delay>SLOT_FRAME_MS){
+        delay = SLOT_FRAME_MS;
+    }
+    slotsDelayMs = (uint16_t)delay;
+    LowPowerDelayMs(slotsDelayMs);
+    
+    //Timer0 16-bit, Fosc/4 with 1:256 prescale = 64us per tick at 16MHz, 4.2s range
+    T0CON = 0;
+    T0CONbits.T0PS = 0b111;
+    TMR0H = 0;
+    TMR0L = 0;
+    INTCONbits.TMR0IF = 0;
+    T0CONbits.TMR0ON = 1;
+    lowPowerElapsedMs = 0;
+    slotsCalMs = 0;
+}
+
+/**
+ * Call just before SLEEP().  Records the awake time for the next delay.
+ */
+void SlotsSleep(void){
+    T0CONbits.TMR0ON = 0;
+    uint8_t low = TMR0L; //Reading TMR0L latches TMR0H
+    uint16_t ticks = (uint16_t)TMR0H<<8 | low;
+    if(!INTCONbits.TMR0IF){
+        //Clock was switched during low power delays and calibration, those are added separately
+        slotsAwakeMs = (uint16_t)(((uint32_t)ticks*SLOT_T0_US)/1000 + lowPowerElapsedMs + slotsCalMs);
+    }
+    //else Timer0 overflowed (long awake time, e.g. flat battery), keep the previous value
+    INTCONbits.TMR0IF = 0;
+}
+
+/**
+ * Measures LFINTOSC against the radio crystal every SLOT_CAL_INTERVAL calls.
+ * Radio must be started and in standby.  Costs about 4.2s of RX current.
+ */
+void SlotsCalibrate(void){
+    if(slotsCalCountdown>0){
+        slotsCalCountdown--;
+        return;
+    }
+    slotsCalCountdown = SLOT_CAL_INTERVAL;
+    
+    uint8_t modemConfig2 = SPI2ReadByte(MODEM_CONFIG_2_REG);
+    uint8_t symbTimeout = SPI2ReadByte(SYMB_TIMEOUT_LSB_REG);
+    //SF9 so the timeout is SLOT_CAL_US whatever spreading factor is in use
+    SPI2WriteByte(MODEM_CONFIG_2_REG, (modemConfig2 & 0b00001100) | 0x90 | (SLOT_CAL_SYMBOLS>>8));
+    SPI2WriteByte(SYMB_TIMEOUT_LSB_REG, SLOT_CAL_SYMBOLS & 0xFF);
+    LoRaClearIRQFlags();
+    
+    PMD0bits.TMR1MD=0; //Turn Timer1 on
+    T1CON=0; //Fosc/4, 1:1 prescale, stopped
+    T1GCON=0;
+    TMR1H=0;
+    TMR1L=0;
+    PIR1bits.TMR1IF=0;
+    SPI2SetClock(SPI2_FOSC_4); //Fastest SPI clock otherwise polling is too slow at 31kHz
+    uint8_t previousClock = ClockSelect(CLOCK_LFINTOSC); //Run from LFINTOSC so Timer1 counts it
+    
+    //Timer1 starts before the write that starts RX, so the count runs from
+    //about one SPI access early to the end of the poll that saw the timeout
+    uint8_t opMode = (readOpModeRegister() & 0b11111000) | RX_SINGLE_MODE;
+    T1CONbits.TMR1ON=1;
+    SPI2WriteByte(OP_MODE_REG, opMode);
+    uint8_t flags = 0;
+    uint16_t polls = 0;
+    while(!(flags & (IRQ_RX_TIMEOUT|IRQ_RX_DONE)) && !PIR1bits.TMR1IF){
+        flags = LoRaGetIRQFlags();
+        polls++;
+    }
+    T1CONbits.TMR1ON=0;
+    uint8_t low = TMR1L;
+    uint16_t ticks = (uint16_t)TMR1H<<8 | low;
+    uint8_t overflow = PIR1bits.TMR1IF;
+    //A poll takes about 15ms at 31kHz.  Take off the write (about one poll) and
+    //half a poll, the average time from the timeout to the poll that saw it.
+    //What's left is +/- half a poll, about 0.2% of SLOT_CAL_US.
+    uint16_t poll = ticks/polls;
+    ticks -= poll + poll/2;
+    
+    ClockSelect(previousClock);
+    SPI2SetClock(SPI2_CLOCK);
+    PIR1bits.TMR1IF=0;
+    PMD0bits.TMR1MD=1; //Turn Timer1 off
+    
+    LoRaStandbyMode(); //In case of RX done rather than timeout
+    LoRaClearIRQFlags();
+    SPI2WriteByte(MODEM_CONFIG_2_REG, modemConfig2);
+    SPI2WriteByte(SYMB_TIMEOUT_LSB_REG, symbTimeout);
+    
+    slotsCalMs = (uint16_t)(SLOT_CAL_US/1000);
+    if(!overflow && (flags & IRQ_RX_TIMEOUT)){
+        uint32_t rate = ((uint32_t)ticks*15625)/(SLOT_CAL_US/64); //ticks*1000000/SLOT_CAL_US without overflowing
+        //Accept anything within +/-40% of nominal
+        if(rate>((uint32_t)LP_NOMINAL_TICK_RATE*6/10) && rate<((uint32_t)LP_NOMINAL_TICK_RATE*14/10)){
+            lpTickRate = (uint16_t)rate;
+        }
+    }
+}
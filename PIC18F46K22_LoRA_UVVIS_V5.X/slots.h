@@ -0,0 +1,40 @@
+/* 
+ * File:   slots.h
+ * Author: Andy Page
+ * Comments: Fixed period transmit slots.  Each node transmits once every
+ *           SLOT_FRAME_MS, offset by a slot number derived from its address.
+ *           The watchdog period drifts with temperature and supply so the
+ *           LFINTOSC (which clocks both the watchdog and the low power delays)
+ *           is calibrated against the radio crystal using an RX timeout.
+ *           The timeout is polled over SPI so each calibration is only good
+ *           to about 0.2%, and with no beacon the slots drift (see slots.c).
+ * Revision history: 1, 19th October 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef INC_SLOTS_H
+#define	INC_SLOTS_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+
+#define SLOT_FRAME_MS 76000     //Transmit period, must be longer than the slowest watchdog period (4.6ms*16384) plus awake time
+#define SLOT_MS 500             //Slot width, a 50 byte packet at SF7/125kHz is 97.5ms plus a few cycles of calibration error
+#define SLOT_COUNT 8            //Number of slots in the frame
+#define SLOT_CAL_INTERVAL 60    //Calibrate LFINTOSC every this many wakes
+#define SLOT_CAL_SYMBOLS 1023   //RX timeout used for calibration, 1023 symbols of 4.096ms at SF9/125kHz
+#define SLOT_CAL_US 4190208     //SLOT_CAL_SYMBOLS in microseconds
+#define SLOT_AWAKE_GUESS_MS 400 //Awake time assumed until it has been measured
+#define WDT_LF_TICKS 524288UL    //Watchdog period in Timer1 ticks (LFINTOSC/4): 128*16384/4
+#define SLOT_T0_US (1024000000UL/_XTAL_FREQ) //Timer0 microseconds per tick (Fosc/4, 1:256)
+
+extern uint16_t slotsDelayMs; //Delay applied at the start of this wake (for debugging)
+
+void SlotsWake(const uint8_t*);
+void SlotsSleep(void);
+void SlotsCalibrate(void);
+uint32_t SlotsWDTPeriodMs(void);
+
+#endif	/* INC_SLOTS_H */
+
@@ -0,0 +1,131 @@
+/**
+ * spi2.c
+ * SPI2 master transport used by LoRa.c, see spi2.h.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <xc.h>
+#include <stdint.h>
+#include "spi2.h"
+#include "hal.h"
+
+/**
+ * Sends one byte and returns the byte clocked in at the same time.
+ */
+static uint8_t spi2Transfer(uint8_t data){
+    SSP2IF=0; //Clear interrupt flag
+    SSP2BUF=data;
+    HAL_KICK(HAL_SSP2);
+    while(!SSP2IF){
+        //Wait for transmission and reception to complete
+    }
+    return SSP2BUF;
+}
+
+/**
+ * Configures the SPI2 pins and module as master, mode 0, clock SPI2_CLOCK.
+ */
+void SPI2Start(void){
+    //Set up SPI pins first
+    TRISDbits.RD1=1; //SDIx must have corresponding TRIS bit set (input)
+    TRISDbits.RD4=0; //SDOx must have corresponding TRIS bit cleared (output)
+    TRISDbits.RD0=0; //SCKx (Master mode) must have corresponding TRIS bit cleared (output)
+    TRISDbits.RD3=0; //#SS must have corresponding TRIS bit cleared (output)
+    ANSELDbits.ANSD1=0; //Input buffer enabled
+    ANSELDbits.ANSD4=0; //Digital
+    ANSELDbits.ANSD3=0; //Digital
+    ANSELDbits.ANSD0=0; //Digital
+    SPI2_NSS=1; //Set SS high so chip is not selected
+    HAL_KICK(HAL_SPI2_NSS);
+    
+    //Clock polarity
+    SSP2CON1bits.CKP=0; //Clock idle low, active high
+    SSP2STATbits.CKE=1; //Active to idle 1
+    
+    //Input data sampling
+    SSP2STATbits.SMP=1; //Input data sampled at end of data output time 1
+    
+    if(SPI2_CLOCK==SPI2_TMR2){
+        PMD0bits.TMR2MD=0; //Turn Timer2 on
+        T2CON=0; //1:1 prescale and postscale
+        PR2=SPI2_TMR2_PR;
+        T2CONbits.TMR2ON=1;
+    }
+    SPI2SetClock(SPI2_CLOCK);
+}
+
+/**
+ * Changes the SPI2 clock, the module is disabled while SSPM changes.
+ * @param sspm  SPI2_FOSC_4, SPI2_FOSC_16, SPI2_FOSC_64 or SPI2_TMR2
+ */
+void SPI2SetClock(uint8_t sspm){
+    SSP2CON1bits.SSPEN=0;
+    SSP2CON1bits.SSPM=sspm; //SPI Master Mode
+    SSP2CON1bits.SSPEN=1; //Enabled
+}
+
+/**
+ * SPI2WriteByte
+ * Writes an address byte, then writes a data byte
+ * @param address
+ * @param data
+ */
+void SPI2WriteByte(uint8_t address, uint8_t data){
+    SPI2_NSS=0;
+    spi2Transfer(address|0x80); //bit 7 set to indicate a register write
+    spi2Transfer(data);
+    SPI2_NSS=1;
+    HAL_KICK(HAL_SPI2_NSS);
+}
+
+/**
+ * SPI2ReadByte
+ * Writes an address byte then reads a byte back.  0 is sent as a dummy value
+ * for the second transfer.
+ * @param address
+ * @return 
+ */
+uint8_t SPI2ReadByte(uint8_t address){
+    SPI2_NSS=0;
+    spi2Transfer(address);
+    uint8_t dataByte = spi2Transfer(0);
+    SPI2_NSS=1;
+    HAL_KICK(HAL_SPI2_NSS);
+    return dataByte;
+}
+
+/**
+ * SPI2WriteBurst
+ * Writes an address byte then length bytes in one transaction.
+ * @param address
+ * @param data      Bytes to write
+ * @param length    Number of bytes to write
+ */
+void SPI2WriteBurst(uint8_t address, const uint8_t* data, uint8_t length){
+    SPI2_NSS=0;
+    spi2Transfer(address|0x80);
+    for(uint8_t i=0;i<length;i++){
+        spi2Transfer(data[i]);
+    }
+    SPI2_NSS=1;
+    HAL_KICK(HAL_SPI2_NSS);
+}
+
+/**
+ * SPI2ReadBurst
+ * Writes an address byte then reads length bytes back in one transaction.
+ * The FIFO address pointer increments on each byte read from FIFO_REG.
+ * @param address
+ * @param data      Buffer for the bytes read
+ * @param length    Number of bytes to read
+ */
+void SPI2ReadBurst(uint8_t address, uint8_t* data, uint8_t length){
+    SPI2_NSS=0;
+    spi2Transfer(address);
+    for(uint8_t i=0;i<length;i++){
+        data[i] = spi2Transfer(0); //Dummy byte to clock the data in
+    }
+    SPI2_NSS=1;
+    HAL_KICK(HAL_SPI2_NSS);
+}
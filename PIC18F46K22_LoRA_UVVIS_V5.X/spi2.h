@@ -0,0 +1,41 @@
+/* 
+ * File:   spi2.h
+ * Author: Andy Page
+ * Comments: SPI2 master transport for the RFM95W (SX1276).  Register access
+ *           is address byte (bit 7 set for a write) then data, burst
+ *           transfers carry on from the address (FIFO_REG doesn't increment).
+ * Revision history: 1, 19th October 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef INC_SPI2_H
+#define	INC_SPI2_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+
+//SSPM values for SPI2_CLOCK and SPI2SetClock
+#define SPI2_FOSC_4 0b0000   //4MHz at 16MHz
+#define SPI2_FOSC_16 0b0001  //1MHz at 16MHz
+#define SPI2_FOSC_64 0b0010  //250kHz at 16MHz
+#define SPI2_TMR2 0b0011     //Timer2 output/2, Timer2 period from SPI2_TMR2_PR
+
+#define SPI2_CLOCK SPI2_FOSC_4 //SX1276 allows up to 10MHz
+#define SPI2_TMR2_PR 0         //PR2 when SPI2_CLOCK is SPI2_TMR2 (Fosc/4/(PR2+1)/2)
+
+/*
+ * SX1276 NSS timing: setup 30ns, hold 100ns, high between accesses 40ns.
+ * Each is shorter than one instruction cycle (250ns at 16MHz) and SSP2IF is
+ * only set after the last SCK edge, so no padding delays are needed.
+ */
+#define SPI2_NSS LATDbits.LATD3
+
+void SPI2Start(void);
+void SPI2SetClock(uint8_t);
+void SPI2WriteByte(uint8_t, uint8_t);
+uint8_t SPI2ReadByte(uint8_t);
+void SPI2WriteBurst(uint8_t, const uint8_t*, uint8_t);
+void SPI2ReadBurst(uint8_t, uint8_t*, uint8_t);
+
+#endif	/* INC_SPI2_H */
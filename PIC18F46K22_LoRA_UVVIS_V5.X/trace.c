@@ -0,0 +1,27 @@
+/**
+ * trace.c
+ * Binary debug trace events, queued on the interrupt driven USART2 so they
+ * cost a few microseconds each instead of a blocking printf.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <xc.h>
+#include <stdint.h>
+#include "trace.h"
+#include "usart2.h"
+
+/**
+ * Queues one trace event.
+ * @param id    Event id (see trace.h)
+ * @param value 16-bit value for the event
+ */
+void TraceEvent(uint8_t id, uint16_t value){
+    uint8_t msb = (uint8_t)(value>>8);
+    uint8_t lsb = (uint8_t)(value&0xFF);
+    putch(TRACE_SYNC);
+    putch(id);
+    putch(msb);
+    putch(lsb);
+    putch(id+msb+lsb); //Checksum
+}
@@ -0,0 +1,48 @@
+/* 
+ * File:   trace.h
+ * Author: Andy Page
+ * Comments: Compact binary debug trace.  Each event is 5 bytes on USART2:
+ *           TRACE_SYNC, event id, value MSB, value LSB, checksum (sum of
+ *           id and value bytes).  tools/tracedecode.py reads the event names
+ *           from this file, keep one define per line with its comment.
+ * Revision history: 1, 19th October 2026
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef INC_TRACE_H
+#define	INC_TRACE_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h>
+
+#define TRACE_SYNC 0xA5
+
+//Event ids
+#define TRACE_BOOT 0x01          //Cold boot, value is RCON
+#define TRACE_COLD_INIT_US 0x02  //Cold boot set up time (us), not counting the rail wait
+#define TRACE_WARM_INIT_US 0x03  //Warm wake set up time (us), not counting the rail wait
+#define TRACE_VEML6075_READY 0x04 //VEML6075 ACK after rail on (ms, 255 = timed out)
+#define TRACE_BH1750_READY 0x05  //BH1750 ACK after rail on (ms, 255 = timed out)
+#define TRACE_UVA 0x10           //UVA reading
+#define TRACE_UVB 0x11           //UVB reading
+#define TRACE_COMP1 0x12         //UV compensation 1 reading
+#define TRACE_COMP2 0x13         //UV compensation 2 reading
+#define TRACE_VIS 0x14           //Visible light reading
+#define TRACE_BATT 0x15          //Battery A to D reading
+#define TRACE_TEMP 0x16          //Temperature A to D reading
+#define TRACE_RADIO_START 0x20   //Radio started, value is frequency in 100kHz
+#define TRACE_TX_START 0x21      //Packet loaded, LBT and TX starting
+#define TRACE_TX_MODE 0x22       //Radio in TX mode
+#define TRACE_TX_DONE 0x23       //TxDone seen, value is 10ms polls waited
+#define TRACE_TX_FAIL 0x24       //No TxDone
+#define TRACE_CHANNEL_BUSY 0x25  //LBT gave up, packet not sent
+#define TRACE_ACK 0x26           //ACK result, value is sent<<8 | queued packets
+#define TRACE_DOWNLINK 0x27      //Downlink result (1 applied, 2 rejected)
+#define TRACE_SLOT_DELAY 0x30    //Slot delay applied this wake (ms)
+#define TRACE_WDT_MS 0x31        //Estimated watchdog period (ms)
+#define TRACE_SLEEP 0x3F         //Going to sleep, value is low 16 bits of the message count
+
+void TraceEvent(uint8_t, uint16_t);
+
+#endif	/* INC_TRACE_H */
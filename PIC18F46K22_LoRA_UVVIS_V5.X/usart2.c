@@ -1,7 +1,14 @@
 #include "usart2.h"
 #include "config.h"
+#include "hal.h"
 #include <stdint.h>
 
+static volatile uint8_t txBuffer[USART2_TX_BUFFER]; //Transmit ring buffer
+static volatile uint8_t txHead = 0; //Next free position
+static volatile uint8_t txTail = 0; //Next byte to send
+
+static void usart2Send(void);
+
 //Configures serial port 2 8-bit
 /**
  * Configures USART2 for serial port use with the defined baud rate.
@@ -31,60 +38,93 @@ void USART2_Start(const uint8_t baudrate){
     BAUDCON2bits.WUE    = 0;   //RXx pin is not monitored or the rising edge detected
     BAUDCON2bits.ABDEN  = 0;   //Baudrate Measurement (autobaud) is Disabled
 
+    uint16_t brg;
     if(baudrate==BAUD_19200){
-        SPBRGH2 = 0x03;
-        SPBRG2 = 0x40;
-        //This gives 19.2k baud rate (actually 19.21k +0.04%)
+        brg = USART2_BRG(19200); //At 16MHz 207, 19.23k +0.16%
     }
     else if(baudrate==BAUD_9600){
-        SPBRGH2 = 0x06;
-        SPBRG2 = 0x82;
-        //This gives 9200 baud rate (actually 9598.1 -0.02%)
+        brg = USART2_BRG(9600); //At 16MHz 416, 9592 -0.08%
     }
     else if(baudrate==BAUD_115200){
-        SPBRGH2 = 0;
-        SPBRG2 = 0x8A;
-        //This gives 115200 baud rate (actually 115.11k -0.08%)
+        brg = USART2_BRG(115200); //At 16MHz 34, 114.3k -0.79%
     }
     else{
         //Default is 57600
-        SPBRGH2 =  0x01;    //EUSART1 Baud Rate Generator Register High Byte       (0)
-        SPBRG2	= 0x17;    //EUSART1 Baud Rate Generator Register Low Byte (x) 0x15
-        //This gives 57.6k baud rate (actually 57.55k -0.08%)
+        brg = USART2_BRG(57600); //At 16MHz 68, 57.97k +0.64%
     }
+    SPBRGH2 = (uint8_t)(brg>>8); //EUSART2 Baud Rate Generator Register High Byte
+    SPBRG2 = (uint8_t)brg; //EUSART2 Baud Rate Generator Register Low Byte
+
+    txHead = 0;
+    txTail = 0;
+    PIE3bits.TX2IE=0; //Turned on when there is something to send
+    INTCONbits.PEIE=1; //Enable peripheral interrupts
+    INTCONbits.GIE=1; //Enable global interrupts
+}
 
-//    PIR1bits.RC1IF=0; //Clear interrupt bit
-//    PIE1bits.RC1IE=1; //Enable UART1 receive interrupt
-//    INTCONbits.PEIE_GIEL=1; //Enable peripheral interrupts
-//    INTCONbits.GIE_GIEH=1; //Enable global interrupts
+/**
+ * Sends the next byte from the ring buffer if there is one.  Called from the
+ * interrupt when TXREG2 is empty.
+ */
+void USART2_TxISR(void){
+    if(PIE3bits.TX2IE && PIR3bits.TX2IF){
+        usart2Send();
+    }
+}
+
+static void usart2Send(void){
+    if(txTail!=txHead){
+        TXREG2 = txBuffer[txTail];
+        HAL_KICK(HAL_USART2);
+        txTail = (txTail+1)&(USART2_TX_BUFFER-1);
+    }
+    if(txTail==txHead){
+        PIE3bits.TX2IE=0; //Nothing left, stop interrupting
+    }
 }
 
 /**
- * Puts a character into the transmit buffer of USART2 and waits for it to be transmitted.
+ * Waits until everything queued has been sent, including the last stop bit.
+ * Needed before the clock is changed or the UART is turned off.
+ */
+void USART2_Flush(void){
+    if(!RCSTA2bits.SPEN){
+        return; //Not running
+    }
+    while(txTail!=txHead){
+        if(!INTCONbits.GIE && PIR3bits.TX2IF){
+            usart2Send(); //Interrupts off, send by polling
+        }
+    }
+    while(!TRMT2){
+    }
+}
+
+/**
+ * Puts a character into the transmit buffer of USART2.
  * @param data  The data byte to send.
  */
 void putchar(char data){
-  while(!TRMT2){
-      
-  }
-  TXREG2 = data;
-  //Wait here til transmit buffer is empty
-  while(!TRMT2){
-      
-  }
+  putch(data);
 }
 
 /**
- * Puts a character into the transmit buffer of USART2 and waits for it to be transmitted.
+ * Queues a character for USART2 and returns straight away.  Only waits if
+ * the ring buffer is full.
  * @param data  The data byte to send.
  */
 void putch(char data){
-  while(!TRMT2){   
-  }
-  TXREG2 = data;
-  //Wait here until transmit buffer is empty
-  while(!TRMT2){   
+  uint8_t next = (txHead+1)&(USART2_TX_BUFFER-1);
+  while(next==txTail){
+      //Buffer full, wait for the interrupt to make room
+      if(!INTCONbits.GIE && PIR3bits.TX2IF){
+          usart2Send(); //Interrupts off, send by polling
+      }
   }
+  txBuffer[txHead] = (uint8_t)data;
+  txHead = next;
+  PIE3bits.TX2IE=1; //Start (or keep) sending
+  HAL_KICK(HAL_INTERRUPT);
 }
 
 /**
@@ -100,6 +140,9 @@ void USART2reset(){
  * Disables the USART2 module to save power.
  */
 void USART2_Stop(){
+    USART2_Flush(); //Let the last of the debug output go
+    INTCONbits.GIE=0; //Only the UART uses interrupts
+    PIE3bits.TX2IE=0;
     RCSTA2bits.SPEN  = 0;      //Serial port is disabled
     RCSTA2bits.CREN  = 0;      //Disables the receiver
 }
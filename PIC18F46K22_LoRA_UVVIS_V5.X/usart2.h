@@ -15,6 +15,15 @@
 #define BAUD_57600 2
 #define BAUD_115200 3
 
+#ifdef BASE_RECEIVER
+#define USART2_TX_BUFFER 256 //Transmit ring buffer size, room for a whole received packet
+#else
+#define USART2_TX_BUFFER 64 //Transmit ring buffer size, must be a power of 2
+#endif
+
+//SPBRGH2:SPBRG2 for BRG16=1, BRGH=1 (Fosc/(4*(n+1))), rounded to nearest
+#define USART2_BRG(b) ((uint16_t)((_XTAL_FREQ+2UL*(b))/(4UL*(b))-1))
+
 #include <xc.h> // include processor files - each processor file is guarded. 
 #include <stdint.h>
 
@@ -22,6 +31,12 @@ void USART2_Start(const uint8_t);
 
 void putchar(char);
 
+void putch(char);
+
+void USART2_TxISR(void);
+
+void USART2_Flush(void);
+
 void USART2reset(void);
 
 void USART2_Stop(void);
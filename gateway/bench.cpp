@@ -0,0 +1,496 @@
+/**
+ * bench.cpp
+ * Throughput of the gateway library.  Results are printed and appended to a
+ * CSV file (as sim/bench.c does) so runs can be compared.
+ *   uvgwbench [-r results.csv]
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include "calibrate.h"
+#include "capture.h"
+#include "crc16.h"
+#include "frame.h"
+#include "loadgen.h"
+#include "nodes.h"
+#include "pipeline.h"
+#include "receiver.h"
+#include "store.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <random>
+#include <string>
+#include <thread>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#ifndef BENCH_REVISION
+#define BENCH_REVISION "unknown"
+#endif
+
+using namespace gateway;
+
+namespace {
+
+constexpr double kMinSeconds = 0.3;     //Each benchmark runs for at least this long
+constexpr size_t kFrames = 1u<<16;      //Frames in the test set (3.2MB, bigger than L2)
+
+FILE* results = nullptr;
+volatile uint64_t sink;
+
+double Now(){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Prints and records one result.
+ * @param items     Items (frames, samples) processed
+ * @param bytes     Bytes processed
+ */
+void Record(const char* benchmark, const char* variant, double seconds, double items, double bytes){
+    double perSecond = items/seconds;
+    double mbPerSecond = bytes/seconds/1e6;
+    std::printf("%-10s %-22s %12.0f /s %10.1f MB/s %8.2f ns/item\n", benchmark, variant, perSecond, mbPerSecond,
+                seconds/items*1e9);
+    if(results){
+        char date[32];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof date, "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+        std::fprintf(results, "%s,%s,%s,%s,%.0f,%.1f,%.3f\n", date, BENCH_REVISION, benchmark, variant, perSecond,
+                     mbPerSecond, seconds/items*1e9);
+    }
+}
+
+/**
+ * Runs body (which handles one pass of n items) until kMinSeconds is up.
+ */
+template <typename Body>
+void Run(const char* benchmark, const char* variant, size_t n, size_t bytesPerItem, Body body){
+    body(); //Warm up
+    double start = Now();
+    double seconds;
+    size_t passes = 0;
+    do{
+        body();
+        passes++;
+        seconds = Now()-start;
+    }while(seconds<kMinSeconds);
+    Record(benchmark, variant, seconds, (double)passes*n, (double)passes*n*bytesPerItem);
+}
+
+std::vector<uint8_t> MakeFrames(size_t count){
+    std::mt19937 random(5);
+    std::vector<uint8_t> frames(count*kFrameLength);
+    for(size_t i=0;i<count;i++){
+        uint8_t* f = frames.data()+i*kFrameLength;
+        for(size_t k=0;k<kFrameLength;k++){
+            f[k] = (uint8_t)random();
+        }
+        f[0] = kFrameLength;
+        f[11] = kFrameVersion;
+        uint16_t crc = Crc16(f, kFrameCrcOffset);
+        f[48] = (uint8_t)crc;
+        f[49] = (uint8_t)(crc>>8);
+    }
+    return frames;
+}
+
+void BenchFrames(){
+    std::vector<uint8_t> frames = MakeFrames(kFrames);
+    const uint8_t* data = frames.data();
+    Run("crc16", "bytewise", kFrames, kFrameCrcOffset, [&]{
+        uint64_t sum = 0;
+        for(size_t i=0;i<kFrames;i++){
+            sum += Crc16Bytewise(data+i*kFrameLength, kFrameCrcOffset);
+        }
+        sink = sum;
+    });
+    Run("crc16", "slice-by-8", kFrames, kFrameCrcOffset, [&]{
+        uint64_t sum = 0;
+        for(size_t i=0;i<kFrames;i++){
+            sum += Crc16(data+i*kFrameLength, kFrameCrcOffset);
+        }
+        sink = sum;
+    });
+    Run("crc16", "slice-by-8 x4", kFrames, kFrameCrcOffset, [&]{
+        uint64_t sum = 0;
+        for(size_t i=0;i<kFrames;i+=4){
+            const uint8_t* f[4] = {data+i*kFrameLength, data+(i+1)*kFrameLength, data+(i+2)*kFrameLength,
+                                   data+(i+3)*kFrameLength};
+            uint16_t crc[4];
+            Crc16x4(f, kFrameCrcOffset, crc);
+            sum += crc[0]+crc[1]+crc[2]+crc[3];
+        }
+        sink = sum;
+    });
+    ReadingBuffer buffer(kFrames, true);
+    Run("decode", "DecodeFrames", kFrames, kFrameLength, [&]{
+        sink = DecodeFrames(data, kFrames, kFrameLength, buffer.Columns());
+    });
+    std::vector<const uint8_t*> scattered(kFrames);
+    for(size_t i=0;i<kFrames;i++){
+        scattered[i] = data+((i*7919)%kFrames)*kFrameLength;
+    }
+    Run("decode", "DecodeFrames scattered", kFrames, kFrameLength, [&]{
+        sink = DecodeFrames(scattered.data(), kFrames, buffer.Columns());
+    });
+}
+
+void BenchCalibrate(){
+    //A year of minute samples from one node, as a dashboard backfill reads it
+    constexpr size_t kYear = 525600;
+    std::mt19937 random(45);
+    std::vector<uint16_t> raw(kYear*7);
+    for(uint16_t& r : raw){
+        r = (uint16_t)(random() & 0x3FF);
+    }
+    RawColumns in = {raw.data(), raw.data()+kYear, raw.data()+kYear*2, raw.data()+kYear*3, raw.data()+kYear*4,
+                     raw.data()+kYear*5, raw.data()+kYear*6};
+    std::vector<float> cooked(kYear*6);
+    CalibratedColumns out = {cooked.data(), cooked.data()+kYear, cooked.data()+kYear*2, cooked.data()+kYear*3,
+                             cooked.data()+kYear*4, cooked.data()+kYear*5};
+    CalibrationTable table;
+    Run("calibrate", "one node, a year", kYear, 7*2, [&]{
+        CalibrateNode(table.Lookup(0), in, kYear, out);
+        sink = (uint64_t)cooked[kYear-1];
+    });
+    //Decoded frames from many nodes, runs of one row
+    std::vector<uint8_t> frames = MakeFrames(kFrames);
+    ReadingBuffer buffer(kFrames);
+    DecodeFrames(frames.data(), kFrames, kFrameLength, buffer.Columns());
+    for(size_t i=0;i<1000;i++){
+        NodeCalibration node;
+        node.integrationMs = 200.0f;
+        table.Set(buffer.Columns().address[i], node);
+    }
+    std::vector<float> decoded(kFrames*6);
+    CalibratedColumns outFrames = {decoded.data(), decoded.data()+kFrames, decoded.data()+kFrames*2,
+                                   decoded.data()+kFrames*3, decoded.data()+kFrames*4, decoded.data()+kFrames*5};
+    Run("calibrate", "mixed nodes", kFrames, 7*2, [&]{
+        Calibrate(buffer.Columns(), 0, kFrames, table, outFrames);
+        sink = (uint64_t)decoded[kFrames-1];
+    });
+}
+
+void BenchStore(){
+    //A year of minute samples from one node
+    constexpr size_t kYear = 525600;
+    constexpr uint32_t kStart = 1790000000;
+    const uint64_t address = 0x6EDA82333366F5E6ull;
+    std::mt19937 random(46);
+    std::vector<Sample> samples(kYear);
+    uint32_t level = 300;
+    for(size_t i=0;i<kYear;i++){
+        Sample& s = samples[i];
+        s.values[kFieldTime] = kStart+(uint32_t)i*60;
+        s.values[kFieldCount] = (uint32_t)i;
+        level = std::min(1023u, std::max(1u, level+(uint32_t)(random()%9)-4));
+        s.values[kFieldBatt] = 525-(uint32_t)(i/(kYear/20));
+        s.values[kFieldTemp] = 512+(level & 0x1F);
+        s.values[kFieldV1] = 0;
+        s.values[kFieldV2] = 0;
+        for(int field=kFieldUva;field<=kFieldVis;field++){
+            s.values[field] = level*(field-4)/4;
+        }
+        s.values[kFieldFlags] = 0;
+    }
+    char root[] = "/tmp/uvgwbench-XXXXXX";
+    if(!mkdtemp(root)){
+        std::perror("mkdtemp");
+        return;
+    }
+    std::string dir = root;
+    Run("store", "append a year", kYear, sizeof(Sample), [&]{
+        std::system(("rm -rf "+dir+"/*").c_str());
+        StoreWriter writer(dir);
+        for(const Sample& s : samples){
+            writer.Append(address, s);
+        }
+    });
+    size_t bytes = 0;
+    for(int field=0;field<kFields;field++){
+        struct stat st;
+        std::string path = dir+"/6EDA82333366F5E6/"+kFieldNames[field]+".col";
+        bytes += stat(path.c_str(), &st)==0 ? st.st_size : 0;
+    }
+    std::printf("%-10s %-22s %12zu bytes %8.2f bytes/sample (%zu raw)\n", "store", "a year on disk", bytes,
+                (double)bytes/kYear, sizeof(Sample));
+    NodeReader reader;
+    reader.Open(dir, address);
+    ScanColumns out;
+    Run("store", "scan a year, all", kYear, sizeof(Sample), [&]{
+        sink = reader.Scan(0, UINT32_MAX, kAllFields, out);
+    });
+    Run("store", "scan a year, uva", kYear, 2, [&]{
+        sink = reader.Scan(0, UINT32_MAX, 1u<<kFieldUva, out);
+    });
+    uint32_t from = kStart+200*86400;
+    Run("store", "scan a day, uva", 1441, 2, [&]{
+        sink = reader.Scan(from, from+86400, 1u<<kFieldUva, out);
+    });
+    Run("store", "min/max a year, temp", kYear, 2, [&]{
+        uint32_t min, max;
+        reader.MinMax(kFieldTemp, kStart+3600, kStart+360*86400, min, max);
+        sink = min+max;
+    });
+    std::system(("rm -rf "+dir).c_str());
+}
+
+void BenchNodes(){
+    //50000 nodes heard by four receivers, a frame per node per round
+    constexpr uint32_t kNodes = 50000;
+    constexpr uint32_t kRounds = 8;
+    constexpr size_t kTracked = (size_t)kNodes*kRounds*4;
+    Run("nodes", "Track 1 thread", kTracked, 12, [&]{
+        NodeTable table;
+        uint64_t kept = 0;
+        for(uint32_t c=0;c<kRounds;c++){
+            for(int r=0;r<4;r++){
+                for(uint32_t n=0;n<kNodes;n++){
+                    kept += SequenceKeep(table.Track(0x6EDA820000000000ull+(n*7919+r*1013)%kNodes, c, c*67));
+                }
+            }
+        }
+        sink = kept;
+    });
+    Run("nodes", "Track 4 threads", kTracked, 12, [&]{
+        NodeTable table;
+        std::vector<std::thread> threads;
+        for(int r=0;r<4;r++){
+            threads.emplace_back([&table, r]{
+                for(uint32_t c=0;c<kRounds;c++){
+                    for(uint32_t n=0;n<kNodes;n++){
+                        table.Track(0x6EDA820000000000ull+(n*7919+r*1013)%kNodes, c, c*67);
+                    }
+                }
+            });
+        }
+        for(std::thread& thread : threads){
+            thread.join();
+        }
+        sink = table.Totals().received;
+    });
+}
+
+/**
+ * Writes a receiver stream of rounds frames from each of nodes nodes.
+ */
+bool WriteStream(const std::string& path, uint32_t nodes, uint32_t rounds){
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if(!f){
+        std::perror(path.c_str());
+        return false;
+    }
+    std::vector<uint8_t> frames = MakeFrames(nodes);
+    uint8_t encoded[kFrameLength+kReceiverOverhead];
+    for(uint32_t round=0;round<rounds;round++){
+        for(uint32_t n=0;n<nodes;n++){
+            uint8_t* frame = frames.data()+n*kFrameLength;
+            frame[12] = frame[13] = 0;
+            frame[14] = (uint8_t)(round>>8);
+            frame[15] = (uint8_t)round;
+            uint16_t crc = Crc16(frame, kFrameCrcOffset);
+            frame[48] = (uint8_t)crc;
+            frame[49] = (uint8_t)(crc>>8);
+            std::fwrite(encoded, 1, ReceiverEncode(frame, kFrameLength, 0x50, 20, encoded), f);
+        }
+    }
+    std::fclose(f);
+    return true;
+}
+
+void BenchPipeline(){
+    //200000 frames from 10000 nodes for the batch size, and from 100 nodes
+    //with the store (each new node costs 12 file creations, a block of one
+    //of these nodes is 4096 frames)
+    constexpr size_t kStream = 200000;
+    char root[] = "/tmp/uvgwbench-XXXXXX";
+    if(!mkdtemp(root)){
+        std::perror("mkdtemp");
+        return;
+    }
+    std::string dir = root;
+    if(!WriteStream(dir+"/many.bin", 10000, 20) || !WriteStream(dir+"/few.bin", 100, 2000)){
+        return;
+    }
+    for(size_t batch : {1, 16, 64, 256, 0}){
+        bool store = batch==0;
+        PipelineConfig config;
+        config.sources = {dir+(store ? "/few.bin" : "/many.bin")};
+        config.batch = store ? 64 : batch;
+        if(store){
+            config.storeRoot = dir+"/store";
+        }
+        double start = Now();
+        Pipeline pipeline(config);
+        std::string error;
+        if(!pipeline.Start(error)){
+            std::fprintf(stderr, "uvgwbench: %s\n", error.c_str());
+            break;
+        }
+        pipeline.Finish();
+        std::string variant = "batch "+std::to_string(config.batch)+(store ? " + store" : "");
+        Record("pipeline", variant.c_str(), Now()-start, kStream, (double)kStream*(kFrameLength+kReceiverOverhead));
+        std::printf("%-10s %-22s p50 < %llu us, p99 < %llu us\n", "", "latency",
+                    (unsigned long long)pipeline.Stats().LatencyPercentile(0.5),
+                    (unsigned long long)pipeline.Stats().LatencyPercentile(0.99));
+    }
+    std::system(("rm -rf "+dir).c_str());
+}
+
+void BenchLoadgen(){
+    //Simulated node cycles per second, without and with frame building, and
+    //an hour of the simulation heard by two receivers through the pipeline,
+    //in time order as uvreplay merges captures
+    for(uint32_t nodes : {100, 1000, 5000}){
+        LoadConfig config;
+        config.nodes = nodes;
+        config.seconds = 24*3600.0;
+        double start = Now();
+        LoadResult result = RunLoad(config);
+        std::string variant = std::to_string(nodes)+" nodes 24h";
+        Record("loadgen", variant.c_str(), Now()-start, (double)result.cycles, 0);
+    }
+    LoadConfig config;
+    config.nodes = 1000;
+    config.seconds = 3600.0;
+    config.receivers = 2;
+    std::vector<RxFrame> frames;
+    double start = Now();
+    LoadResult result = RunLoad(config, [&](uint32_t receiver, uint64_t timeNs, uint8_t rssi, int8_t snr,
+                                            const uint8_t* f){
+        RxFrame frame;
+        frame.timeNs = timeNs;
+        frame.ingestNs = 0;
+        frame.receiver = (uint16_t)receiver;
+        frame.rssi = rssi;
+        frame.snr = snr;
+        std::memcpy(frame.payload, f, kFrameLength);
+        frames.push_back(frame);
+    });
+    Record("loadgen", "1000 nodes 1h 2 rx frames", Now()-start, (double)result.cycles, 0);
+    std::stable_sort(frames.begin(), frames.end(), [](const RxFrame& a, const RxFrame& b){
+        return a.timeNs<b.timeNs;
+    });
+    PipelineConfig pipe;
+    start = Now();
+    Pipeline pipeline(pipe);
+    std::string error;
+    if(pipeline.Start(error)){
+        for(const RxFrame& frame : frames){
+            pipeline.Submit(frame);
+        }
+        pipeline.Finish();
+        Record("pipeline", "loadgen 2 rx", Now()-start, (double)result.receptions,
+               (double)result.receptions*sizeof(RxFrame));
+        std::printf("%-10s %-22s %llu of %llu stored, %llu delivered\n", "", "dedup",
+                    (unsigned long long)pipeline.Stats().store.items, (unsigned long long)result.receptions,
+                    (unsigned long long)result.received);
+    }
+}
+
+void BenchCapture(){
+    //A day of 1000 nodes heard by two receivers, written, seeked and
+    //replayed as fast as possible on its own and into the pipeline
+    char root[] = "/tmp/uvgwbench-XXXXXX";
+    if(!mkdtemp(root)){
+        std::perror("mkdtemp");
+        return;
+    }
+    std::string dir = root;
+    std::string path = dir+"/day.uvcap";
+    LoadConfig load;
+    load.nodes = 1000;
+    load.seconds = 24*3600.0;
+    load.receivers = 2;
+    std::vector<RxFrame> frames;
+    RunLoad(load, [&](uint32_t receiver, uint64_t timeNs, uint8_t rssi, int8_t snr, const uint8_t* f){
+        RxFrame frame;
+        frame.timeNs = timeNs;
+        frame.ingestNs = 0;
+        frame.receiver = (uint16_t)receiver;
+        frame.rssi = rssi;
+        frame.snr = snr;
+        std::memcpy(frame.payload, f, kFrameLength);
+        frames.push_back(frame);
+    });
+    CaptureWriter writer;
+    std::string error;
+    double start = Now();
+    if(!writer.Open(path, error)){
+        std::fprintf(stderr, "uvgwbench: %s\n", error.c_str());
+        return;
+    }
+    for(const RxFrame& frame : frames){
+        writer.Append(frame);
+    }
+    writer.Close();
+    Record("capture", "write", Now()-start, (double)frames.size(), (double)frames.size()*sizeof(CaptureRecord));
+
+    CaptureReader reader;
+    if(!reader.Open(path, error)){
+        std::fprintf(stderr, "uvgwbench: %s\n", error.c_str());
+        return;
+    }
+    constexpr size_t kSeeks = 100000;
+    std::mt19937_64 random(50);
+    uint64_t first = reader.Record(0).timeNs;
+    uint64_t span = reader.Record(reader.Records()-1).timeNs-first;
+    size_t sum = 0;
+    start = Now();
+    for(size_t i=0;i<kSeeks;i++){
+        sum += reader.Seek(first+random()%span);
+    }
+    Record("capture", "seek", Now()-start, kSeeks, 0);
+    sink = sum;
+    ReplayConfig replay;
+    replay.speed = 0;
+    uint64_t check = 0;
+    start = Now();
+    uint64_t replayed = ReplayCaptures({&reader}, replay, [&](const RxFrame& f){ check += f.payload[20]; });
+    Record("replay", "mmap", Now()-start, (double)replayed, (double)replayed*sizeof(CaptureRecord));
+    sink = check;
+    PipelineConfig config;
+    start = Now();
+    Pipeline pipeline(config);
+    if(pipeline.Start(error)){
+        replayed = ReplayCaptures({&reader}, replay, [&](const RxFrame& f){ pipeline.Submit(f); });
+        pipeline.Finish();
+        Record("replay", "into pipeline", Now()-start, (double)replayed, (double)replayed*sizeof(CaptureRecord));
+    }
+    std::system(("rm -rf "+dir).c_str());
+}
+
+} // namespace
+
+int main(int argc, char** argv){
+    int option;
+    while((option = getopt(argc, argv, "r:"))!=-1){
+        if(option!='r'){
+            std::fprintf(stderr, "usage: uvgwbench [-r results.csv]\n");
+            return 2;
+        }
+        bool header = access(optarg, F_OK)!=0;
+        results = std::fopen(optarg, "a");
+        if(results && header){
+            std::fprintf(results, "date,revision,benchmark,variant,per_second,mb_per_second,ns_per_item\n");
+        }
+    }
+    BenchFrames();
+    BenchCalibrate();
+    BenchStore();
+    BenchNodes();
+    BenchPipeline();
+    BenchLoadgen();
+    BenchCapture();
+    if(results){
+        std::fclose(results);
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+/**
+ * calibrate.cpp
+ * Raw counts to engineering units, see calibrate.h.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include "calibrate.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace gateway {
+
+namespace {
+
+constexpr float kKelvin25 = 298.15f;
+constexpr float kKelvin0 = 273.15f;
+constexpr size_t kChunk = 256;  //Rows of temporaries kept on the stack
+
+CalibrationTable::Prepared Prepare(const NodeCalibration& c){
+    CalibrationTable::Prepared p;
+    p.uvaA = c.uvaA;
+    p.uvaB = c.uvaB;
+    p.uvbC = c.uvbC;
+    p.uvbD = c.uvbD;
+    p.countScale = 100.0f/c.integrationMs*(c.highDynamic ? 2.0f : 1.0f);
+    p.uvaUvi = c.uvaUviPerCount*0.5f; //UVI is the mean of the UVA and UVB indices
+    p.uvbUvi = c.uvbUviPerCount*0.5f;
+    p.uvaUw = 1.0f/c.uvaCountsPerUw;
+    p.uvbUw = 1.0f/c.uvbCountsPerUw;
+    bool mode2 = (c.bhMode & 0x03)==0x01; //H-resolution mode 2, half lux steps
+    p.luxPerCount = 1.0f/c.bhCountsPerLux*69.0f/c.mtreg/(mode2 ? 2.0f : 1.0f);
+    p.adcFull = std::ldexp(1023.0f, c.adcBits-10);  //Oversampled 10-bit conversions, not 2^adcBits-1
+    p.voltsPerCount = c.adcReference/p.adcFull/c.batteryDivider;
+    p.seriesR = c.seriesR;
+    p.ntcR25 = c.ntcR25;
+    p.ntcBeta = c.ntcBeta;
+    p.ntcLowSide = c.ntcLowSide;
+    p.shA = c.steinhartA;
+    p.shB = c.steinhartB;
+    p.shC = c.steinhartC;
+    return p;
+}
+
+void CalibrateChunk(const CalibrationTable::Prepared& p, const RawColumns& in, size_t n, const CalibratedColumns& out){
+    float uvaCalc[kChunk];
+    float uvbCalc[kChunk];
+    for(size_t i=0;i<n;i++){
+        float c1 = in.comp1[i]*p.countScale;
+        float c2 = in.comp2[i]*p.countScale;
+        uvaCalc[i] = std::max(0.0f, in.uva[i]*p.countScale-p.uvaA*c1-p.uvaB*c2);
+        uvbCalc[i] = std::max(0.0f, in.uvb[i]*p.countScale-p.uvbC*c1-p.uvbD*c2);
+    }
+    for(size_t i=0;i<n;i++){
+        out.uva[i] = uvaCalc[i]*p.uvaUw;
+        out.uvb[i] = uvbCalc[i]*p.uvbUw;
+        out.uvIndex[i] = uvaCalc[i]*p.uvaUvi+uvbCalc[i]*p.uvbUvi;
+        out.lux[i] = in.vis[i]*p.luxPerCount;
+        out.battery[i] = in.batt[i]*p.voltsPerCount;
+    }
+    //NTC resistance, then its log (the only call that may not vectorise)
+    float logR[kChunk];
+    for(size_t i=0;i<n;i++){
+        float ratio = std::min(std::max((float)in.temp[i], 1.0f), p.adcFull-1.0f)/p.adcFull;
+        float r = p.ntcLowSide ? p.seriesR*ratio/(1.0f-ratio) : p.seriesR*(1.0f-ratio)/ratio;
+        logR[i] = r;
+    }
+    for(size_t i=0;i<n;i++){
+        logR[i] = std::log(logR[i]);
+    }
+    if(p.shA!=0.0f){
+        for(size_t i=0;i<n;i++){
+            out.temperature[i] = 1.0f/(p.shA+p.shB*logR[i]+p.shC*logR[i]*logR[i]*logR[i])-kKelvin0;
+        }
+    }
+    else{
+        float logR25 = std::log(p.ntcR25);
+        float inverseBeta = 1.0f/p.ntcBeta;
+        for(size_t i=0;i<n;i++){
+            out.temperature[i] = 1.0f/(1.0f/kKelvin25+(logR[i]-logR25)*inverseBeta)-kKelvin0;
+        }
+    }
+}
+
+} // namespace
+
+CalibrationTable::CalibrationTable(){
+    nodes_.push_back(NodeCalibration());
+    prepared_.push_back(Prepare(nodes_[0]));
+}
+
+void CalibrationTable::SetDefault(const NodeCalibration& calibration){
+    nodes_[0] = calibration;
+    prepared_[0] = Prepare(calibration);
+}
+
+void CalibrationTable::Set(uint64_t address, const NodeCalibration& calibration){
+    auto found = index_.find(address);
+    if(found!=index_.end()){
+        nodes_[found->second] = calibration;
+        prepared_[found->second] = Prepare(calibration);
+        return;
+    }
+    index_[address] = nodes_.size();
+    nodes_.push_back(calibration);
+    prepared_.push_back(Prepare(calibration));
+}
+
+const NodeCalibration& CalibrationTable::Get(uint64_t address) const{
+    auto found = index_.find(address);
+    return nodes_[found==index_.end() ? 0 : found->second];
+}
+
+const CalibrationTable::Prepared& CalibrationTable::Lookup(uint64_t address) const{
+    auto found = index_.find(address);
+    return prepared_[found==index_.end() ? 0 : found->second];
+}
+
+void CalibrateNode(const CalibrationTable::Prepared& p, const RawColumns& in, size_t n, const CalibratedColumns& out){
+    for(size_t done=0;done<n;done+=kChunk){
+        size_t k = std::min(kChunk, n-done);
+        RawColumns r = {in.uva+done, in.uvb+done, in.comp1+done, in.comp2+done, in.vis+done, in.batt+done,
+                        in.temp+done};
+        CalibratedColumns o = {out.uva+done, out.uvb+done, out.uvIndex+done, out.lux+done, out.battery+done,
+                               out.temperature+done};
+        CalibrateChunk(p, r, k, o);
+    }
+}
+
+void Calibrate(const ReadingColumns& in, size_t first, size_t count, const CalibrationTable& table,
+               const CalibratedColumns& out){
+    size_t end = first+count;
+    size_t run = first;
+    while(run<end){
+        size_t next = run+1;
+        while(next<end && in.address[next]==in.address[run]){
+            next++;
+        }
+        RawColumns r = {in.uva+run, in.uvb+run, in.comp1+run, in.comp2+run, in.vis+run, in.batt+run, in.temp+run};
+        CalibratedColumns o = {out.uva+run, out.uvb+run, out.uvIndex+run, out.lux+run, out.battery+run,
+                               out.temperature+run};
+        CalibrateNode(table.Lookup(in.address[run]), r, next-run, o);
+        run = next;
+    }
+}
+
+} // namespace gateway
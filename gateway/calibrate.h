@@ -0,0 +1,130 @@
+/*
+ * File:   calibrate.h
+ * Author: Andy Page
+ * Comments: Turns decoded raw counts into engineering units.  The sensor
+ *           sends its readings uncalibrated (see README), the defaults here
+ *           match the firmware: VEML6075 at 100ms with normal dynamic range,
+ *           BH1750 continuous H-resolution with MTreg 69, battery on AN0
+ *           through a 1/4 divider against the 1.024V FVR, and the NTC
+ *           divider (10k B3950 and 10k) ratiometric to Vdd.
+ *
+ *           Rows are calibrated in runs of the same node so each run is a
+ *           set of straight loops over the columns with the node's
+ *           constants held in registers, which the compiler vectorises.
+ * Revision history: 1, 19th October 2026
+ */
+
+#ifndef INC_GATEWAY_CALIBRATE_H
+#define INC_GATEWAY_CALIBRATE_H
+
+#include "frame.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace gateway {
+
+/**
+ * Per node calibration.  VEML6075 coefficients are Vishay's open air values
+ * (application note 84339), override them for a diffuser or window.
+ */
+struct NodeCalibration {
+    //VEML6075
+    float uvaA = 2.22f;             //UVA visible compensation (COMP1)
+    float uvaB = 1.33f;             //UVA IR compensation (COMP2)
+    float uvbC = 2.95f;             //UVB visible compensation
+    float uvbD = 1.74f;             //UVB IR compensation
+    float uvaUviPerCount = 0.001461f;   //UV index responsivity at 100ms
+    float uvbUviPerCount = 0.002591f;
+    float uvaCountsPerUw = 0.93f;   //Counts per uW/cm2 at 100ms
+    float uvbCountsPerUw = 2.1f;
+    float integrationMs = 100.0f;   //UV_IT
+    bool highDynamic = false;       //UV_HD, halves the sensitivity
+    //BH1750
+    uint8_t bhMode = 0x10;          //BH1750_CONT_HRES_MODE etc.
+    uint8_t mtreg = 69;
+    float bhCountsPerLux = 1.2f;
+    //Battery and temperature
+    uint8_t adcBits = 10;           //ADCRead() result, 10+ADC_EXTRA_BITS (adc.h)
+    float adcReference = 1.024f;    //FVR BUF2
+    float batteryDivider = 0.25f;   //AN0 volts per battery volt
+    //Temperature
+    float ntcR25 = 10000.0f;
+    float ntcBeta = 3950.0f;
+    float seriesR = 10000.0f;       //R14
+    bool ntcLowSide = false;        //NTC from AN1 to ground instead of from Vdd
+    float steinhartA = 0.0f;        //Steinhart-Hart used instead of Beta if A is not 0
+    float steinhartB = 0.0f;
+    float steinhartC = 0.0f;
+};
+
+/**
+ * Output columns, each with room for the rows being calibrated.
+ */
+struct CalibratedColumns {
+    float* uva;             //uW/cm2, compensated
+    float* uvb;
+    float* uvIndex;
+    float* lux;
+    float* battery;         //Volts
+    float* temperature;     //Celsius
+};
+
+/**
+ * Raw inputs for one node, as from the store (n rows each).
+ */
+struct RawColumns {
+    const uint16_t* uva;
+    const uint16_t* uvb;
+    const uint16_t* comp1;
+    const uint16_t* comp2;
+    const uint16_t* vis;
+    const uint16_t* batt;
+    const uint16_t* temp;
+};
+
+class CalibrationTable {
+public:
+    CalibrationTable();
+    void SetDefault(const NodeCalibration& calibration);
+    void Set(uint64_t address, const NodeCalibration& calibration);
+    const NodeCalibration& Get(uint64_t address) const;
+
+    //Constants worked out from a NodeCalibration once, used by the kernels
+    struct Prepared {
+        float uvaA, uvaB, uvbC, uvbD;
+        float countScale;       //To counts at 100ms, normal dynamic range
+        float uvaUvi, uvbUvi;
+        float uvaUw, uvbUw;     //uW/cm2 per count
+        float luxPerCount;
+        float voltsPerCount;
+        float adcFull;          //Full scale ADC reading
+        float seriesR, ntcR25, ntcBeta;
+        bool ntcLowSide;
+        float shA, shB, shC;
+    };
+    const Prepared& Lookup(uint64_t address) const;
+
+private:
+    std::vector<NodeCalibration> nodes_;
+    std::vector<Prepared> prepared_;
+    std::unordered_map<uint64_t, size_t> index_;
+};
+
+/**
+ * Calibrates n rows of one node.
+ */
+void CalibrateNode(const CalibrationTable::Prepared& p, const RawColumns& in, size_t n, const CalibratedColumns& out);
+
+/**
+ * Calibrates rows first to first+count-1 of decoded frames into the same
+ * rows of out.  Rows are grouped into runs of the same address.
+ */
+void Calibrate(const ReadingColumns& in, size_t first, size_t count, const CalibrationTable& table,
+               const CalibratedColumns& out);
+
+} // namespace gateway
+
+#endif /* INC_GATEWAY_CALIBRATE_H */
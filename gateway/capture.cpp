@@ -0,0 +1,354 @@
+/**
+ * capture.cpp
+ * Capture files and replay, see capture.h.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include "capture.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+namespace gateway {
+
+namespace {
+
+constexpr char kMagic[8] = {'U', 'V', 'C', 'A', 'P', 'T', '0', '1'};
+constexpr char kIndexMagic[8] = {'U', 'V', 'C', 'A', 'P', 'I', '0', '1'};
+
+static_assert(sizeof(CaptureIndexEntry)==16, "index entries are stored as is");
+
+bool WriteAll(int fd, const void* data, size_t length){
+    const uint8_t* p = (const uint8_t*)data;
+    while(length){
+        ssize_t done = write(fd, p, length);
+        if(done<0){
+            if(errno==EINTR){
+                continue;
+            }
+            return false;
+        }
+        p += done;
+        length -= done;
+    }
+    return true;
+}
+
+void WriteHeader(int fd, const char* magic){
+    uint32_t header[4];
+    std::memcpy(header, magic, 8);
+    header[2] = sizeof(CaptureRecord);
+    header[3] = kCaptureIndexRecords;
+    WriteAll(fd, header, sizeof header);
+}
+
+bool ValidHeader(const uint8_t* header, const char* magic){
+    uint32_t sizes[2];
+    std::memcpy(sizes, header+8, sizeof sizes);
+    return std::memcmp(header, magic, 8)==0 && sizes[0]==sizeof(CaptureRecord) && sizes[1]==kCaptureIndexRecords;
+}
+
+CaptureIndexEntry Range(const CaptureRecord* r, size_t n){
+    CaptureIndexEntry e = {r[0].timeNs, r[0].timeNs};
+    for(size_t i=1;i<n;i++){
+        e.minNs = std::min(e.minNs, r[i].timeNs);
+        e.maxNs = std::max(e.maxNs, r[i].timeNs);
+    }
+    return e;
+}
+
+/**
+ * Index entries read from path.idx, at most blocks of them.
+ */
+std::vector<CaptureIndexEntry> ReadIndex(int fd, size_t blocks){
+    std::vector<CaptureIndexEntry> entries;
+    struct stat s;
+    uint8_t header[kCaptureHeader];
+    if(fstat(fd, &s)!=0 || s.st_size<(off_t)kCaptureHeader || pread(fd, header, sizeof header, 0)!=sizeof header ||
+       !ValidHeader(header, kIndexMagic)){
+        return entries;
+    }
+    entries.resize(std::min(blocks, (size_t)(s.st_size-kCaptureHeader)/sizeof(CaptureIndexEntry)));
+    size_t bytes = entries.size()*sizeof(CaptureIndexEntry);
+    if(pread(fd, entries.data(), bytes, kCaptureHeader)!=(ssize_t)bytes){
+        entries.clear();
+    }
+    return entries;
+}
+
+std::string IndexPath(const std::string& path){
+    return path+".idx";
+}
+
+} // namespace
+
+CaptureWriter::~CaptureWriter(){
+    Close();
+}
+
+bool CaptureWriter::Open(const std::string& path, std::string& error){
+    Close();
+    fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    struct stat s;
+    if(fd_<0 || fstat(fd_, &s)!=0){
+        error = path+": "+std::strerror(errno);
+        Close();
+        return false;
+    }
+    uint8_t header[kCaptureHeader];
+    if(s.st_size<(off_t)kCaptureHeader){
+        //New, or torn before the first record
+        if(ftruncate(fd_, 0)!=0){
+            error = path+": "+std::strerror(errno);
+            Close();
+            return false;
+        }
+        WriteHeader(fd_, kMagic);
+        s.st_size = kCaptureHeader;
+    }
+    else if(pread(fd_, header, sizeof header, 0)!=sizeof header || !ValidHeader(header, kMagic)){
+        error = path+": not a capture";
+        Close();
+        return false;
+    }
+    records_ = (s.st_size-kCaptureHeader)/sizeof(CaptureRecord);
+    off_t end = kCaptureHeader+records_*sizeof(CaptureRecord);
+    if(s.st_size!=end && ftruncate(fd_, end)!=0){
+        error = path+": "+std::strerror(errno);
+        Close();
+        return false;
+    }
+
+    //Keep the index entries of the complete blocks and build the missing ones
+    indexFd_ = open(IndexPath(path).c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if(indexFd_<0){
+        error = IndexPath(path)+": "+std::strerror(errno);
+        Close();
+        return false;
+    }
+    size_t blocks = records_/kCaptureIndexRecords;
+    std::vector<CaptureIndexEntry> entries = ReadIndex(indexFd_, blocks);
+    if(entries.empty()){
+        if(ftruncate(indexFd_, 0)==0){
+            WriteHeader(indexFd_, kIndexMagic);
+        }
+    }
+    else if(ftruncate(indexFd_, kCaptureHeader+entries.size()*sizeof(CaptureIndexEntry))!=0){
+        error = IndexPath(path)+": "+std::strerror(errno);
+        Close();
+        return false;
+    }
+    std::vector<CaptureRecord> block(kCaptureIndexRecords);
+    for(size_t k=entries.size();k<=blocks;k++){
+        size_t n = std::min(kCaptureIndexRecords, (size_t)records_-k*kCaptureIndexRecords);
+        size_t bytes = n*sizeof(CaptureRecord);
+        if(n && pread(fd_, block.data(), bytes, kCaptureHeader+k*kCaptureIndexRecords*sizeof(CaptureRecord))!=
+                (ssize_t)bytes){
+            error = path+": "+std::strerror(errno);
+            Close();
+            return false;
+        }
+        blockRecords_ = n;
+        if(n){
+            block_ = Range(block.data(), n);
+        }
+        if(k<blocks && !WriteIndex()){
+            error = IndexPath(path)+": "+std::strerror(errno);
+            Close();
+            return false;
+        }
+    }
+    pending_.reserve(kCaptureIndexRecords);
+    return true;
+}
+
+bool CaptureWriter::WriteIndex(){
+    blockRecords_ = 0;
+    return WriteAll(indexFd_, &block_, sizeof block_);
+}
+
+bool CaptureWriter::Append(const RxFrame& frame){
+    CaptureRecord r;
+    r.timeNs = frame.timeNs;
+    r.receiver = frame.receiver;
+    r.rssi = frame.rssi;
+    r.snr = frame.snr;
+    r.length = kFrameLength;
+    r.flags = 0;
+    std::memcpy(r.payload, frame.payload, kFrameLength);
+    pending_.push_back(r);
+    if(blockRecords_==0){
+        block_ = {r.timeNs, r.timeNs};
+    }
+    block_.minNs = std::min(block_.minNs, r.timeNs);
+    block_.maxNs = std::max(block_.maxNs, r.timeNs);
+    if(++blockRecords_<kCaptureIndexRecords){
+        return true;
+    }
+    return Flush();
+}
+
+bool CaptureWriter::Flush(){
+    if(fd_<0){
+        return false;
+    }
+    //Records before the index entry that covers them
+    bool ok = WriteAll(fd_, pending_.data(), pending_.size()*sizeof(CaptureRecord));
+    records_ += pending_.size();
+    pending_.clear();
+    if(blockRecords_==kCaptureIndexRecords){
+        ok &= WriteIndex();
+    }
+    return ok;
+}
+
+bool CaptureWriter::Close(){
+    bool ok = true;
+    if(fd_>=0){
+        ok = Flush();
+        ok &= close(fd_)==0;
+    }
+    if(indexFd_>=0){
+        close(indexFd_);
+    }
+    fd_ = indexFd_ = -1;
+    records_ = 0;
+    blockRecords_ = 0;
+    return ok;
+}
+
+CaptureReader::~CaptureReader(){
+    if(map_){
+        munmap((void*)map_, length_);
+    }
+}
+
+bool CaptureReader::Open(const std::string& path, std::string& error){
+    int fd = open(path.c_str(), O_RDONLY);
+    struct stat s;
+    if(fd<0 || fstat(fd, &s)!=0){
+        error = path+": "+std::strerror(errno);
+        if(fd>=0){
+            close(fd);
+        }
+        return false;
+    }
+    void* map = s.st_size>=(off_t)kCaptureHeader ? mmap(nullptr, s.st_size, PROT_READ, MAP_SHARED, fd, 0)
+                                                  : MAP_FAILED;
+    close(fd);
+    if(map==MAP_FAILED || !ValidHeader((const uint8_t*)map, kMagic)){
+        if(map!=MAP_FAILED){
+            munmap(map, s.st_size);
+        }
+        error = path+": not a capture";
+        return false;
+    }
+    if(map_){
+        munmap((void*)map_, length_);
+    }
+    map_ = (const uint8_t*)map;
+    length_ = s.st_size;
+    records_ = (length_-kCaptureHeader)/sizeof(CaptureRecord);
+    madvise(map, length_, MADV_SEQUENTIAL);
+
+    size_t blocks = records_/kCaptureIndexRecords;
+    index_.clear();
+    int indexFd = open(IndexPath(path).c_str(), O_RDONLY);
+    if(indexFd>=0){
+        index_ = ReadIndex(indexFd, blocks);
+        close(indexFd);
+    }
+    indexed_ = index_.size();
+    for(size_t k=index_.size();k*kCaptureIndexRecords<records_;k++){
+        size_t first = k*kCaptureIndexRecords;
+        index_.push_back(Range(Base()+first, std::min(kCaptureIndexRecords, records_-first)));
+    }
+    reach_.resize(index_.size());
+    for(size_t k=0;k<index_.size();k++){
+        reach_[k] = k ? std::max(reach_[k-1], index_[k].maxNs) : index_[k].maxNs;
+    }
+    return true;
+}
+
+void CaptureReader::Frame(size_t i, RxFrame& out) const{
+    const CaptureRecord& r = Base()[i];
+    out.timeNs = r.timeNs;
+    out.ingestNs = 0;
+    out.receiver = r.receiver;
+    out.rssi = r.rssi;
+    out.snr = r.snr;
+    std::memcpy(out.payload, r.payload, kFrameLength);
+}
+
+size_t CaptureReader::Seek(uint64_t timeNs) const{
+    size_t k = std::lower_bound(reach_.begin(), reach_.end(), timeNs)-reach_.begin();
+    if(k==reach_.size()){
+        return records_;
+    }
+    //Block k is the first holding a record at or after timeNs
+    const CaptureRecord* r = Base();
+    size_t i = k*kCaptureIndexRecords;
+    while(i<records_ && r[i].timeNs<timeNs){
+        i++;
+    }
+    return i;
+}
+
+uint64_t ReplayCaptures(const std::vector<const CaptureReader*>& captures, const ReplayConfig& config,
+                        const std::function<void(const RxFrame&)>& sink, const std::atomic<bool>* stop){
+    std::vector<size_t> next;
+    for(const CaptureReader* c : captures){
+        next.push_back(c->Seek(config.fromNs));
+    }
+    uint64_t replayed = 0;
+    uint64_t firstNs = 0;
+    std::chrono::steady_clock::time_point start;
+    RxFrame frame;
+    while(!stop || !stop->load(std::memory_order_relaxed)){
+        //The capture with the earliest next record
+        size_t best = captures.size();
+        for(size_t c=0;c<captures.size();c++){
+            if(next[c]<captures[c]->Records() &&
+               (best==captures.size() ||
+                captures[c]->Record(next[c]).timeNs<captures[best]->Record(next[best]).timeNs)){
+                best = c;
+            }
+        }
+        if(best==captures.size()){
+            break;
+        }
+        size_t i = next[best]++;
+        uint64_t timeNs = captures[best]->Record(i).timeNs;
+        if(timeNs<config.fromNs){
+            continue;   //Before a clock step
+        }
+        if(timeNs>config.toNs){
+            next[best] = captures[best]->Records();
+            continue;
+        }
+        if(!replayed){
+            firstNs = timeNs;
+            start = std::chrono::steady_clock::now();
+        }
+        else if(config.speed>0 && timeNs>firstNs){
+            auto due = start+std::chrono::nanoseconds((uint64_t)((timeNs-firstNs)/config.speed));
+            if(std::chrono::steady_clock::now()<due){
+                std::this_thread::sleep_until(due);
+            }
+        }
+        captures[best]->Frame(i, frame);
+        sink(frame);
+        replayed++;
+    }
+    return replayed;
+}
+
+} // namespace gateway
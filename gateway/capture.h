@@ -0,0 +1,164 @@
+/*
+ * File:   capture.h
+ * Author: Andy Page
+ * Comments: Recorded radio traffic, to reproduce gateway problems and to
+ *           benchmark with real packets and no radio.  A capture is a 16
+ *           byte header then fixed size records, one per packet as it
+ *           entered the gateway:
+ *
+ *           timeNs     Unix time heard, ns
+ *           receiver   Index of the receiver (source) that heard it
+ *           RSSI, SNR  As the receiver reported them
+ *           payload    The 50 byte v5 frame, good CRC or not
+ *
+ *           Beside it, path.idx holds the smallest and largest time of
+ *           each complete block of kCaptureIndexRecords records, so a seek
+ *           to a time reads a few kilobytes of index and one block.  Both
+ *           files are only appended to.  A record torn by a crash is cut
+ *           off when the capture is next opened for writing, and index
+ *           entries missing from path.idx (or the whole file) are rebuilt
+ *           from the records.  Values are little endian, as the hosts the
+ *           gateway runs on.
+ * Revision history: 1, 19th October 2026
+ */
+
+#ifndef INC_GATEWAY_CAPTURE_H
+#define INC_GATEWAY_CAPTURE_H
+
+#include "receiver.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace gateway {
+
+constexpr size_t kCaptureHeader = 16;
+constexpr size_t kCaptureIndexRecords = 1024;
+
+/**
+ * One packet, as stored.
+ */
+struct CaptureRecord {
+    uint64_t timeNs;
+    uint16_t receiver;
+    uint8_t rssi;
+    int8_t snr;
+    uint8_t length;         //kFrameLength
+    uint8_t flags;          //0
+    uint8_t payload[kFrameLength];
+};
+static_assert(sizeof(CaptureRecord)==64, "records are stored as is");
+
+/**
+ * Time range of one block of records, as stored in the index.
+ */
+struct CaptureIndexEntry {
+    uint64_t minNs;
+    uint64_t maxNs;
+};
+
+/**
+ * Appends packets to a capture.  Records are kept in memory until a block
+ * of kCaptureIndexRecords is complete or Flush(), then written with its
+ * index entry.  Not thread safe.
+ */
+class CaptureWriter {
+public:
+    CaptureWriter() = default;
+    ~CaptureWriter();
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    /**
+     * Creates the capture or opens it to append, cutting off a torn record
+     * and completing the index.
+     * @return false with error set
+     */
+    bool Open(const std::string& path, std::string& error);
+
+    /**
+     * @return false if a block could not be written (errno is set)
+     */
+    bool Append(const RxFrame& frame);
+
+    //Writes the pending records
+    bool Flush();
+    bool Close();
+
+    uint64_t Records() const { return records_+pending_.size(); }
+
+private:
+    bool WriteIndex();
+
+    int fd_ = -1;
+    int indexFd_ = -1;
+    uint64_t records_ = 0;              //Written to the file
+    std::vector<CaptureRecord> pending_;
+    CaptureIndexEntry block_ = {};      //Of the records in the last block so far
+    size_t blockRecords_ = 0;
+};
+
+/**
+ * Read only, mapped view of a capture as it was when opened.
+ */
+class CaptureReader {
+public:
+    CaptureReader() = default;
+    ~CaptureReader();
+    CaptureReader(const CaptureReader&) = delete;
+    CaptureReader& operator=(const CaptureReader&) = delete;
+
+    /**
+     * Maps the capture and reads its index, building the entries the index
+     * file lacks.
+     * @return false with error set
+     */
+    bool Open(const std::string& path, std::string& error);
+
+    size_t Records() const { return records_; }
+    const CaptureRecord& Record(size_t i) const { return Base()[i]; }
+    void Frame(size_t i, RxFrame& out) const;
+
+    /**
+     * First record heard at or after timeNs, or Records().  Times are in
+     * order unless the clock stepped back; then this is the first record
+     * reaching timeNs in a block whose range reaches it.
+     */
+    size_t Seek(uint64_t timeNs) const;
+
+    //Index entries read from path.idx rather than built
+    size_t IndexedBlocks() const { return indexed_; }
+
+private:
+    const CaptureRecord* Base() const { return (const CaptureRecord*)(map_+kCaptureHeader); }
+
+    const uint8_t* map_ = nullptr;
+    size_t length_ = 0;
+    size_t records_ = 0;
+    std::vector<CaptureIndexEntry> index_;  //Complete blocks and the last, partial one
+    std::vector<uint64_t> reach_;           //Largest time up to the end of each block
+    size_t indexed_ = 0;
+};
+
+struct ReplayConfig {
+    double speed = 1.0;                 //Times the original speed, 0 for as fast as possible
+    uint64_t fromNs = 0;                //Time range to replay
+    uint64_t toNs = UINT64_MAX;
+};
+
+/**
+ * Feeds the records of captures in time order (merged, each capture in its
+ * own order) to sink, paced at config.speed from the first record.
+ * stop is checked between records and may be null.
+ * @return Records replayed
+ */
+uint64_t ReplayCaptures(const std::vector<const CaptureReader*>& captures, const ReplayConfig& config,
+                        const std::function<void(const RxFrame&)>& sink, const std::atomic<bool>* stop = nullptr);
+
+} // namespace gateway
+
+#endif /* INC_GATEWAY_CAPTURE_H */
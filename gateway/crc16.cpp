@@ -0,0 +1,80 @@
+/**
+ * crc16.cpp
+ * Slice-by-8 CRC-16/MODBUS, see crc16.h.  The tables are built at compile
+ * time, table[k][i] is the CRC of byte i followed by k zero bytes.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include "crc16.h"
+
+#include <array>
+
+namespace gateway {
+
+namespace {
+
+using Tables = std::array<std::array<uint16_t, 256>, 8>;
+
+constexpr Tables MakeTables(){
+    Tables t{};
+    for(unsigned i=0;i<256;i++){
+        uint16_t crc = (uint16_t)i;
+        for(int bit=0;bit<8;bit++){
+            crc = (crc & 1) ? (uint16_t)((crc>>1)^0xA001) : (uint16_t)(crc>>1);
+        }
+        t[0][i] = crc;
+    }
+    for(unsigned k=1;k<8;k++){
+        for(unsigned i=0;i<256;i++){
+            t[k][i] = (uint16_t)((t[k-1][i]>>8) ^ t[0][t[k-1][i] & 0xFF]);
+        }
+    }
+    return t;
+}
+
+constexpr Tables kTables = MakeTables();
+
+inline uint16_t Slice8(uint16_t crc, const uint8_t* p){
+    return kTables[7][(p[0]^crc) & 0xFF] ^ kTables[6][(p[1]^(crc>>8)) & 0xFF] ^
+           kTables[5][p[2]] ^ kTables[4][p[3]] ^ kTables[3][p[4]] ^
+           kTables[2][p[5]] ^ kTables[1][p[6]] ^ kTables[0][p[7]];
+}
+
+inline uint16_t Tail(uint16_t crc, const uint8_t* p, size_t length){
+    while(length--){
+        crc = (uint16_t)((crc>>8) ^ kTables[0][(crc^*p++) & 0xFF]);
+    }
+    return crc;
+}
+
+} // namespace
+
+uint16_t Crc16Bytewise(const uint8_t* data, size_t length){
+    return Tail(0xFFFF, data, length);
+}
+
+uint16_t Crc16(const uint8_t* data, size_t length){
+    uint16_t crc = 0xFFFF;
+    for(;length>=8;length-=8,data+=8){
+        crc = Slice8(crc, data);
+    }
+    return Tail(crc, data, length);
+}
+
+void Crc16x4(const uint8_t* const data[4], size_t length, uint16_t crc[4]){
+    uint16_t c0 = 0xFFFF, c1 = 0xFFFF, c2 = 0xFFFF, c3 = 0xFFFF;
+    size_t i = 0;
+    for(;i+8<=length;i+=8){
+        c0 = Slice8(c0, data[0]+i);
+        c1 = Slice8(c1, data[1]+i);
+        c2 = Slice8(c2, data[2]+i);
+        c3 = Slice8(c3, data[3]+i);
+    }
+    crc[0] = Tail(c0, data[0]+i, length-i);
+    crc[1] = Tail(c1, data[1]+i, length-i);
+    crc[2] = Tail(c2, data[2]+i, length-i);
+    crc[3] = Tail(c3, data[3]+i, length-i);
+}
+
+} // namespace gateway
@@ -0,0 +1,26 @@
+/*
+ * File:   crc16.h
+ * Author: Andy Page
+ * Comments: CRC-16/MODBUS (poly 0xA001 reflected, init 0xFFFF) as used by
+ *           CRC16.c in the sensor firmware.  Crc16Bytewise() is the same
+ *           one table loop as the PIC, Crc16() is slice-by-8 and
+ *           Crc16x4() runs four independent messages through slice-by-8
+ *           together so their table lookups overlap.
+ * Revision history: 1, 19th October 2026
+ */
+
+#ifndef INC_GATEWAY_CRC16_H
+#define INC_GATEWAY_CRC16_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gateway {
+
+uint16_t Crc16Bytewise(const uint8_t* data, size_t length);
+uint16_t Crc16(const uint8_t* data, size_t length);
+void Crc16x4(const uint8_t* const data[4], size_t length, uint16_t crc[4]);
+
+} // namespace gateway
+
+#endif /* INC_GATEWAY_CRC16_H */
@@ -0,0 +1,191 @@
+/**
+ * frame.cpp
+ * v5 packet decoder, see frame.h.  CRCs are checked four frames at a time
+ * with Crc16x4(), then the fields are unpacked row by row into the columns.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include "frame.h"
+#include "crc16.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace gateway {
+
+namespace {
+
+inline uint16_t Word(const uint8_t* p){
+    return (uint16_t)(p[0]<<8 | p[1]);
+}
+
+inline uint8_t HeaderStatus(const uint8_t* frame, uint16_t crc){
+    uint8_t status = kFrameOk;
+    if(crc!=(uint16_t)(frame[kFrameCrcOffset] | frame[kFrameCrcOffset+1]<<8)){
+        status |= kFrameBadCrc;
+    }
+    if(frame[0]!=kFrameLength){
+        status |= kFrameBadLength;
+    }
+    if(frame[2]!=kFrameId1){
+        status |= kFrameBadId;
+    }
+    if(frame[11]!=kFrameVersion){
+        status |= kFrameBadVersion;
+    }
+    return status;
+}
+
+inline void Unpack(const uint8_t* f, const ReadingColumns& out, size_t row){
+    uint64_t address = 0;
+    for(int i=3;i<11;i++){
+        address = address<<8 | f[i];
+    }
+    out.address[row] = address;
+    out.id0[row] = f[1];
+    out.id1[row] = f[2];
+    out.version[row] = f[11];
+    out.count[row] = (uint32_t)f[12]<<24 | (uint32_t)f[13]<<16 | (uint32_t)f[14]<<8 | f[15];
+    out.batt[row] = Word(f+16);
+    out.temp[row] = Word(f+18);
+    out.v1[row] = Word(f+20);
+    out.v2[row] = Word(f+22);
+    out.uva[row] = Word(f+24);
+    out.uvb[row] = Word(f+26);
+    out.comp1[row] = Word(f+28);
+    out.comp2[row] = Word(f+30);
+    out.vis[row] = Word(f+32);
+    if(out.extra){
+        std::memcpy(out.extra+row*kFrameExtraLength, f+kFrameExtraOffset, kFrameExtraLength);
+    }
+}
+
+template <typename Frame>
+size_t DecodeBatch(Frame frame, size_t count, const ReadingColumns& out, size_t first){
+    size_t good = 0;
+    size_t i = 0;
+    for(;i+4<=count;i+=4){
+        const uint8_t* f[4] = {frame(i), frame(i+1), frame(i+2), frame(i+3)};
+        uint16_t crc[4];
+        Crc16x4(f, kFrameCrcOffset, crc);
+        for(int k=0;k<4;k++){
+            uint8_t status = HeaderStatus(f[k], crc[k]);
+            out.status[first+i+k] = status;
+            good += status==kFrameOk;
+            Unpack(f[k], out, first+i+k);
+        }
+    }
+    for(;i<count;i++){
+        good += DecodeFrame(frame(i), out, first+i)==kFrameOk;
+    }
+    return good;
+}
+
+} // namespace
+
+ReadingBuffer::ReadingBuffer(size_t capacity, bool extra)
+    : capacity_(capacity), address_(capacity), count_(capacity), words_(capacity*9), bytes_(capacity*4),
+      extra_(extra ? capacity*kFrameExtraLength : 0){
+    uint16_t* w = words_.data();
+    uint8_t* b = bytes_.data();
+    columns_.address = address_.data();
+    columns_.count = count_.data();
+    columns_.batt = w;
+    columns_.temp = w+capacity;
+    columns_.v1 = w+capacity*2;
+    columns_.v2 = w+capacity*3;
+    columns_.uva = w+capacity*4;
+    columns_.uvb = w+capacity*5;
+    columns_.comp1 = w+capacity*6;
+    columns_.comp2 = w+capacity*7;
+    columns_.vis = w+capacity*8;
+    columns_.id0 = b;
+    columns_.id1 = b+capacity;
+    columns_.version = b+capacity*2;
+    columns_.status = b+capacity*3;
+    columns_.extra = extra ? extra_.data() : nullptr;
+}
+
+uint8_t ValidateFrame(const uint8_t* frame){
+    return HeaderStatus(frame, Crc16(frame, kFrameCrcOffset));
+}
+
+uint8_t DecodeFrame(const uint8_t* frame, const ReadingColumns& out, size_t row){
+    uint8_t status = ValidateFrame(frame);
+    out.status[row] = status;
+    Unpack(frame, out, row);
+    return status;
+}
+
+size_t DecodeLogFrame(const uint8_t* frame, const ReadingColumns& out, size_t row){
+    if(!IsLogFrame(ValidateFrame(frame), frame[2])){
+        return 0;
+    }
+    uint32_t first = (uint32_t)frame[12]<<24 | (uint32_t)frame[13]<<16 | (uint32_t)frame[14]<<8 | frame[15];
+    size_t n = std::min<size_t>(frame[16], kLogRecordsPerFrame);
+    for(size_t i=0;i<n;i++,row++){
+        const uint8_t* r = frame+kLogRecordsOffset+i*kLogRecordLength;
+        Unpack(frame, out, row);
+        out.status[row] = kFrameOk;
+        out.count[row] = first+(uint16_t)(Word(r)-(uint16_t)first);
+        out.batt[row] = (uint16_t)(r[2]<<2 | r[3]>>6);
+        out.temp[row] = (uint16_t)((r[3] & 0x3F)<<4 | r[4]>>4);
+        out.v1[row] = 0;
+        out.v2[row] = 0;
+        out.uva[row] = Word(r+5);
+        out.uvb[row] = Word(r+7);
+        out.comp1[row] = Word(r+9);
+        out.comp2[row] = Word(r+11);
+        out.vis[row] = Word(r+13);
+        if(out.extra){
+            std::memset(out.extra+row*kFrameExtraLength, 0, kFrameExtraLength);
+        }
+    }
+    return n;
+}
+
+void EncodeFrame(const ReadingColumns& in, size_t row, uint8_t* f){
+    auto word = [f](size_t offset, uint16_t value){
+        f[offset] = (uint8_t)(value>>8);
+        f[offset+1] = (uint8_t)value;
+    };
+    f[0] = kFrameLength;
+    f[1] = in.id0[row];
+    f[2] = in.id1[row];
+    for(int i=0;i<8;i++){
+        f[3+i] = (uint8_t)(in.address[row]>>(56-8*i));
+    }
+    f[11] = kFrameVersion;
+    for(int i=0;i<4;i++){
+        f[12+i] = (uint8_t)(in.count[row]>>(24-8*i));
+    }
+    word(16, in.batt[row]);
+    word(18, in.temp[row]);
+    word(20, in.v1[row]);
+    word(22, in.v2[row]);
+    word(24, in.uva[row]);
+    word(26, in.uvb[row]);
+    word(28, in.comp1[row]);
+    word(30, in.comp2[row]);
+    word(32, in.vis[row]);
+    if(in.extra){
+        std::memcpy(f+kFrameExtraOffset, in.extra+row*kFrameExtraLength, kFrameExtraLength);
+    }
+    else{
+        std::memset(f+kFrameExtraOffset, 0, kFrameExtraLength);
+    }
+    uint16_t crc = Crc16(f, kFrameCrcOffset);
+    f[kFrameCrcOffset] = (uint8_t)crc;
+    f[kFrameCrcOffset+1] = (uint8_t)(crc>>8);
+}
+
+size_t DecodeFrames(const uint8_t* frames, size_t count, size_t stride, const ReadingColumns& out, size_t first){
+    return DecodeBatch([frames, stride](size_t i){ return frames+i*stride; }, count, out, first);
+}
+
+size_t DecodeFrames(const uint8_t* const* frames, size_t count, const ReadingColumns& out, size_t first){
+    return DecodeBatch([frames](size_t i){ return frames[i]; }, count, out, first);
+}
+
+} // namespace gateway
@@ -0,0 +1,150 @@
+/*
+ * File:   frame.h
+ * Author: Andy Page
+ * Comments: Decoder for the 50-byte v5 uplink packet built by buildPacket()
+ *           in main.c.  Multi-byte fields are MSB first except the CRC16,
+ *           which is LSB at byte 48 and MSB at byte 49:
+ *
+ *           0 length (50)  1 ID0  2 ID1 (2)  3-10 address  11 version (5)
+ *           12-15 messageCount  16 batt  18 temp  20 V1  22 V2
+ *           24 UVA  26 UVB  28 COMP1  30 COMP2  32 vis
+ *           34-47 profile.h phases or history.h samples, else 0
+ *           48-49 CRC16 of bytes 0 to 47
+ *
+ *           Only ID1 2 frames are readings.  The sensor's log packets
+ *           (sendLog(), ID1 0x22) share the length, version and CRC, so they
+ *           decode as kFrameBadId, but carry up to two samples that could
+ *           not be sent at the time (samplelog.h):
+ *
+ *           12-15 messageCount of the first record  16 records
+ *           17-31, 32-46 records: 0 count (low 16 bits)  2 batt and temp
+ *           (10 bits each)  5 UVA  7 UVB  9 COMP1  11 COMP2  13 vis
+ *
+ *           DecodeLogFrame() turns the records into rows of their own.
+ *
+ *           Frames are decoded in batches into caller owned columns
+ *           (struct of arrays), row i of the output is frame i of the
+ *           input.  Decoding never allocates.
+ * Revision history: 1, 19th October 2026
+ */
+
+#ifndef INC_GATEWAY_FRAME_H
+#define INC_GATEWAY_FRAME_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gateway {
+
+constexpr size_t kFrameLength = 50;
+constexpr size_t kFrameCrcOffset = 48;
+constexpr size_t kFrameExtraOffset = 34;
+constexpr size_t kFrameExtraLength = 14;
+constexpr uint8_t kFrameVersion = 5;
+constexpr uint8_t kFrameId1 = 0x02;         //UV/visible sensor reading
+constexpr uint8_t kFrameLogId1 = 0x22;      //Log packet, LOG_ID1 in samplelog.h
+constexpr size_t kLogRecordsOffset = 17;
+constexpr size_t kLogRecordLength = 15;
+constexpr size_t kLogRecordsPerFrame = 2;   //LOG_RECORDS_PER_PACKET
+
+//Status of each decoded row, 0 is a good frame
+constexpr uint8_t kFrameOk = 0x00;
+constexpr uint8_t kFrameBadCrc = 0x01;
+constexpr uint8_t kFrameBadLength = 0x02;   //Byte 0 is not 50
+constexpr uint8_t kFrameBadVersion = 0x04;  //Byte 11 is not 5
+constexpr uint8_t kFrameBadId = 0x08;       //Byte 2 is not kFrameId1, e.g. a log packet
+
+/**
+ * Output columns.  Every pointer must have room for the rows being decoded,
+ * extra (14 bytes a row) may be null.
+ */
+struct ReadingColumns {
+    uint64_t* address;      //Bytes 3 to 10, byte 3 most significant
+    uint8_t* id0;
+    uint8_t* id1;
+    uint8_t* version;
+    uint32_t* count;        //messageCount
+    uint16_t* batt;
+    uint16_t* temp;
+    uint16_t* v1;
+    uint16_t* v2;
+    uint16_t* uva;
+    uint16_t* uvb;
+    uint16_t* comp1;
+    uint16_t* comp2;
+    uint16_t* vis;
+    uint8_t* status;
+    uint8_t* extra;
+};
+
+/**
+ * Column storage for up to capacity rows, allocated once.
+ */
+class ReadingBuffer {
+public:
+    explicit ReadingBuffer(size_t capacity, bool extra = false);
+    const ReadingColumns& Columns() const { return columns_; }
+    size_t Capacity() const { return capacity_; }
+
+private:
+    size_t capacity_;
+    std::vector<uint64_t> address_;
+    std::vector<uint32_t> count_;
+    std::vector<uint16_t> words_;   //Nine 16-bit columns back to back
+    std::vector<uint8_t> bytes_;    //Four 8-bit columns back to back
+    std::vector<uint8_t> extra_;
+    ReadingColumns columns_;
+};
+
+/**
+ * Checks length, ID1, version and CRC16 of one frame.
+ * @return kFrameOk or a combination of the kFrameBad flags
+ */
+uint8_t ValidateFrame(const uint8_t* frame);
+
+/**
+ * A log packet: a good frame apart from its ID1 being kFrameLogId1.
+ */
+inline bool IsLogFrame(uint8_t status, uint8_t id1){
+    return status==kFrameBadId && id1==kFrameLogId1;
+}
+
+/**
+ * Decodes the records of a log packet into rows row to row+n-1 of out, with
+ * status kFrameOk and ID1 kFrameLogId1.  Each count is rebuilt from the
+ * full count of the first record and the record's low 16 bits.  Battery and
+ * temperature are the top 10 bits of the readings, whatever ADC_EXTRA_BITS
+ * the node was built with.
+ * @return n, 0 if frame is not a good log packet
+ */
+size_t DecodeLogFrame(const uint8_t* frame, const ReadingColumns& out, size_t row);
+
+/**
+ * Decodes one frame into row of out.
+ * @return Its status, the fields are filled in even if it is bad
+ */
+uint8_t DecodeFrame(const uint8_t* frame, const ReadingColumns& out, size_t row);
+
+/**
+ * Builds a frame from row of in, as buildPacket() does on the sensor (the
+ * inverse of DecodeFrame, for load generators and tests).  extra may be null
+ * for zeros; version, length and CRC16 are filled in.
+ */
+void EncodeFrame(const ReadingColumns& in, size_t row, uint8_t* frame);
+
+/**
+ * Decodes count frames stored stride bytes apart (stride >= 50) into rows
+ * first to first+count-1 of out.
+ * @return Number of good frames
+ */
+size_t DecodeFrames(const uint8_t* frames, size_t count, size_t stride, const ReadingColumns& out, size_t first = 0);
+
+/**
+ * As above for frames scattered in memory.
+ */
+size_t DecodeFrames(const uint8_t* const* frames, size_t count, const ReadingColumns& out, size_t first = 0);
+
+} // namespace gateway
+
+#endif /* INC_GATEWAY_FRAME_H */
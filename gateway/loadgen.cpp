@@ -0,0 +1,285 @@
+/**
+ * loadgen.cpp
+ * Channel and node simulation, see loadgen.h.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include "loadgen.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <random>
+
+namespace gateway {
+
+namespace {
+
+//From main.c, slots.h and LoRa.h
+constexpr double kJitterSlotSeconds = 0.1;  //BACKOFF_SLOT_MS
+constexpr double kSlotFrameSeconds = 76.0;  //SLOT_FRAME_MS
+constexpr double kSlotSeconds = 0.5;        //SLOT_MS
+constexpr uint32_t kSlotCount = 8;          //SLOT_COUNT
+constexpr uint32_t kSlotCalCycles = 61;     //SLOT_CAL_INTERVAL+1
+constexpr int kLbtTries = 5;                //LBT_MAX_TRIES
+constexpr double kLbtBackoffSeconds = 0.1;  //LBT_BACKOFF_MS
+constexpr double kLbtMaxSeconds = 2.0;      //LBT_MAX_TIME_MS
+constexpr double kCadSymbols = 1.3;
+constexpr uint64_t kAddressBase = 0x6EDA820000000000ull;
+
+struct Node {
+    uint64_t address;
+    double wdt;                 //This node's watchdog period
+    uint32_t slot;
+    double calError = 0.0;      //Of the last LFINTOSC calibration, slot schedule
+    uint32_t count = 0;
+    double cycleStart = 0.0;
+    int tries = 0;
+    double waited = 0.0;
+    double backoff = kLbtBackoffSeconds;
+    bool deferred = false;
+    float factor;               //Sensor exposure, shade etc.
+};
+
+struct Event {
+    double time;
+    uint32_t node;
+    bool operator>(const Event& other) const{
+        return time>other.time || (time==other.time && node>other.node);
+    }
+};
+
+struct Transmission {
+    double start;
+    double end;
+    uint32_t node;
+    uint32_t count;
+};
+
+//FNV-1a of the address big endian, as slotNumber() in slots.c
+uint32_t SlotNumber(uint64_t address){
+    uint32_t hash = 0x811C9DC5;
+    for(int i=0;i<8;i++){
+        hash = (hash^(uint8_t)(address>>(56-8*i)))*0x01000193;
+    }
+    return hash%kSlotCount;
+}
+
+/**
+ * Readings for a node at a time of day: UV and light follow the sun, the
+ * battery runs down slowly.
+ */
+void FillReadings(const ReadingColumns& c, const Node& node, double unixSeconds, double fraction){
+    double hour = std::fmod(unixSeconds, 86400.0)/3600.0;
+    double sun = std::max(0.0, std::sin(M_PI*(hour-6.0)/12.0))*node.factor;
+    c.address[0] = node.address;
+    c.id0[0] = 0;
+    c.id1[0] = 2;
+    c.count[0] = node.count;
+    c.batt[0] = (uint16_t)(525-fraction*5);
+    c.temp[0] = (uint16_t)(512+40*std::sin(M_PI*(hour-9.0)/12.0));
+    c.v1[0] = 0;
+    c.v2[0] = 0;
+    c.uva[0] = (uint16_t)(60+sun*400);
+    c.uvb[0] = (uint16_t)(50+sun*300);
+    c.comp1[0] = (uint16_t)(10+sun*50);
+    c.comp2[0] = (uint16_t)(8+sun*40);
+    c.vis[0] = (uint16_t)std::min(65535.0, sun*60000);
+}
+
+} // namespace
+
+double LoRaAirtime(int sf, double bandwidthHz, int cr, int preamble, bool crc, bool implicitHeader, bool ldro,
+                   size_t length){
+    double symbol = std::ldexp(1.0, sf)/bandwidthHz;
+    double payload = std::ceil((8.0*length-4.0*sf+28+16*crc-20*implicitHeader)/(4.0*(sf-2*ldro)))*(cr+4);
+    return (preamble+4.25+8+std::max(payload, 0.0))*symbol;
+}
+
+double LoadConfig::Airtime() const{
+    bool ldro = std::ldexp(1.0, sf)/bandwidthHz>0.016;
+    return LoRaAirtime(sf, bandwidthHz, codingRate, preamble, false, false, ldro, kFrameLength);
+}
+
+size_t ResolveReceptions(std::vector<Reception>& r, double preambleSeconds, double sensitivityDbm, double captureDb){
+    size_t received = 0;
+    size_t first = 0;   //Oldest that may still overlap
+    for(size_t i=0;i<r.size();i++){
+        Reception& p = r[i];
+        while(first<i && r[first].end<=p.start){
+            first++;
+        }
+        if(p.rssiDbm<sensitivityDbm){
+            p.received = false;
+            continue;
+        }
+        double interference = 0.0;
+        bool locked = false;    //On to an earlier packet
+        for(size_t j=first;j<r.size() && r[j].start<p.end;j++){
+            if(j==i || r[j].end<=p.start){
+                continue;
+            }
+            interference += std::pow(10.0, r[j].rssiDbm/10.0);
+            if(j<i && r[j].rssiDbm>=sensitivityDbm && p.start>=r[j].start+preambleSeconds){
+                locked = true;
+            }
+        }
+        p.received = !locked && (interference==0.0 || p.rssiDbm-10.0*std::log10(interference)>=captureDb);
+        received += p.received;
+    }
+    return received;
+}
+
+LoadResult RunLoad(const LoadConfig& config, const LoadSink& sink){
+    LoadResult result;
+    std::mt19937_64 random(config.seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    double airtime = config.Airtime();
+    double symbol = std::ldexp(1.0, config.sf)/config.bandwidthHz;
+    double preambleTime = (config.preamble+4.25)*symbol;
+    double cadTime = kCadSymbols*symbol;
+
+    std::vector<Node> nodes(config.nodes);
+    std::vector<float> pathRssi((size_t)config.nodes*config.receivers);
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+    for(uint32_t i=0;i<config.nodes;i++){
+        Node& n = nodes[i];
+        n.address = kAddressBase+i*0x10001ull;
+        n.wdt = config.wdtSeconds*(1.0+config.wdtSpread*(2.0*uniform(random)-1.0));
+        n.slot = SlotNumber(n.address);
+        n.factor = (float)(0.5+0.5*uniform(random));
+        for(uint32_t r=0;r<config.receivers;r++){
+            pathRssi[(size_t)i*config.receivers+r] =
+                (float)(config.rssiMinDbm+(config.rssiMaxDbm-config.rssiMinDbm)*uniform(random));
+        }
+        n.cycleStart = config.startSpread*uniform(random);
+        if(config.schedule==kScheduleSlots){
+            n.cycleStart += n.slot*kSlotSeconds;    //SlotsWake() on the first cycle
+        }
+        events.push({n.cycleStart+config.awakeSeconds, i});
+    }
+
+    //Transmissions in start order, nodes take turns through the event queue
+    std::vector<Transmission> air;
+    while(!events.empty()){
+        Event e = events.top();
+        events.pop();
+        Node& n = nodes[e.node];
+        double t = e.time;
+        if(n.tries==0){
+            result.cycles++;
+            n.tries = 1;
+            n.waited = 0.0;
+            n.backoff = kLbtBackoffSeconds;
+            n.deferred = false;
+            if(config.schedule==kScheduleJitter && config.jitterNodes>1){
+                double jitter = (random()%config.jitterNodes)*kJitterSlotSeconds+
+                                (random()%100)*kJitterSlotSeconds/100;
+                events.push({t+jitter, e.node});
+                continue;
+            }
+        }
+        bool busy = false;
+        if(config.lbt){
+            for(size_t k=air.size();k-->0 && air[k].start>t-airtime;){
+                if(air[k].end>t && (t-air[k].start<preambleTime || uniform(random)<config.cadPayload)){
+                    busy = true;
+                    break;
+                }
+            }
+            t += cadTime;
+        }
+        double sleepAt;
+        if(busy){
+            n.deferred = true;
+            double delay = n.backoff+(random()%(uint64_t)(n.backoff*1000))/1000.0;
+            if(n.tries<kLbtTries && n.waited+delay<=kLbtMaxSeconds){
+                n.tries++;
+                n.waited += delay;
+                n.backoff *= 2;
+                events.push({t+delay, e.node});
+                continue;
+            }
+            result.lbtGaveUp++;
+            sleepAt = t+config.afterSeconds;
+        }
+        else{
+            air.push_back({t, t+airtime, e.node, n.count});
+            sleepAt = t+airtime+config.afterSeconds;
+        }
+        result.lbtDeferred += n.deferred;
+        n.tries = 0;
+        n.count++;
+        //Next wake, the slot schedule holds the frame period against the watchdog as well as the calibration
+        //allows.  Nothing corrects the error, so the node walks away from its slot.
+        if(config.schedule==kScheduleSlots){
+            if(n.count%kSlotCalCycles==1){
+                n.calError = config.slotCalError*(2.0*uniform(random)-1.0);
+            }
+            n.cycleStart += kSlotFrameSeconds+config.wdtSeconds*(n.calError+config.wdtWander*normal(random));
+        }
+        else{
+            n.cycleStart = sleepAt+n.wdt*(1.0+config.wdtWander*normal(random));
+        }
+        if(n.cycleStart<config.seconds){
+            events.push({n.cycleStart+config.awakeSeconds, e.node});
+        }
+    }
+    result.sent = air.size();
+    result.offeredLoad = result.cycles*airtime/config.seconds;
+
+    //Each receiver hears every transmission at its own level
+    std::vector<uint8_t> heard(air.size()*config.receivers);
+    std::vector<float> level(air.size()*config.receivers);
+    std::vector<Reception> receptions(air.size());
+    for(uint32_t r=0;r<config.receivers;r++){
+        for(size_t k=0;k<air.size();k++){
+            double rssi = pathRssi[(size_t)air[k].node*config.receivers+r]+config.fadingDb*normal(random);
+            receptions[k] = {air[k].start, air[k].end, rssi, false};
+        }
+        result.receptions += ResolveReceptions(receptions, preambleTime, config.sensitivityDbm, config.captureDb);
+        for(size_t k=0;k<air.size();k++){
+            heard[k*config.receivers+r] = receptions[k].received;
+            level[k*config.receivers+r] = (float)receptions[k].rssiDbm;
+            if(!receptions[k].received){
+                if(receptions[k].rssiDbm<config.sensitivityDbm){
+                    result.weak++;
+                }
+                else{
+                    result.collided++;
+                }
+            }
+        }
+    }
+
+    ReadingBuffer buffer(1);
+    uint8_t frame[kFrameLength];
+    for(size_t k=0;k<air.size();k++){
+        bool any = false;
+        for(uint32_t r=0;r<config.receivers;r++){
+            if(!heard[k*config.receivers+r]){
+                continue;
+            }
+            any = true;
+            if(!sink){
+                continue;
+            }
+            Node node = nodes[air[k].node];
+            node.count = air[k].count;
+            double unix = config.startUnix+air[k].end;
+            FillReadings(buffer.Columns(), node, unix, air[k].end/config.seconds);
+            EncodeFrame(buffer.Columns(), 0, frame);
+            double rssi = level[k*config.receivers+r];
+            double snr = std::min(31.75, std::max(-32.0, rssi-config.noiseDbm));
+            int8_t snrRegister = (int8_t)std::lround(snr*4);
+            long rssiRegister = std::lround(rssi+157-(snr<0 ? snrRegister*0.25 : 0.0));
+            sink(r, (uint64_t)(unix*1e9), (uint8_t)std::min(255L, std::max(0L, rssiRegister)), snrRegister, frame);
+        }
+        result.received += any;
+    }
+    return result;
+}
+
+} // namespace gateway
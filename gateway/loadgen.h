@@ -0,0 +1,135 @@
+/*
+ * File:   loadgen.h
+ * Author: Andy Page
+ * Comments: Many sensors sharing one channel, to see how many a channel and
+ *           a gateway can carry.  Each simulated node behaves as main.c
+ *           does:
+ *
+ *           - wakes every watchdog period (64s nominal) plus its awake time,
+ *             with a fixed LFINTOSC error per node and a little wander from
+ *             cycle to cycle, so nodes drift through each other
+ *           - powers up with the others, all at once or spread over a time
+ *           - transmits about 0.45s after waking, after BackoffJitter()
+ *             (0 to NODE_COUNT-1 slots of 100ms plus a fraction) or in its
+ *             slots.h slot of a 76s frame
+ *           - listens before talk: CAD, then backs off 100ms doubling with a
+ *             random part, giving up after 5 tries or 2s
+ *
+ *           Airtime comes from the LoRaOptimalLoad() settings (SF7, 125kHz,
+ *           4/5, 8 symbol preamble, explicit header, no LoRa CRC), 97.5ms
+ *           for 50 bytes.  Reception at each receiver is pure ALOHA with
+ *           capture: a packet is lost below sensitivity, when the receiver
+ *           has already locked on to an earlier packet whose preamble had
+ *           ended, or when it is not captureDb above the sum of the packets
+ *           overlapping it.
+ *
+ *           Packets received are valid v5 frames with CRC16, passed to a
+ *           sink per receiver in time order, ready for the receiver stream
+ *           format (ReceiverEncode) and the ingest pipeline.  Runs are
+ *           repeatable for a given seed.
+ * Revision history: 1, 19th October 2026
+ */
+
+#ifndef INC_GATEWAY_LOADGEN_H
+#define INC_GATEWAY_LOADGEN_H
+
+#include "frame.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace gateway {
+
+/**
+ * LoRa time on air (SX1276 datasheet 4.1.1.7).
+ * @param cr    Coding rate 1 to 4 for 4/5 to 4/8
+ */
+double LoRaAirtime(int sf, double bandwidthHz, int cr, int preamble, bool crc, bool implicitHeader, bool ldro,
+                   size_t length);
+
+enum LoadSchedule : uint8_t {
+    kScheduleJitter,    //BackoffJitter(NODE_COUNT), the default build
+    kScheduleSlots,     //SLOT_SCHEDULING
+    kScheduleNone       //Transmit as soon as awake
+};
+
+struct LoadConfig {
+    uint32_t nodes = 100;
+    double seconds = 6*3600.0;      //Simulated time
+    uint32_t receivers = 1;
+    uint64_t seed = 49;
+    uint32_t startUnix = 1790000000;    //Time of power up, for frame timestamps
+    //Node timing
+    double wdtSeconds = 64.0;       //WDTPS 16384
+    double wdtSpread = 0.10;        //Per node LFINTOSC error, +- this fraction
+    double wdtWander = 0.002;       //Cycle to cycle, standard deviation
+    double slotCalError = 0.002;    //SlotsCalibrate() error, +- this fraction, drawn each SLOT_CAL_INTERVAL cycles
+    double awakeSeconds = 0.45;     //Wake to the transmission
+    double afterSeconds = 0.15;     //Transmission end to sleep
+    double startSpread = 0.0;       //Power up spread, 0 for all together
+    LoadSchedule schedule = kScheduleJitter;
+    uint32_t jitterNodes = 8;       //NODE_COUNT
+    bool lbt = true;
+    double cadPayload = 0.5;        //Chance CAD sees a packet past its preamble
+    //Radio
+    int sf = 7;
+    double bandwidthHz = 125000.0;
+    int codingRate = 1;
+    int preamble = 8;
+    //Reception
+    double captureDb = 6.0;
+    double sensitivityDbm = -123.0; //SF7, 125kHz
+    double noiseDbm = -117.0;       //125kHz with a 6dB noise figure
+    double rssiMinDbm = -125.0;     //Node to receiver path, uniform in dBm
+    double rssiMaxDbm = -70.0;
+    double fadingDb = 2.0;          //Per packet, standard deviation
+
+    double Airtime() const;
+};
+
+struct LoadResult {
+    uint64_t cycles = 0;            //Frames the nodes tried to send
+    uint64_t sent = 0;              //Went on air
+    uint64_t lbtGaveUp = 0;         //Channel stayed busy
+    uint64_t lbtDeferred = 0;       //CAD found the channel busy at least once
+    uint64_t received = 0;          //Heard by at least one receiver
+    uint64_t receptions = 0;        //Summed over receivers
+    uint64_t weak = 0;              //Below sensitivity (per receiver)
+    uint64_t collided = 0;          //Lost to overlap (per receiver)
+    double offeredLoad = 0.0;       //G, airtime per period summed over nodes
+
+    double Pdr() const { return cycles ? (double)received/cycles : 0.0; }
+};
+
+/**
+ * Called for each packet a receiver gets, in time order per receiver.
+ * @param timeNs    Unix time of the end of the packet
+ */
+typedef std::function<void(uint32_t receiver, uint64_t timeNs, uint8_t rssi, int8_t snr, const uint8_t* frame)>
+    LoadSink;
+
+LoadResult RunLoad(const LoadConfig& config, const LoadSink& sink = nullptr);
+
+/**
+ * One transmission as a receiver sees it.
+ */
+struct Reception {
+    double start;
+    double end;
+    double rssiDbm;
+    bool received;
+};
+
+/**
+ * Applies sensitivity, lock on and capture to receptions sorted by start.
+ * @param preambleSeconds   Time after which the receiver is locked on
+ * @return Number received
+ */
+size_t ResolveReceptions(std::vector<Reception>& receptions, double preambleSeconds, double sensitivityDbm,
+                         double captureDb);
+
+} // namespace gateway
+
+#endif /* INC_GATEWAY_LOADGEN_H */
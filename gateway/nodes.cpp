@@ -0,0 +1,265 @@
+/**
+ * nodes.cpp
+ * Sharded node table, see nodes.h.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include "nodes.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace gateway {
+
+namespace {
+
+constexpr size_t kInitialSlots = 64;   //Per shard, doubled at half full
+constexpr unsigned kSpins = 100;
+
+//splitmix64 finaliser, addresses share long prefixes
+inline uint64_t Hash(uint64_t address){
+    address ^= address>>30;
+    address *= 0xBF58476D1CE4E5B9ull;
+    address ^= address>>27;
+    address *= 0x94D049BB133111EBull;
+    return address ^ address>>31;
+}
+
+inline void Pause(){
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+} // namespace
+
+struct NodeTable::Slot {
+    bool used = false;
+    uint64_t address = 0;
+    uint64_t window = 0;    //Bit i set if highest-i has been seen
+    uint64_t missing = 0;   //Bit i set if highest-i was skipped by a gap
+    NodeStats stats;
+};
+
+struct alignas(64) NodeTable::Shard {
+    std::atomic<bool> locked{false};
+    std::vector<Slot> slots;
+    size_t used = 0;
+
+    void Lock(){
+        //Give the CPU up if the holder has been preempted
+        for(unsigned spins=0;locked.exchange(true, std::memory_order_acquire);){
+            while(locked.load(std::memory_order_relaxed)){
+                if(++spins<kSpins){
+                    Pause();
+                }
+                else{
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+    void Unlock(){
+        locked.store(false, std::memory_order_release);
+    }
+
+    //Slot of address, or the empty slot it would go in
+    Slot& Find(uint64_t address, uint64_t hash){
+        size_t mask = slots.size()-1;
+        size_t i = hash & mask;
+        while(slots[i].used && slots[i].address!=address){
+            i = (i+1) & mask;
+        }
+        return slots[i];
+    }
+
+    void Grow(){
+        std::vector<Slot> old(slots.size()*2);
+        old.swap(slots);
+        for(Slot& s : old){
+            if(s.used){
+                Find(s.address, Hash(s.address)) = s;
+            }
+        }
+    }
+};
+
+NodeTable::NodeTable(size_t shards, uint32_t duplicateSeconds) : shardCount_(1), shardShift_(64),
+    duplicateSeconds_(duplicateSeconds){
+    while(shardCount_<shards){
+        shardCount_ <<= 1;
+        shardShift_--;
+    }
+    shards_.reset(new Shard[shardCount_]);
+    for(size_t i=0;i<shardCount_;i++){
+        shards_[i].slots.resize(kInitialSlots);
+    }
+}
+
+NodeTable::~NodeTable() = default;
+
+NodeTable::Shard& NodeTable::ShardOf(uint64_t hash) const{
+    //Top bits pick the shard, the bottom bits the slot within it
+    return shards_[shardShift_<64 ? hash>>shardShift_ : 0];
+}
+
+Sequence NodeTable::Track(uint64_t address, uint32_t count, uint32_t time, bool logged){
+    uint64_t hash = Hash(address);
+    Shard& shard = ShardOf(hash);
+    shard.Lock();
+    Slot* slot = &shard.Find(address, hash);
+    if(!slot->used){
+        if((shard.used+1)*2>shard.slots.size()){
+            shard.Grow();
+            slot = &shard.Find(address, hash);
+        }
+        shard.used++;
+        slot->used = true;
+        slot->address = address;
+        slot->window = 1;
+        slot->stats.highest = count;
+        slot->stats.received = 1;
+        slot->stats.firstTime = slot->stats.lastTime = time;
+        shard.Unlock();
+        return kSequenceFirst;
+    }
+    NodeStats& s = slot->stats;
+    uint32_t ahead = count-s.highest;      //Modulo 2^32
+    Sequence result;
+    if(ahead!=0 && ahead<0x80000000u){
+        if(count<s.highest){
+            s.wraps++;
+        }
+        int32_t elapsed = (int32_t)(time-s.lastTime);
+        if(ahead==1){
+            result = kSequenceNext;
+        }
+        else if(!logged && ahead<=2*kSequenceWindow && elapsed>=(int32_t)kRebootSeconds &&
+                (uint32_t)elapsed<ahead*kRebootSeconds){
+            //Silent for a watchdog period but too soon for the counts in between, the node reset and
+            //resumed after its checkpoint
+            result = kSequenceReboot;
+            s.reboots++;
+            slot->window = 1;
+            slot->missing = 0;
+        }
+        else{
+            result = kSequenceGap;
+            s.gaps++;
+            s.lost += ahead-1;
+        }
+        if(result!=kSequenceReboot){
+            uint64_t skipped = ahead>=kSequenceWindow ? ~1ull : (1ull<<ahead)-2;
+            slot->missing = ahead>=kSequenceWindow ? skipped : slot->missing<<ahead | skipped;
+            slot->window = ahead>=kSequenceWindow ? 1 : slot->window<<ahead | 1;
+        }
+        s.highest = count;
+        s.lastTime = time;
+        s.received++;
+    }
+    else{
+        uint32_t behind = s.highest-count;
+        bool repeat = logged || (int32_t)(time-s.lastTime)<=(int32_t)duplicateSeconds_;   //Or from before it
+        if(behind<kSequenceWindow && repeat && slot->window>>behind & 1){
+            result = kSequenceDuplicate;
+            s.duplicates++;
+        }
+        else if((behind<kSequenceWindow && repeat) || logged){
+            //A logged sample beyond the window is taken as late but can't be
+            //told from a duplicate
+            result = kSequenceLate;
+            if(behind<kSequenceWindow){
+                slot->window |= 1ull<<behind;
+                s.lost -= slot->missing>>behind & 1;   //Not if it came before the first frame
+                slot->missing &= ~(1ull<<behind);
+            }
+            s.late++;
+            s.received++;
+        }
+        else{
+            result = kSequenceReboot;
+            s.reboots++;
+            slot->window = 1;
+            slot->missing = 0;
+            s.highest = count;
+            s.lastTime = time;
+            s.received++;
+        }
+    }
+    shard.Unlock();
+    return result;
+}
+
+size_t NodeTable::Track(const ReadingColumns& in, const uint32_t* time, size_t first, size_t count,
+                        uint8_t* sequence){
+    size_t keep = 0;
+    for(size_t row=first;row<first+count;row++){
+        if(in.status[row]!=kFrameOk){
+            sequence[row] = kSequenceSkipped;
+            continue;
+        }
+        sequence[row] = Track(in.address[row], in.count[row], time[row], in.id1[row]==kFrameLogId1);
+        keep += SequenceKeep(sequence[row]);
+    }
+    return keep;
+}
+
+bool NodeTable::Lookup(uint64_t address, NodeStats& stats) const{
+    uint64_t hash = Hash(address);
+    Shard& shard = ShardOf(hash);
+    shard.Lock();
+    const Slot& slot = shard.Find(address, hash);
+    bool found = slot.used;
+    if(found){
+        stats = slot.stats;
+    }
+    shard.Unlock();
+    return found;
+}
+
+uint32_t NodeTable::CountTime(uint64_t address, uint32_t count, uint32_t fallback) const{
+    NodeStats s;
+    if(!Lookup(address, s)){
+        return fallback;
+    }
+    uint32_t behind = s.highest-count;
+    uint64_t back = (uint64_t)behind*kCycleSeconds;
+    return behind<0x80000000u && back<s.lastTime ? s.lastTime-(uint32_t)back : fallback;
+}
+
+size_t NodeTable::Nodes() const{
+    size_t nodes = 0;
+    for(size_t i=0;i<shardCount_;i++){
+        shards_[i].Lock();
+        nodes += shards_[i].used;
+        shards_[i].Unlock();
+    }
+    return nodes;
+}
+
+NodeStats NodeTable::Totals() const{
+    NodeStats total;
+    for(size_t i=0;i<shardCount_;i++){
+        Shard& shard = shards_[i];
+        shard.Lock();
+        for(const Slot& slot : shard.slots){
+            if(!slot.used){
+                continue;
+            }
+            const NodeStats& s = slot.stats;
+            total.received += s.received;
+            total.duplicates += s.duplicates;
+            total.late += s.late;
+            total.lost += s.lost;
+            total.gaps += s.gaps;
+            total.reboots += s.reboots;
+            total.wraps += s.wraps;
+        }
+        shard.Unlock();
+    }
+    return total;
+}
+
+} // namespace gateway
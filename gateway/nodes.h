@@ -0,0 +1,139 @@
+/*
+ * File:   nodes.h
+ * Author: Andy Page
+ * Comments: Per node sequence tracking.  Every frame carries messageCount,
+ *           which goes up by one a transmission, and several receivers can
+ *           hear the same
+ *           transmission.  The sensor checkpoints the count in EEPROM at
+ *           start up and every 64 counts (samplelog.h), and after a reset
+ *           carries on 64 past the last checkpoint, so a reset shows up as
+ *           a jump forward of 1 to 64 and only a new EEPROM goes back to 0.
+ *           NodeTable keeps for each address the highest
+ *           count seen and a 64 bit window of which of the counts below it
+ *           have arrived, which gives:
+ *
+ *           - duplicates: a count already in the window
+ *           - late (reordered) frames: a count in the window not seen yet,
+ *             taken back off the lost total
+ *           - gaps: a jump forward, the counts skipped are lost until they
+ *             turn up late
+ *           - reboots: a count going backwards that is not a duplicate
+ *             (beyond the window, or later than any receiver could repeat
+ *             the frame), or a jump forward of up to 2 windows after a
+ *             silence of at least a watchdog period (kRebootSeconds) but
+ *             sooner than the counts skipped could have been sent, at
+ *             least kRebootSeconds each.  A reset costs about a watchdog
+ *             period, whereas each lost frame costs a whole cycle.  A
+ *             reset just before a checkpoint moves on by 1 and looks like
+ *             the next frame, and sources without real receive times
+ *             (files) only ever show gaps
+ *           - wraps: counts compared modulo 2^32 so 0xFFFFFFFF to 0 is the
+ *             next frame
+ *           - logged samples: records of log packets (DecodeLogFrame())
+ *             arrive long after their counts were due, so they fill the
+ *             gaps as late frames whatever their time, and are never
+ *             reboots
+ *
+ *           The table is split into shards by a hash of the address, each
+ *           an open addressed hash table behind its own spinlock, so
+ *           threads updating different nodes rarely meet and the time a
+ *           lock is held is one probe and a few compares.
+ * Revision history: 1, 19th October 2026
+ */
+
+#ifndef INC_GATEWAY_NODES_H
+#define INC_GATEWAY_NODES_H
+
+#include "frame.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace gateway {
+
+//What Track() made of a frame
+enum Sequence : uint8_t {
+    kSequenceFirst,         //First frame from the node
+    kSequenceNext,          //One on from the highest count
+    kSequenceGap,           //Further on, counts in between are lost so far
+    kSequenceLate,          //Behind the highest count and not seen before
+    kSequenceDuplicate,     //Seen before, drop it
+    kSequenceReboot,        //Count went back, the node has restarted
+    kSequenceSkipped        //Bad frame, not tracked (batch Track only)
+};
+
+//True if a frame should be kept
+inline bool SequenceKeep(uint8_t sequence){
+    return sequence!=kSequenceDuplicate && sequence!=kSequenceSkipped;
+}
+
+constexpr uint32_t kSequenceWindow = 64;
+constexpr uint32_t kDuplicateSeconds = 30;  //Under the ~67s between transmissions
+constexpr uint32_t kRebootSeconds = 48;     //Under the shortest cycle, the 64s watchdog period less LFINTOSC error
+constexpr uint32_t kCycleSeconds = 65;      //Watchdog period and the time awake, for times worked out from counts
+
+struct NodeStats {
+    uint64_t received = 0;      //Frames kept
+    uint64_t duplicates = 0;
+    uint64_t late = 0;
+    int64_t lost = 0;           //Counts skipped and not yet seen
+    uint64_t gaps = 0;          //Forward jumps
+    uint64_t reboots = 0;
+    uint64_t wraps = 0;
+    uint32_t highest = 0;       //Highest count since the last reboot
+    uint32_t firstTime = 0;
+    uint32_t lastTime = 0;      //Of the highest count
+};
+
+class NodeTable {
+public:
+    /**
+     * @param shards    Rounded up to a power of two
+     */
+    explicit NodeTable(size_t shards = 64, uint32_t duplicateSeconds = kDuplicateSeconds);
+    ~NodeTable();
+    NodeTable(const NodeTable&) = delete;
+    NodeTable& operator=(const NodeTable&) = delete;
+
+    /**
+     * Records a frame.  Safe to call from several threads.
+     * @param time      Receive time, seconds
+     * @param logged    A log packet record, see above
+     */
+    Sequence Track(uint64_t address, uint32_t count, uint32_t time, bool logged = false);
+
+    /**
+     * Tracks the rows first to first+count-1 of decoded frames, rows that
+     * are not kFrameOk get kSequenceSkipped and rows with ID1 kFrameLogId1
+     * are logged.
+     * @param sequence  Result for each row, indexed as the columns
+     * @return Number of rows to keep
+     */
+    size_t Track(const ReadingColumns& in, const uint32_t* time, size_t first, size_t count, uint8_t* sequence);
+
+    bool Lookup(uint64_t address, NodeStats& stats) const;
+    /**
+     * When a count was due, kCycleSeconds a count before the time of the
+     * node's highest count.
+     * @return fallback if the node is not known or count is not behind it
+     */
+    uint32_t CountTime(uint64_t address, uint32_t count, uint32_t fallback) const;
+    size_t Nodes() const;
+    //Sum over all nodes (highest and the times are not meaningful)
+    NodeStats Totals() const;
+
+private:
+    struct Slot;
+    struct Shard;
+    Shard& ShardOf(uint64_t hash) const;
+
+    std::unique_ptr<Shard[]> shards_;
+    size_t shardCount_;
+    unsigned shardShift_;
+    uint32_t duplicateSeconds_;
+};
+
+} // namespace gateway
+
+#endif /* INC_GATEWAY_NODES_H */
@@ -0,0 +1,471 @@
+/**
+ * pipeline.cpp
+ * Gateway ingest stages, see pipeline.h.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include "pipeline.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <poll.h>
+#include <unistd.h>
+
+namespace gateway {
+
+namespace {
+
+constexpr size_t kReadBuffer = 65536;
+
+uint64_t NowNs(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint64_t WallNs(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void Busy(StageStats& stage, size_t items, uint64_t start){
+    stage.items.fetch_add(items, std::memory_order_relaxed);
+    stage.batches.fetch_add(1, std::memory_order_relaxed);
+    stage.busyNs.fetch_add(NowNs()-start, std::memory_order_relaxed);
+}
+
+} // namespace
+
+//Row i is frame i, then the records of any log packets among them
+struct Pipeline::Batch {
+    explicit Batch(size_t capacity)
+        : frames(capacity), columns(capacity*(1+kLogRecordsPerFrame)), time(columns.Capacity()),
+          sequence(columns.Capacity()), frameOf(columns.Capacity()), calibrated(columns.Capacity()*6){
+        size_t rows = columns.Capacity();
+        float* c = calibrated.data();
+        out = {c, c+rows, c+rows*2, c+rows*3, c+rows*4, c+rows*5};
+    }
+    std::vector<RxFrame> frames;
+    ReadingBuffer columns;
+    std::vector<uint32_t> time;         //Unix seconds, for the store
+    std::vector<uint8_t> sequence;      //Sequence of each row, see nodes.h
+    std::vector<uint32_t> frameOf;      //Log packet of each log record row
+    std::vector<float> calibrated;
+    CalibratedColumns out;
+    size_t frameCount = 0;
+    size_t rows = 0;
+
+    bool Keep(size_t row) const { return SequenceKeep(sequence[row]); }
+    const RxFrame& Frame(size_t row) const { return frames[row<frameCount ? row : frameOf[row]]; }
+};
+
+uint64_t PipelineStats::LatencyPercentile(double fraction) const{
+    uint64_t total = 0;
+    for(const std::atomic<uint64_t>& bucket : latency){
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    uint64_t seen = 0;
+    for(int i=0;i<kLatencyBuckets;i++){
+        seen += latency[i].load(std::memory_order_relaxed);
+        if(total && seen>=fraction*total){
+            return 1ull<<i;
+        }
+    }
+    return 0;
+}
+
+Pipeline::Pipeline(const PipelineConfig& config)
+    : config_(config), frames_(config.queueFrames), free_(config.batches), decoded_(config.batches),
+      calibrated_(config.batches){
+    if(config_.batch<1){
+        config_.batch = 1;
+    }
+    if(config_.workers<1){
+        config_.workers = 1;
+    }
+    for(size_t i=0;i<config_.batches;i++){
+        pool_.emplace_back(new Batch(config_.batch));
+        free_.TryPush(pool_.back().get());
+    }
+}
+
+Pipeline::~Pipeline(){
+    if(started_){
+        RequestStop();
+        Finish();
+    }
+}
+
+bool Pipeline::Start(std::string& error){
+    //Files are read as fast as they go and stamped when read, so two of them
+    //are not in step and NodeTable can't find the frames both heard
+    if(std::count_if(config_.sources.begin(), config_.sources.end(), ReceiverSourceEnds)>1){
+        error = "more than one receiver file, their frames have no receive times (merge captures with uvreplay)";
+        return false;
+    }
+    std::vector<int> fds;
+    for(const std::string& source : config_.sources){
+        int fd = OpenReceiverSource(source, error);
+        if(fd<0){
+            for(int open : fds){
+                close(open);
+            }
+            return false;
+        }
+        fds.push_back(fd);
+    }
+    if(!config_.capture.empty() && !capture_.Open(config_.capture, error)){
+        for(int open : fds){
+            close(open);
+        }
+        return false;
+    }
+    if(!config_.storeRoot.empty()){
+        store_.reset(new StoreWriter(config_.storeRoot));
+    }
+    if(config_.readings){
+        std::fprintf(config_.readings, "time,address,count,rssi_dbm,snr_db,uva_uw_cm2,uvb_uw_cm2,uv_index,lux,"
+                     "battery_v,temperature_c,time_from_count\n");
+    }
+    started_ = true;
+    readersRunning_ = (int)fds.size();
+    for(size_t i=0;i<fds.size();i++){
+        readers_.emplace_back(&Pipeline::Reader, this, i, fds[i], ReceiverSourceEnds(config_.sources[i]));
+    }
+    for(size_t i=0;i<config_.workers;i++){
+        decoders_.emplace_back(&Pipeline::Decoder, this);
+    }
+    calibrator_ = std::thread(&Pipeline::Calibrator, this);
+    storer_ = std::thread(&Pipeline::Storer, this);
+    return true;
+}
+
+void Pipeline::Finish(){
+    if(!started_){
+        return;
+    }
+    for(std::thread& reader : readers_){
+        reader.join();
+    }
+    inputDone_.store(true, std::memory_order_release);
+    for(std::thread& decoder : decoders_){
+        decoder.join();
+    }
+    decodeDone_.store(true, std::memory_order_release);
+    calibrator_.join();
+    calibrateDone_.store(true, std::memory_order_release);
+    storer_.join();
+    if(store_ && !store_->Flush()){
+        stats_.storeErrors++;
+    }
+    if(!config_.capture.empty() && !capture_.Close()){
+        stats_.captureErrors++;
+    }
+    if(config_.readings){
+        std::fflush(config_.readings);
+    }
+    started_ = false;
+}
+
+void Pipeline::Submit(RxFrame frame){
+    frame.ingestNs = NowNs();
+    Backoff backoff;
+    uint64_t start = 0;
+    while(!frames_.TryPush(frame)){
+        if(!start){
+            start = NowNs();
+        }
+        backoff.Wait();
+    }
+    if(start){
+        stats_.read.stallNs.fetch_add(NowNs()-start, std::memory_order_relaxed);
+    }
+    stats_.read.items.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Pipeline::Push(BoundedQueue<Batch*>& queue, Batch* batch, StageStats& stage){
+    Backoff backoff;
+    uint64_t start = NowNs();
+    bool waited = false;
+    while(!queue.TryPush(batch)){
+        waited = true;
+        backoff.Wait();
+    }
+    if(waited){
+        stage.stallNs.fetch_add(NowNs()-start, std::memory_order_relaxed);
+    }
+}
+
+void Pipeline::Reader(size_t index, int fd, bool ends){
+    ReceiverParser parser;
+    std::vector<uint8_t> buffer(kReadBuffer);
+    std::vector<RxFrame> captured;
+    bool capture = !config_.capture.empty();
+    uint64_t badChecksums = 0;
+    while(!stop_.load(std::memory_order_relaxed)){
+        struct pollfd p = {fd, POLLIN, 0};
+        if(!ends && poll(&p, 1, 100)<=0){
+            continue;   //Time out to look at stop_
+        }
+        ssize_t n = read(fd, buffer.data(), buffer.size());
+        if(n<0 && (errno==EINTR || errno==EAGAIN)){
+            continue;
+        }
+        if(n<0 || (n==0 && ends)){
+            break;
+        }
+        uint64_t start = NowNs();
+        uint64_t heard = WallNs();
+        uint64_t frames = 0;
+        uint64_t stall = 0;
+        parser.Feed(buffer.data(), n, [&](const uint8_t* payload, size_t length, uint8_t rssi, int8_t snr){
+            if(length!=kFrameLength){
+                stats_.otherPackets.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            RxFrame frame;
+            frame.timeNs = heard;
+            frame.ingestNs = start;
+            frame.receiver = (uint16_t)index;
+            frame.rssi = rssi;
+            frame.snr = snr;
+            std::memcpy(frame.payload, payload, kFrameLength);
+            if(capture){
+                captured.push_back(frame);
+            }
+            Backoff backoff;
+            uint64_t wait = 0;
+            while(!frames_.TryPush(frame)){
+                if(!wait){
+                    wait = NowNs();
+                }
+                backoff.Wait();
+            }
+            if(wait){
+                stall += NowNs()-wait;
+            }
+            frames++;
+        });
+        if(!captured.empty()){
+            Record(captured);
+        }
+        stats_.badChecksums.fetch_add(parser.BadChecksums()-badChecksums, std::memory_order_relaxed);
+        badChecksums = parser.BadChecksums();
+        stats_.read.stallNs.fetch_add(stall, std::memory_order_relaxed);
+        stats_.read.items.fetch_add(frames, std::memory_order_relaxed);
+        stats_.read.batches.fetch_add(1, std::memory_order_relaxed);
+        stats_.read.busyNs.fetch_add(NowNs()-start-stall, std::memory_order_relaxed);
+    }
+    close(fd);
+    readersRunning_--;
+}
+
+void Pipeline::Record(std::vector<RxFrame>& frames){
+    std::lock_guard<std::mutex> lock(captureLock_);
+    bool ok = true;
+    for(const RxFrame& frame : frames){
+        ok &= capture_.Append(frame);
+    }
+    //Written a block at a time, and at least every flushSeconds
+    uint64_t now = NowNs();
+    if(now-captureFlushNs_>=config_.flushSeconds*1000000000ull){
+        ok &= capture_.Flush();
+        captureFlushNs_ = now;
+    }
+    if(!ok){
+        stats_.captureErrors.fetch_add(1, std::memory_order_relaxed);
+    }
+    frames.clear();
+}
+
+void Pipeline::Decoder(){
+    Backoff backoff;
+    for(;;){
+        Batch* b;
+        uint64_t wait = NowNs();
+        while(!free_.TryPop(b)){
+            backoff.Wait();     //Every batch is downstream, the later stages are behind
+        }
+        stats_.decode.stallNs.fetch_add(NowNs()-wait, std::memory_order_relaxed);
+        backoff.Reset();
+        size_t n = 0;
+        uint64_t deadline = 0;
+        while(n<config_.batch){
+            bool done = inputDone_.load(std::memory_order_acquire);
+            if(frames_.TryPop(b->frames[n])){
+                if(n++==0){
+                    deadline = NowNs()+config_.batchWaitUs*1000ull;
+                }
+                backoff.Reset();
+                continue;
+            }
+            if(done || (n>0 && NowNs()>=deadline)){
+                break;
+            }
+            backoff.Wait();
+        }
+        if(n==0){
+            free_.TryPush(b);
+            return; //Only an empty queue after the readers have finished gets here
+        }
+        uint64_t start = NowNs();
+        b->frameCount = n;
+        const ReadingColumns& c = b->columns.Columns();
+        size_t good = DecodeFrames(b->frames[0].payload, n, sizeof(RxFrame), c);
+        for(size_t i=0;i<n;i++){
+            b->time[i] = (uint32_t)(b->frames[i].timeNs/1000000000ull);
+        }
+        size_t keep = nodes_.Track(c, b->time.data(), 0, n, b->sequence.data());
+        //Log packet records after the frames, once the frames have moved the
+        //nodes on, at the times their counts were due
+        size_t logs = 0;
+        size_t rows = n;
+        for(size_t i=0;i<n;i++){
+            if(!IsLogFrame(c.status[i], c.id1[i])){
+                continue;
+            }
+            logs++;
+            size_t records = DecodeLogFrame(b->frames[i].payload, c, rows);
+            for(size_t k=rows;k<rows+records;k++){
+                b->frameOf[k] = (uint32_t)i;
+                b->time[k] = nodes_.CountTime(c.address[k], c.count[k], b->time[i]);
+            }
+            rows += records;
+        }
+        b->rows = rows;
+        size_t keepLogged = nodes_.Track(c, b->time.data(), n, rows-n, b->sequence.data());
+        stats_.logPackets.fetch_add(logs, std::memory_order_relaxed);
+        stats_.logRecords.fetch_add(keepLogged, std::memory_order_relaxed);
+        stats_.badFrames.fetch_add(n-good-logs, std::memory_order_relaxed);
+        stats_.duplicates.fetch_add(good-keep+rows-n-keepLogged, std::memory_order_relaxed);
+        Busy(stats_.decode, n, start);
+        Push(decoded_, b, stats_.decode);
+    }
+}
+
+void Pipeline::Calibrator(){
+    Backoff backoff;
+    for(;;){
+        bool done = decodeDone_.load(std::memory_order_acquire);
+        Batch* b;
+        if(!decoded_.TryPop(b)){
+            if(done){
+                return;
+            }
+            backoff.Wait();
+            continue;
+        }
+        backoff.Reset();
+        uint64_t start = NowNs();
+        const ReadingColumns& c = b->columns.Columns();
+        //Log records keep the top 10 bits of battery and temperature
+        for(size_t i=b->frameCount;i<b->rows;i++){
+            unsigned shift = config_.calibration.Get(c.address[i]).adcBits-10;
+            c.batt[i] = (uint16_t)(c.batt[i]<<shift);
+            c.temp[i] = (uint16_t)(c.temp[i]<<shift);
+        }
+        Calibrate(c, 0, b->rows, config_.calibration, b->out);
+        if(config_.readings){
+            for(size_t i=0;i<b->rows;i++){
+                if(!b->Keep(i)){
+                    continue;
+                }
+                const RxFrame& f = b->Frame(i);
+                std::fprintf(config_.readings, "%u,%016llX,%u,%.1f,%.2f,%.2f,%.2f,%.3f,%.1f,%.3f,%.2f,%d\n", b->time[i],
+                             (unsigned long long)c.address[i], c.count[i], RssiDbm(f.rssi, f.snr), f.snr*0.25f,
+                             b->out.uva[i], b->out.uvb[i], b->out.uvIndex[i], b->out.lux[i], b->out.battery[i],
+                             b->out.temperature[i], i>=b->frameCount);
+            }
+        }
+        Busy(stats_.calibrate, b->rows, start);
+        Push(calibrated_, b, stats_.calibrate);
+    }
+}
+
+void Pipeline::Storer(){
+    Backoff backoff;
+    uint64_t flushNs = config_.flushSeconds*1000000000ull;
+    uint64_t lastFlush = NowNs();
+    for(;;){
+        bool done = calibrateDone_.load(std::memory_order_acquire);
+        Batch* b;
+        if(store_ && NowNs()-lastFlush>=flushNs){
+            if(!store_->Flush()){
+                stats_.storeErrors++;
+            }
+            lastFlush = NowNs();
+        }
+        if(!calibrated_.TryPop(b)){
+            if(done){
+                return;
+            }
+            backoff.Wait();
+            continue;
+        }
+        backoff.Reset();
+        uint64_t start = NowNs();
+        const ReadingColumns& c = b->columns.Columns();
+        size_t kept = 0;
+        for(size_t i=0;i<b->rows;i++){
+            if(!b->Keep(i)){
+                continue;
+            }
+            kept++;
+            if(store_){
+                Sample s = {{b->time[i], c.count[i], c.batt[i], c.temp[i], c.v1[i], c.v2[i], c.uva[i], c.uvb[i],
+                             c.comp1[i], c.comp2[i], c.vis[i], i>=b->frameCount ? kSampleTimeFromCount : 0}};
+                if(!store_->Append(c.address[i], s)){
+                    stats_.storeErrors++;
+                }
+            }
+        }
+        uint64_t now = NowNs();
+        for(size_t i=0;i<b->frameCount;i++){
+            uint64_t latency = now-b->frames[i].ingestNs;
+            uint64_t us = latency/1000;
+            int bucket = us ? 64-__builtin_clzll(us) : 0;
+            stats_.latency[bucket<kLatencyBuckets ? bucket : kLatencyBuckets-1]++;
+            uint64_t max = stats_.maxLatencyNs.load(std::memory_order_relaxed);
+            if(latency>max){
+                stats_.maxLatencyNs.store(latency, std::memory_order_relaxed);
+            }
+        }
+        Busy(stats_.store, kept, start);
+        free_.TryPush(b);
+    }
+}
+
+void Pipeline::PrintStats(FILE* out, double seconds) const{
+    const StageStats* stages[] = {&stats_.read, &stats_.decode, &stats_.calibrate, &stats_.store};
+    const char* names[] = {"read", "decode", "calibrate", "store"};
+    size_t queued[] = {frames_.Size(), decoded_.Size(), calibrated_.Size(), 0};
+    std::fprintf(out, "%-10s %12s %10s %12s %8s %9s %9s %7s\n", "stage", "items", "batches", "items/s", "ns/item",
+                 "busy %", "stall %", "queued");
+    for(int i=0;i<4;i++){
+        const StageStats& s = *stages[i];
+        double items = (double)s.items.load();
+        double busy = s.busyNs.load()*1e-9;
+        std::fprintf(out, "%-10s %12.0f %10llu %12.0f %8.0f %9.1f %9.1f %7zu\n", names[i], items,
+                     (unsigned long long)s.batches.load(), seconds>0 ? items/seconds : 0.0,
+                     items ? busy*1e9/items : 0.0, seconds>0 ? busy/seconds*100 : 0.0,
+                     seconds>0 ? s.stallNs.load()*1e-9/seconds*100 : 0.0, queued[i]);
+    }
+    NodeStats n = nodes_.Totals();
+    std::fprintf(out, "frames: %llu bad checksum, %llu other, %llu bad, %llu log (%llu records), %llu duplicate, "
+                 "%llu store errors, %llu capture errors\n",
+                 (unsigned long long)stats_.badChecksums.load(), (unsigned long long)stats_.otherPackets.load(),
+                 (unsigned long long)stats_.badFrames.load(), (unsigned long long)stats_.logPackets.load(),
+                 (unsigned long long)stats_.logRecords.load(),
+                 (unsigned long long)stats_.duplicates.load(),
+                 (unsigned long long)stats_.storeErrors.load(), (unsigned long long)stats_.captureErrors.load());
+    std::fprintf(out, "nodes: %zu, %lld lost, %llu late, %llu gaps, %llu reboots\n",
+                 nodes_.Nodes(), (long long)n.lost, (unsigned long long)n.late,
+                 (unsigned long long)n.gaps, (unsigned long long)n.reboots);
+    std::fprintf(out, "latency: p50 < %llu us, p99 < %llu us, max %.0f us\n",
+                 (unsigned long long)stats_.LatencyPercentile(0.5), (unsigned long long)stats_.LatencyPercentile(0.99),
+                 stats_.maxLatencyNs.load()*1e-3);
+}
+
+} // namespace gateway
@@ -0,0 +1,153 @@
+/*
+ * File:   pipeline.h
+ * Author: Andy Page
+ * Comments: Gateway ingest, from receiver streams to the store:
+ *
+ *           readers       one thread per source, parse receiver frames,
+ *                         optionally recording them to a capture
+ *             | frame queue (RxFrame)
+ *           decode        workers take up to batch frames, check the CRCs
+ *                         and decode them (DecodeFrames), add rows for
+ *                         log packet records (DecodeLogFrame, timed from
+ *                         their counts) and drop duplicates (NodeTable)
+ *             | batch queue
+ *           calibrate     engineering units (Calibrate), optional CSV out
+ *             | batch queue
+ *           store         appends the kept rows to the store, recycles
+ *                         the batch
+ *
+ *           Queues are BoundedQueue and batches come from a fixed pool, so
+ *           memory is fixed and a slow stage stalls the ones before it back
+ *           to the readers, where a serial port or socket buffers and a
+ *           file simply reads slower.  A worker waits at most batchWaitUs
+ *           for a batch to fill, so a quiet network still sees each frame
+ *           stored promptly.  Each stage counts items, batches, busy time
+ *           and time stalled on the next stage, and the store stage keeps a
+ *           histogram of time from entering the gateway to being stored.
+ * Revision history: 1, 19th October 2026
+ */
+
+#ifndef INC_GATEWAY_PIPELINE_H
+#define INC_GATEWAY_PIPELINE_H
+
+#include "calibrate.h"
+#include "capture.h"
+#include "nodes.h"
+#include "queue.h"
+#include "receiver.h"
+#include "store.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gateway {
+
+struct PipelineConfig {
+    std::vector<std::string> sources;   //See OpenReceiverSource(), at most one file
+    std::string storeRoot;              //Empty for no store
+    size_t workers = 2;                 //Decode workers
+    size_t batch = 64;                  //Most frames in a batch
+    unsigned batchWaitUs = 2000;        //Longest a worker waits to fill a batch
+    size_t queueFrames = 16384;         //Frame queue
+    size_t batches = 64;                //Batches in flight
+    unsigned flushSeconds = 60;         //Store flush interval
+    FILE* readings = nullptr;           //Calibrated readings as CSV, optional
+    std::string capture;                //Records every frame read, see capture.h
+    CalibrationTable calibration;
+};
+
+struct StageStats {
+    std::atomic<uint64_t> items{0};
+    std::atomic<uint64_t> batches{0};
+    std::atomic<uint64_t> busyNs{0};    //Working on items
+    std::atomic<uint64_t> stallNs{0};   //Waiting for room in the next stage
+};
+
+constexpr int kLatencyBuckets = 32;     //Bucket i holds latencies under 2^i us
+
+struct PipelineStats {
+    StageStats read, decode, calibrate, store;
+    std::atomic<uint64_t> badChecksums{0};  //Receiver frames
+    std::atomic<uint64_t> otherPackets{0};  //Good receiver frames that are not 50 bytes
+    std::atomic<uint64_t> badFrames{0};     //Bad CRC16, length, ID1 or version
+    std::atomic<uint64_t> logPackets{0};    //Good log packets (see frame.h)
+    std::atomic<uint64_t> logRecords{0};    //Their records kept, the rest are in duplicates
+    std::atomic<uint64_t> duplicates{0};
+    std::atomic<uint64_t> storeErrors{0};
+    std::atomic<uint64_t> captureErrors{0};
+    std::atomic<uint64_t> latency[kLatencyBuckets] = {};
+    std::atomic<uint64_t> maxLatencyNs{0};
+
+    //Upper bound of the bucket holding fraction of the frames stored, us
+    uint64_t LatencyPercentile(double fraction) const;
+};
+
+class Pipeline {
+public:
+    explicit Pipeline(const PipelineConfig& config);
+    ~Pipeline();
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    //Opens the sources and starts every stage
+    bool Start(std::string& error);
+
+    /**
+     * Puts a frame in the frame queue as a reader would, waiting while it
+     * is full (for replaying captures).  ingestNs is set here.
+     */
+    void Submit(RxFrame frame);
+
+    //Asks readers of endless sources to stop, safe from a signal handler
+    void RequestStop() { stop_.store(true, std::memory_order_relaxed); }
+    //True once every reader has finished
+    bool InputDone() const { return readersRunning_.load()==0; }
+
+    /**
+     * Waits for the readers, then drains and stops every stage and
+     * flushes the store.  Call Submit() only before this.
+     */
+    void Finish();
+
+    const PipelineStats& Stats() const { return stats_; }
+    NodeTable& Nodes() { return nodes_; }
+    void PrintStats(FILE* out, double seconds) const;
+
+private:
+    struct Batch;
+    void Reader(size_t index, int fd, bool ends);
+    void Record(std::vector<RxFrame>& frames);
+    void Decoder();
+    void Calibrator();
+    void Storer();
+    void Push(BoundedQueue<Batch*>& queue, Batch* batch, StageStats& stage);
+
+    PipelineConfig config_;
+    PipelineStats stats_;
+    NodeTable nodes_;
+    BoundedQueue<RxFrame> frames_;
+    BoundedQueue<Batch*> free_;
+    BoundedQueue<Batch*> decoded_;
+    BoundedQueue<Batch*> calibrated_;
+    std::vector<std::unique_ptr<Batch>> pool_;
+    std::unique_ptr<StoreWriter> store_;
+    CaptureWriter capture_;
+    std::mutex captureLock_;
+    uint64_t captureFlushNs_ = 0;
+    std::vector<std::thread> readers_, decoders_;
+    std::thread calibrator_, storer_;
+    std::atomic<bool> stop_{false};
+    std::atomic<int> readersRunning_{0};
+    std::atomic<bool> inputDone_{false}, decodeDone_{false}, calibrateDone_{false};
+    bool started_ = false;
+};
+
+} // namespace gateway
+
+#endif /* INC_GATEWAY_PIPELINE_H */
@@ -0,0 +1,135 @@
+/*
+ * File:   queue.h
+ * Author: Andy Page
+ * Comments: Bounded multi producer, multi consumer queue (Dmitry Vyukov's
+ *           array queue).  Each cell carries a sequence number that says
+ *           whether it is ready to be written or read on the current lap,
+ *           so producers and consumers only contend on their own index with
+ *           one compare and swap, and nothing is allocated after
+ *           construction.  TryPush() fails when the queue is full, which is
+ *           how the pipeline stages push back on the ones before them.
+ * Revision history: 1, 19th October 2026
+ */
+
+#ifndef INC_GATEWAY_QUEUE_H
+#define INC_GATEWAY_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace gateway {
+
+template <typename T>
+class BoundedQueue {
+public:
+    /**
+     * @param capacity  Rounded up to a power of two, at least 2
+     */
+    explicit BoundedQueue(size_t capacity){
+        size_t size = 2;
+        while(size<capacity){
+            size <<= 1;
+        }
+        mask_ = size-1;
+        cells_.reset(new Cell[size]);
+        for(size_t i=0;i<size;i++){
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+    }
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    bool TryPush(const T& value){
+        size_t position = tail_.load(std::memory_order_relaxed);
+        for(;;){
+            Cell& cell = cells_[position & mask_];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t lap = (intptr_t)sequence-(intptr_t)position;
+            if(lap==0){
+                if(tail_.compare_exchange_weak(position, position+1, std::memory_order_relaxed)){
+                    cell.value = value;
+                    cell.sequence.store(position+1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if(lap<0){
+                return false;   //Full
+            }
+            else{
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool TryPop(T& value){
+        size_t position = head_.load(std::memory_order_relaxed);
+        for(;;){
+            Cell& cell = cells_[position & mask_];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t lap = (intptr_t)sequence-(intptr_t)(position+1);
+            if(lap==0){
+                if(head_.compare_exchange_weak(position, position+1, std::memory_order_relaxed)){
+                    value = cell.value;
+                    cell.sequence.store(position+mask_+1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if(lap<0){
+                return false;   //Empty
+            }
+            else{
+                position = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    //Approximate while other threads are using it
+    size_t Size() const{
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t head = head_.load(std::memory_order_relaxed);
+        return tail>head ? tail-head : 0;
+    }
+    size_t Capacity() const { return mask_+1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> head_;
+    alignas(64) std::atomic<size_t> tail_;
+};
+
+/**
+ * Waiting on a full or empty queue: spin a little, then yield, then sleep
+ * so an idle stage costs next to nothing.
+ */
+class Backoff {
+public:
+    void Wait(){
+        if(++rounds_<64){
+            return;
+        }
+        if(rounds_<128){
+            std::this_thread::yield();
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    void Reset(){ rounds_ = 0; }
+
+private:
+    unsigned rounds_ = 0;
+};
+
+} // namespace gateway
+
+#endif /* INC_GATEWAY_QUEUE_H */
@@ -0,0 +1,134 @@
+/**
+ * receiver.cpp
+ * Receiver stream encoding and sources, see receiver.h.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include "receiver.h"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace gateway {
+
+namespace {
+
+speed_t BaudConstant(long baud){
+    switch(baud){
+    case 9600: return B9600;
+    case 19200: return B19200;
+    case 38400: return B38400;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    case 921600: return B921600;
+    default: return 0;
+    }
+}
+
+int OpenSerial(const std::string& spec, std::string& error){
+    std::string path = spec;
+    long baud = 115200;
+    size_t colon = spec.rfind(':');
+    if(colon!=std::string::npos){
+        path = spec.substr(0, colon);
+        baud = std::strtol(spec.c_str()+colon+1, nullptr, 10);
+    }
+    speed_t speed = BaudConstant(baud);
+    if(!speed){
+        error = "unsupported baud rate in "+spec;
+        return -1;
+    }
+    int fd = open(path.c_str(), O_RDONLY | O_NOCTTY);
+    if(fd<0){
+        error = path+": "+std::strerror(errno);
+        return -1;
+    }
+    struct termios tty;
+    if(tcgetattr(fd, &tty)!=0){
+        error = path+": "+std::strerror(errno);
+        close(fd);
+        return -1;
+    }
+    cfmakeraw(&tty);
+    cfsetispeed(&tty, speed);
+    cfsetospeed(&tty, speed);
+    tty.c_cflag |= CLOCAL | CREAD;
+    tty.c_cc[VMIN] = 0;     //read() returns what has arrived within 0.1s
+    tty.c_cc[VTIME] = 1;
+    if(tcsetattr(fd, TCSANOW, &tty)!=0){
+        error = path+": "+std::strerror(errno);
+        close(fd);
+        return -1;
+    }
+    tcflush(fd, TCIFLUSH);
+    return fd;
+}
+
+int OpenUdp(const std::string& port, std::string& error){
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if(fd<0){
+        error = std::string("socket: ")+std::strerror(errno);
+        return -1;
+    }
+    int size = 4<<20;   //Room for bursts while the pipeline pushes back
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof size);
+    struct sockaddr_in address;
+    std::memset(&address, 0, sizeof address);
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons((uint16_t)std::atoi(port.c_str()));
+    if(bind(fd, (struct sockaddr*)&address, sizeof address)!=0){
+        error = "udp:"+port+": "+std::strerror(errno);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+} // namespace
+
+size_t ReceiverEncode(const uint8_t* payload, uint8_t length, uint8_t rssi, int8_t snr, uint8_t* out){
+    uint8_t sum = length+rssi+(uint8_t)snr;
+    out[0] = kReceiverSync0;
+    out[1] = kReceiverSync1;
+    out[2] = length;
+    out[3] = rssi;
+    out[4] = (uint8_t)snr;
+    for(size_t i=0;i<length;i++){
+        out[5+i] = payload[i];
+        sum += payload[i];
+    }
+    out[5+length] = sum;
+    return length+kReceiverOverhead;
+}
+
+int OpenReceiverSource(const std::string& spec, std::string& error){
+    if(spec.compare(0, 7, "serial:")==0){
+        return OpenSerial(spec.substr(7), error);
+    }
+    if(spec.compare(0, 4, "udp:")==0){
+        return OpenUdp(spec.substr(4), error);
+    }
+    std::string path = spec.compare(0, 5, "file:")==0 ? spec.substr(5) : spec;
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd<0){
+        error = path+": "+std::strerror(errno);
+    }
+    return fd;
+}
+
+bool ReceiverSourceEnds(const std::string& spec){
+    return spec.compare(0, 7, "serial:")!=0 && spec.compare(0, 4, "udp:")!=0;
+}
+
+} // namespace gateway
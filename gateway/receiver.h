@@ -0,0 +1,167 @@
+/*
+ * File:   receiver.h
+ * Author: Andy Page
+ * Comments: The byte stream from a base receiver (receiver.h in the
+ *           firmware), one frame per packet heard:
+ *
+ *           0x55 0xAA  Sync
+ *           N          Payload length
+ *           RSSI       PKT_RSSI_VALUE
+ *           SNR        PKT_SNR_VALUE, signed quarter dB
+ *           Payload    N bytes, CRC16 included
+ *           Checksum   Sum of N, RSSI, SNR and the payload, modulo 256
+ *
+ *           ReceiverParser finds the frames in a stream read in any sized
+ *           pieces, skipping to the next sync after a bad checksum.
+ *           Streams come from a receiver's serial port or, for testing and
+ *           for receivers on other machines, a UDP port or a file.
+ * Revision history: 1, 19th October 2026
+ */
+
+#ifndef INC_GATEWAY_RECEIVER_H
+#define INC_GATEWAY_RECEIVER_H
+
+#include "frame.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace gateway {
+
+constexpr uint8_t kReceiverSync0 = 0x55;
+constexpr uint8_t kReceiverSync1 = 0xAA;
+constexpr size_t kReceiverMinPacket = 3;        //Length byte and CRC16
+constexpr size_t kReceiverOverhead = 6;         //Sync, N, RSSI, SNR and checksum
+
+/**
+ * A v5 packet as it entered the gateway.
+ */
+struct RxFrame {
+    uint64_t timeNs;        //Unix time heard (or captured)
+    uint64_t ingestNs;      //Steady clock when it entered the gateway, for latency
+    uint16_t receiver;      //Index of the source it came from
+    uint8_t rssi;
+    int8_t snr;
+    uint8_t payload[kFrameLength];
+};
+
+//Packet RSSI in dBm from the SX1276 registers (HF port)
+inline float RssiDbm(uint8_t rssi, int8_t snr){
+    return rssi-157.0f+(snr<0 ? snr*0.25f : 0.0f);
+}
+
+/**
+ * Writes one packet in the receiver's frame format.
+ * @param out   Room for length+kReceiverOverhead bytes
+ * @return Bytes written
+ */
+size_t ReceiverEncode(const uint8_t* payload, uint8_t length, uint8_t rssi, int8_t snr, uint8_t* out);
+
+class ReceiverParser {
+public:
+    /**
+     * Parses the next piece of the stream, calling
+     * sink(payload, length, rssi, snr) for each frame with a good checksum.
+     */
+    template <typename Sink>
+    void Feed(const uint8_t* data, size_t n, Sink sink){
+        for(size_t i=0;i<n;i++){
+            uint8_t b = data[i];
+            switch(state_){
+            case kSync0:
+                if(b==kReceiverSync0){
+                    state_ = kSync1;
+                }
+                else{
+                    skipped_++;
+                }
+                break;
+            case kSync1:
+                if(b==kReceiverSync1){
+                    state_ = kLength;
+                }
+                else if(b!=kReceiverSync0){
+                    skipped_ += 2;
+                    state_ = kSync0;
+                }
+                else{
+                    skipped_++;
+                }
+                break;
+            case kLength:
+                if(b<kReceiverMinPacket){
+                    skipped_ += 3;
+                    state_ = b==kReceiverSync0 ? kSync1 : kSync0;
+                    break;
+                }
+                length_ = b;
+                sum_ = b;
+                state_ = kRssi;
+                break;
+            case kRssi:
+                rssi_ = b;
+                sum_ += b;
+                state_ = kSnr;
+                break;
+            case kSnr:
+                snr_ = (int8_t)b;
+                sum_ += b;
+                index_ = 0;
+                state_ = kPayload;
+                break;
+            case kPayload:
+                payload_[index_++] = b;
+                sum_ += b;
+                if(index_==length_){
+                    state_ = kChecksum;
+                }
+                break;
+            case kChecksum:
+                state_ = kSync0;
+                if(b==sum_){
+                    frames_++;
+                    sink((const uint8_t*)payload_, (size_t)length_, rssi_, snr_);
+                }
+                else{
+                    badChecksums_++;
+                    skipped_ += length_+kReceiverOverhead;
+                }
+                break;
+            }
+        }
+    }
+
+    uint64_t Frames() const { return frames_; }
+    uint64_t BadChecksums() const { return badChecksums_; }
+    uint64_t Skipped() const { return skipped_; }  //Bytes outside good frames
+
+private:
+    enum State : uint8_t { kSync0, kSync1, kLength, kRssi, kSnr, kPayload, kChecksum };
+    State state_ = kSync0;
+    uint8_t length_ = 0;
+    uint8_t rssi_ = 0;
+    int8_t snr_ = 0;
+    uint8_t sum_ = 0;
+    size_t index_ = 0;
+    uint8_t payload_[255];
+    uint64_t frames_ = 0;
+    uint64_t badChecksums_ = 0;
+    uint64_t skipped_ = 0;
+};
+
+/**
+ * Opens a receiver stream:
+ *   serial:/dev/ttyUSB0[:baud]     A base receiver, raw at 115200 by default
+ *   udp:port                       Datagrams of receiver stream on any address
+ *   file:path or path              A recorded stream, read to the end
+ * @return File descriptor, or -1 with error set
+ */
+int OpenReceiverSource(const std::string& spec, std::string& error);
+
+//True if spec reads to an end (a file)
+bool ReceiverSourceEnds(const std::string& spec);
+
+} // namespace gateway
+
+#endif /* INC_GATEWAY_RECEIVER_H */
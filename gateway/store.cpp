@@ -0,0 +1,636 @@
+/**
+ * store.cpp
+ * Columnar store, see store.h.  Column file layout:
+ *   header   "UVSTORE1", uint32 field, uint32 kStoreBlockSamples
+ *   blocks   StoreBlock (32 bytes) then its payload, repeated
+ * and tail.smp:
+ *   header   "UVSTAIL1", uint64 index of its first sample
+ *   samples  Sample (48 bytes), repeated
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include "store.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace gateway {
+
+const char* const kFieldNames[kFields] = {"time", "count", "batt", "temp", "v1", "v2", "uva", "uvb", "comp1", "comp2",
+                                          "vis", "flags"};
+
+namespace {
+
+constexpr char kMagic[8] = {'U', 'V', 'S', 'T', 'O', 'R', 'E', '1'};
+constexpr char kTailMagic[8] = {'U', 'V', 'S', 'T', 'A', 'I', 'L', '1'};
+constexpr size_t kFileHeader = 16;
+constexpr uint32_t kMaxBits = 33;   //uint32 differences less their minimum
+
+static_assert(sizeof(StoreBlock)==32, "block header is stored as is");
+static_assert(sizeof(Sample)==48, "tail samples are stored as is");
+
+std::string NodeDir(const std::string& root, uint64_t address){
+    char name[17];
+    std::snprintf(name, sizeof name, "%016llX", (unsigned long long)address);
+    return root+"/"+name;
+}
+
+std::string ColumnPath(const std::string& dir, int field){
+    return dir+"/"+kFieldNames[field]+".col";
+}
+
+std::string TailPath(const std::string& dir){
+    return dir+"/tail.smp";
+}
+
+bool WriteAll(int fd, const void* data, size_t length){
+    const uint8_t* p = (const uint8_t*)data;
+    while(length){
+        ssize_t done = write(fd, p, length);
+        if(done<0){
+            if(errno==EINTR){
+                continue;
+            }
+            return false;
+        }
+        p += done;
+        length -= done;
+    }
+    return true;
+}
+
+/**
+ * Checks the block header at offset and that its payload is all there.
+ */
+bool ValidBlock(const uint8_t* map, size_t length, size_t offset){
+    if(offset+sizeof(StoreBlock)>length){
+        return false;
+    }
+    StoreBlock b;
+    std::memcpy(&b, map+offset, sizeof b);
+    if(b.count==0 || b.count>kStoreBlockSamples || b.bits>kMaxBits){
+        return false;
+    }
+    size_t bytes = ((size_t)(b.count-1)*b.bits+63)/64*8;
+    return b.bytes==bytes && offset+sizeof(StoreBlock)+bytes<=length;
+}
+
+/**
+ * Offsets of the complete blocks in a column file.
+ */
+std::vector<size_t> IndexBlocks(const uint8_t* map, size_t length){
+    std::vector<size_t> offsets;
+    if(length<kFileHeader || std::memcmp(map, kMagic, sizeof kMagic)!=0){
+        return offsets;
+    }
+    size_t offset = kFileHeader;
+    while(ValidBlock(map, length, offset)){
+        offsets.push_back(offset);
+        StoreBlock b;
+        std::memcpy(&b, map+offset, sizeof b);
+        offset += sizeof(StoreBlock)+b.bytes;
+    }
+    return offsets;
+}
+
+/**
+ * The samples of a node's tail file that are not in its blocks, whole ones
+ * only.  A crash after writing a block but before the tail was started
+ * again leaves the block's samples at the front of it.
+ * @param stored    Samples in the node's blocks
+ */
+std::vector<Sample> ReadTail(const std::string& dir, uint64_t stored){
+    std::vector<Sample> samples;
+    int fd = open(TailPath(dir).c_str(), O_RDONLY);
+    if(fd<0){
+        return samples;
+    }
+    struct stat s;
+    uint8_t header[kFileHeader];
+    if(fstat(fd, &s)==0 && s.st_size>=(off_t)kFileHeader && pread(fd, header, sizeof header, 0)==sizeof header &&
+       std::memcmp(header, kTailMagic, sizeof kTailMagic)==0){
+        uint64_t start;
+        std::memcpy(&start, header+sizeof kTailMagic, sizeof start);
+        size_t n = (s.st_size-kFileHeader)/sizeof(Sample);
+        size_t skip = stored>start ? (size_t)std::min<uint64_t>(n, stored-start) : 0;
+        samples.resize(std::min(n-skip, (size_t)kStoreBlockSamples));
+        size_t bytes = samples.size()*sizeof(Sample);
+        if(pread(fd, samples.data(), bytes, kFileHeader+skip*sizeof(Sample))!=(ssize_t)bytes){
+            samples.clear();
+        }
+    }
+    close(fd);
+    return samples;
+}
+
+/**
+ * Encodes n values as a block header and payload into out.
+ */
+void Encode(const uint32_t* values, uint32_t n, std::vector<uint64_t>& out){
+    StoreBlock b;
+    b.count = n;
+    b.first = values[0];
+    b.min = b.max = values[0];
+    b.minDelta = 0;
+    int64_t maxDelta = 0;
+    for(uint32_t i=1;i<n;i++){
+        b.min = std::min(b.min, values[i]);
+        b.max = std::max(b.max, values[i]);
+        int64_t delta = (int64_t)values[i]-values[i-1];
+        if(i==1 || delta<b.minDelta){
+            b.minDelta = delta;
+        }
+        if(i==1 || delta>maxDelta){
+            maxDelta = delta;
+        }
+    }
+    uint64_t range = (uint64_t)(maxDelta-b.minDelta);
+    b.bits = range ? 64-__builtin_clzll(range) : 0;
+    b.bytes = (uint32_t)(((size_t)(n-1)*b.bits+63)/64*8);
+    out.assign(sizeof(StoreBlock)/8+b.bytes/8, 0);
+    std::memcpy(out.data(), &b, sizeof b);
+    if(b.bits==0){
+        return;
+    }
+    uint64_t* payload = out.data()+sizeof(StoreBlock)/8;
+    size_t position = 0;
+    for(uint32_t i=1;i<n;i++,position+=b.bits){
+        uint64_t packed = (uint64_t)((int64_t)values[i]-values[i-1]-b.minDelta);
+        size_t word = position>>6;
+        unsigned shift = position & 63;
+        payload[word] |= packed<<shift;
+        if(shift+b.bits>64){
+            payload[word+1] |= packed>>(64-shift);
+        }
+    }
+}
+
+/**
+ * Blocks of zeros holding counts[k] values each, back to back, for a column
+ * added after a node's other columns were written (flags).
+ * @param offsets   Of each block
+ */
+std::vector<uint64_t> ZeroBlocks(const std::vector<uint32_t>& counts, std::vector<size_t>& offsets){
+    std::vector<uint64_t> blocks;
+    std::vector<uint32_t> zeros(kStoreBlockSamples, 0);
+    std::vector<uint64_t> block;
+    offsets.clear();
+    for(uint32_t n : counts){
+        Encode(zeros.data(), n, block);
+        offsets.push_back(blocks.size()*8);
+        blocks.insert(blocks.end(), block.begin(), block.end());
+    }
+    return blocks;
+}
+
+} // namespace
+
+struct StoreWriter::Node {
+    std::string dir;
+    std::vector<uint32_t> pending[kFields];
+    uint64_t stored = 0;        //Samples in blocks
+    size_t written = 0;         //Pending samples in the tail file
+};
+
+StoreWriter::StoreWriter(const std::string& root) : root_(root){
+    mkdir(root_.c_str(), 0755);
+}
+
+StoreWriter::~StoreWriter(){
+    Flush();
+}
+
+StoreWriter::Node& StoreWriter::Open(uint64_t address){
+    std::unique_ptr<Node>& node = nodes_[address];
+    if(node){
+        return *node;
+    }
+    node.reset(new Node);
+    node->dir = NodeDir(root_, address);
+    mkdir(node->dir.c_str(), 0755);
+    for(std::vector<uint32_t>& column : node->pending){
+        column.reserve(kStoreBlockSamples);
+    }
+    //Columns are written time last, so after a crash some may have one more
+    //block than others or a torn block at the end.  Cut them to the blocks
+    //that all of them have.
+    std::vector<size_t> ends[kFields];
+    std::vector<uint32_t> counts;   //Of the time blocks
+    bool missing[kFields] = {};     //Column added since, filled with zeros
+    size_t blocks = SIZE_MAX;
+    for(int field=0;field<kFields;field++){
+        int fd = open(ColumnPath(node->dir, field).c_str(), O_RDONLY);
+        if(fd<0 && errno==ENOENT && field!=kFieldTime){
+            missing[field] = true;
+            continue;
+        }
+        struct stat s;
+        if(fd>=0 && fstat(fd, &s)==0 && s.st_size>0){
+            void* map = mmap(nullptr, s.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(map!=MAP_FAILED){
+                std::vector<size_t> offsets = IndexBlocks((const uint8_t*)map, s.st_size);
+                for(size_t offset : offsets){
+                    StoreBlock b;
+                    std::memcpy(&b, (const uint8_t*)map+offset, sizeof b);
+                    ends[field].push_back(offset+sizeof(StoreBlock)+b.bytes);
+                    if(field==kFieldTime){
+                        counts.push_back(b.count);
+                    }
+                }
+                munmap(map, s.st_size);
+            }
+        }
+        if(fd>=0){
+            close(fd);
+        }
+        blocks = std::min(blocks, ends[field].size());
+    }
+    for(int field=0;field<kFields;field++){
+        std::string path = ColumnPath(node->dir, field);
+        int fd = open(path.c_str(), O_WRONLY | O_CREAT, 0644);
+        if(fd<0){
+            continue;
+        }
+        uint32_t header[4];
+        std::memcpy(header, kMagic, sizeof kMagic);
+        header[2] = field;
+        header[3] = kStoreBlockSamples;
+        if(blocks==0 || missing[field]){
+            if(ftruncate(fd, 0)==0){
+                WriteAll(fd, header, sizeof header);
+            }
+            if(missing[field] && blocks!=SIZE_MAX && blocks){
+                std::vector<size_t> offsets;
+                counts.resize(blocks);
+                std::vector<uint64_t> zeros = ZeroBlocks(counts, offsets);
+                if(!WriteAll(fd, zeros.data(), zeros.size()*8)){
+                    std::perror(path.c_str());
+                }
+            }
+        }
+        else if(ftruncate(fd, ends[field][blocks-1])!=0){
+            std::perror(path.c_str());
+        }
+        close(fd);
+    }
+    //Carry on from the tail, rewritten so it starts at the blocks and ends
+    //on a whole sample
+    for(size_t k=0;k<blocks;k++){
+        node->stored += counts[k];
+    }
+    for(const Sample& s : ReadTail(node->dir, node->stored)){
+        for(int field=0;field<kFields;field++){
+            node->pending[field].push_back(s.values[field]);
+        }
+    }
+    bool ok = node->pending[kFieldTime].size()<kStoreBlockSamples ? WriteTail(*node, true) : WriteBlock(*node);
+    if(!ok){
+        std::perror(TailPath(node->dir).c_str());
+    }
+    return *node;
+}
+
+bool StoreWriter::WriteTail(Node& node, bool reset){
+    size_t n = node.pending[kFieldTime].size();
+    size_t from = reset ? 0 : node.written;
+    if(!reset && from==n){
+        return true;
+    }
+    std::string path = TailPath(node.dir);
+    std::string next = reset ? path+".new" : path;
+    int fd = open(next.c_str(), reset ? O_WRONLY | O_CREAT | O_TRUNC : O_WRONLY | O_APPEND, 0644);
+    if(fd<0){
+        return false;
+    }
+    std::vector<uint8_t> buffer(reset ? kFileHeader : 0);
+    if(reset){
+        std::memcpy(buffer.data(), kTailMagic, sizeof kTailMagic);
+        std::memcpy(buffer.data()+sizeof kTailMagic, &node.stored, sizeof node.stored);
+    }
+    buffer.resize(buffer.size()+(n-from)*sizeof(Sample));
+    Sample* samples = (Sample*)(buffer.data()+(reset ? kFileHeader : 0));
+    for(size_t i=from;i<n;i++){
+        for(int field=0;field<kFields;field++){
+            samples[i-from].values[field] = node.pending[field][i];
+        }
+    }
+    bool ok = WriteAll(fd, buffer.data(), buffer.size());
+    ok &= close(fd)==0;
+    //A new tail replaces the old one whole, so a crash leaves one or the other
+    if(reset){
+        ok = ok && rename(next.c_str(), path.c_str())==0;
+    }
+    if(ok){
+        node.written = n;
+    }
+    return ok;
+}
+
+bool StoreWriter::WriteBlock(Node& node){
+    uint32_t n = (uint32_t)node.pending[kFieldTime].size();
+    if(n==0){
+        return true;
+    }
+    std::vector<uint64_t> block;
+    bool ok = true;
+    for(int i=1;i<=kFields;i++){
+        int field = i%kFields;      //Time last
+        Encode(node.pending[field].data(), n, block);
+        int fd = open(ColumnPath(node.dir, field).c_str(), O_WRONLY | O_APPEND);
+        if(fd<0 || !WriteAll(fd, block.data(), block.size()*8)){
+            ok = false;
+        }
+        if(fd>=0){
+            close(fd);
+        }
+        node.pending[field].clear();
+    }
+    //On failure the tail keeps the samples and its start, so they come back
+    //after the torn block is cut off on reopening
+    node.written = 0;
+    if(ok){
+        node.stored += n;
+        ok = WriteTail(node, true);
+    }
+    return ok;
+}
+
+bool StoreWriter::Append(uint64_t address, const Sample& sample){
+    Node& node = Open(address);
+    for(int field=0;field<kFields;field++){
+        node.pending[field].push_back(sample.values[field]);
+    }
+    if(node.pending[kFieldTime].size()<kStoreBlockSamples){
+        return true;
+    }
+    return WriteBlock(node);
+}
+
+bool StoreWriter::Append(const ReadingColumns& in, const uint32_t* time, size_t first, size_t count){
+    bool ok = true;
+    for(size_t row=first;row<first+count;row++){
+        if(in.status[row]!=kFrameOk){
+            continue;
+        }
+        Sample s = {{time[row], in.count[row], in.batt[row], in.temp[row], in.v1[row], in.v2[row], in.uva[row],
+                     in.uvb[row], in.comp1[row], in.comp2[row], in.vis[row],
+                     in.id1[row]==kFrameLogId1 ? kSampleTimeFromCount : 0}};
+        ok &= Append(in.address[row], s);
+    }
+    return ok;
+}
+
+bool StoreWriter::Flush(){
+    bool ok = true;
+    for(auto& node : nodes_){
+        ok &= WriteTail(*node.second, false);
+    }
+    return ok;
+}
+
+RawColumns ScanColumns::Raw() const{
+    return {word[kFieldUva].data(), word[kFieldUvb].data(), word[kFieldComp1].data(), word[kFieldComp2].data(),
+            word[kFieldVis].data(), word[kFieldBatt].data(), word[kFieldTemp].data()};
+}
+
+NodeReader::~NodeReader(){
+    for(Column& c : columns_){
+        if(c.map){
+            munmap((void*)c.map, c.length);
+        }
+    }
+}
+
+bool NodeReader::Open(const std::string& root, uint64_t address){
+    std::string dir = NodeDir(root, address);
+    size_t blocks = SIZE_MAX;
+    bool missing[kFields] = {};
+    for(int field=0;field<kFields;field++){
+        Column& c = columns_[field];
+        int fd = open(ColumnPath(dir, field).c_str(), O_RDONLY);
+        if(fd<0 && errno==ENOENT && field!=kFieldTime){
+            missing[field] = true;
+            continue;
+        }
+        struct stat s;
+        if(fd>=0 && fstat(fd, &s)==0 && s.st_size>0){
+            void* map = mmap(nullptr, s.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            if(map!=MAP_FAILED){
+                c.map = (const uint8_t*)map;
+                c.length = s.st_size;
+                c.offsets = IndexBlocks(c.map, c.length);
+            }
+        }
+        if(fd>=0){
+            close(fd);
+        }
+        blocks = std::min(blocks, c.offsets.size());
+    }
+    if(!columns_[kFieldTime].map){
+        return false;
+    }
+    starts_.clear();
+    fileBlocks_ = blocks;
+    samples_ = 0;
+    std::vector<uint32_t> counts;
+    for(size_t k=0;k<blocks;k++){
+        starts_.push_back(samples_);
+        counts.push_back(Block(kFieldTime, k).count);
+        samples_ += counts.back();
+    }
+    for(int field=0;field<kFields;field++){
+        if(missing[field]){
+            columns_[field].zeros = ZeroBlocks(counts, columns_[field].offsets);
+        }
+    }
+    std::vector<Sample> tail = ReadTail(dir, samples_);
+    if(!tail.empty()){
+        std::vector<uint32_t> values(tail.size());
+        for(int field=0;field<kFields;field++){
+            for(size_t i=0;i<tail.size();i++){
+                values[i] = tail[i].values[field];
+            }
+            Encode(values.data(), (uint32_t)values.size(), columns_[field].tail);
+        }
+        starts_.push_back(samples_);
+        samples_ += tail.size();
+    }
+    return true;
+}
+
+size_t NodeReader::Blocks() const{
+    return starts_.size();
+}
+
+uint32_t NodeReader::FirstTime() const{
+    return Blocks() ? Block(kFieldTime, 0).first : 0;
+}
+
+uint32_t NodeReader::LastTime() const{
+    return Blocks() ? Block(kFieldTime, Blocks()-1).max : 0;
+}
+
+const StoreBlock& NodeReader::Block(int field, size_t k) const{
+    const Column& c = columns_[field];
+    const uint8_t* base = c.map ? c.map : (const uint8_t*)c.zeros.data();
+    return *(const StoreBlock*)(k<fileBlocks_ ? base+c.offsets[k] : (const uint8_t*)c.tail.data());
+}
+
+void NodeReader::Decode(int field, size_t k, uint32_t* out) const{
+    const StoreBlock& b = Block(field, k);
+    const uint64_t* payload = (const uint64_t*)(&b+1);
+    uint32_t value = b.first;
+    uint32_t minDelta = (uint32_t)b.minDelta;   //Modulo 2^32 is enough to rebuild uint32 values
+    out[0] = value;
+    if(b.bits==0){
+        for(uint32_t i=1;i<b.count;i++){
+            value += minDelta;
+            out[i] = value;
+        }
+        return;
+    }
+    uint64_t mask = b.bits==64 ? ~0ull : (1ull<<b.bits)-1;
+    size_t position = 0;
+    for(uint32_t i=1;i<b.count;i++,position+=b.bits){
+        size_t word = position>>6;
+        unsigned shift = position & 63;
+        uint64_t packed = payload[word]>>shift;
+        if(shift+b.bits>64){
+            packed |= payload[word+1]<<(64-shift);
+        }
+        value += (uint32_t)(packed & mask)+minDelta;
+        out[i] = value;
+    }
+}
+
+size_t NodeReader::Scan(uint32_t from, uint32_t to, unsigned mask, ScanColumns& out, ScanStats* stats) const{
+    mask |= 1u<<kFieldTime;
+    out.rows = 0;
+    out.time.clear();
+    out.count.clear();
+    for(std::vector<uint16_t>& w : out.word){
+        w.clear();
+    }
+    uint32_t times[kStoreBlockSamples];
+    uint32_t values[kStoreBlockSamples];
+    uint16_t keep[kStoreBlockSamples];
+    for(size_t k=0;k<Blocks();k++){
+        const StoreBlock& t = Block(kFieldTime, k);
+        if(t.max<from || t.min>to){
+            if(stats){
+                stats->blocksSkipped++;
+            }
+            continue;
+        }
+        Decode(kFieldTime, k, times);
+        uint32_t n = 0;
+        for(uint32_t i=0;i<t.count;i++){
+            keep[n] = (uint16_t)i;
+            n += times[i]>=from && times[i]<=to;
+        }
+        bool all = n==t.count;
+        for(int field=0;field<kFields;field++){
+            if(!(mask & 1u<<field)){
+                continue;
+            }
+            if(stats){
+                stats->blocksRead++;
+            }
+            if(field!=kFieldTime){
+                Decode(field, k, values);
+            }
+            const uint32_t* v = field==kFieldTime ? times : values;
+            if(field==kFieldTime || field==kFieldCount){
+                std::vector<uint32_t>& column = field==kFieldTime ? out.time : out.count;
+                if(all){
+                    column.insert(column.end(), v, v+n);
+                }
+                else{
+                    for(uint32_t i=0;i<n;i++){
+                        column.push_back(v[keep[i]]);
+                    }
+                }
+            }
+            else{
+                std::vector<uint16_t>& column = out.word[field];
+                size_t base = column.size();
+                column.resize(base+n);
+                for(uint32_t i=0;i<n;i++){
+                    column[base+i] = (uint16_t)v[all ? i : keep[i]];
+                }
+            }
+        }
+        out.rows += n;
+    }
+    return out.rows;
+}
+
+bool NodeReader::MinMax(Field field, uint32_t from, uint32_t to, uint32_t& min, uint32_t& max,
+                        ScanStats* stats) const{
+    bool found = false;
+    min = UINT32_MAX;
+    max = 0;
+    uint32_t times[kStoreBlockSamples];
+    uint32_t values[kStoreBlockSamples];
+    for(size_t k=0;k<Blocks();k++){
+        const StoreBlock& t = Block(kFieldTime, k);
+        if(t.max<from || t.min>to){
+            if(stats){
+                stats->blocksSkipped++;
+            }
+            continue;
+        }
+        if(t.min>=from && t.max<=to){
+            const StoreBlock& b = Block(field, k);
+            min = std::min(min, b.min);
+            max = std::max(max, b.max);
+            found = true;
+            continue;
+        }
+        Decode(kFieldTime, k, times);
+        Decode(field, k, values);
+        if(stats){
+            stats->blocksRead += 2;
+        }
+        for(uint32_t i=0;i<t.count;i++){
+            if(times[i]>=from && times[i]<=to){
+                min = std::min(min, values[i]);
+                max = std::max(max, values[i]);
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+std::vector<uint64_t> StoreNodes(const std::string& root){
+    std::vector<uint64_t> nodes;
+    DIR* dir = opendir(root.c_str());
+    if(!dir){
+        return nodes;
+    }
+    while(struct dirent* entry = readdir(dir)){
+        char* end;
+        if(std::strlen(entry->d_name)!=16){
+            continue;
+        }
+        uint64_t address = std::strtoull(entry->d_name, &end, 16);
+        if(*end==0){
+            nodes.push_back(address);
+        }
+    }
+    closedir(dir);
+    std::sort(nodes.begin(), nodes.end());
+    return nodes;
+}
+
+} // namespace gateway
@@ -0,0 +1,214 @@
+/*
+ * File:   store.h
+ * Author: Andy Page
+ * Comments: Append only columnar store for the minute by minute history of
+ *           every node.  Each node has a directory named by its address in
+ *           hex and each of its 12 fields a file in it:
+ *
+ *           root/6EDA82333366F5E6/time.col, count.col, batt.col ... flags.col
+ *           root/6EDA82333366F5E6/tail.smp
+ *
+ *           A column file is a 16 byte header then blocks of up to
+ *           kStoreBlockSamples values.  A block header holds the number of
+ *           values, the first, min and max and the payload length; the
+ *           payload is the differences between successive values less the
+ *           smallest of them, bit packed at the width of the largest.  A
+ *           node's columns are cut into blocks at the same rows, so block k
+ *           of time.col gives the time range of block k of every column.
+ *           Minute timestamps pack to 0 bits and most 16-bit fields to a
+ *           few.  Only full blocks go in the column files.  The samples
+ *           after the last of them are kept in tail.smp as plain Samples
+ *           until there are enough for a block, so a node heard once a
+ *           minute and flushed as often still gets blocks of
+ *           kStoreBlockSamples.
+ *
+ *           The reader maps the files read only and builds an index of the
+ *           block headers, so a range scan decodes only the blocks that
+ *           overlap it, only for the columns asked for, and min/max over
+ *           whole blocks come from the headers.  The tail is read as one
+ *           more block, encoded when the node is opened.  A column added
+ *           since a node's files were written (flags) reads as zeros, and
+ *           the writer fills its file with zero blocks.  Values are
+ *           little endian,
+ *           as the hosts the gateway runs on.
+ * Revision history: 1, 19th October 2026
+ */
+
+#ifndef INC_GATEWAY_STORE_H
+#define INC_GATEWAY_STORE_H
+
+#include "calibrate.h"
+#include "frame.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gateway {
+
+//Fields of a stored sample, in file order
+enum Field {
+    kFieldTime,         //Unix seconds the frame was received
+    kFieldCount,        //messageCount
+    kFieldBatt,
+    kFieldTemp,
+    kFieldV1,
+    kFieldV2,
+    kFieldUva,
+    kFieldUvb,
+    kFieldComp1,
+    kFieldComp2,
+    kFieldVis,
+    kFieldFlags         //kSampleTimeFromCount etc.
+};
+constexpr int kFields = 12;
+constexpr unsigned kAllFields = (1u<<kFields)-1;
+extern const char* const kFieldNames[kFields];
+
+constexpr uint32_t kStoreBlockSamples = 4096;
+
+//Flags of a sample
+constexpr uint32_t kSampleTimeFromCount = 0x01;    //From a log packet, time worked out from the count
+
+
+/**
+ * One sample, values[kFieldTime] etc.
+ */
+struct Sample {
+    uint32_t values[kFields];
+};
+
+/**
+ * Writes samples to the store.  Each node keeps up to kStoreBlockSamples
+ * samples in memory and appends them to its column files as one block when
+ * full.  Flush() appends the samples since the last one to the node's tail
+ * file, so call it as often as losing them on a crash matters, and readers
+ * see them from then on.  On opening an existing node any partly written
+ * block left by a crash is cut off and the tail is read back.  Not thread
+ * safe.
+ */
+class StoreWriter {
+public:
+    explicit StoreWriter(const std::string& root);
+    ~StoreWriter();
+    StoreWriter(const StoreWriter&) = delete;
+    StoreWriter& operator=(const StoreWriter&) = delete;
+
+    /**
+     * @return false if a block could not be written (errno is set)
+     */
+    bool Append(uint64_t address, const Sample& sample);
+
+    /**
+     * Appends the good rows (status kFrameOk) of decoded frames, log packet
+     * records flagged kSampleTimeFromCount.
+     * @param time  Receive time of each row, indexed as the columns
+     */
+    bool Append(const ReadingColumns& in, const uint32_t* time, size_t first, size_t count);
+
+    //Writes every node's new samples to its tail file
+    bool Flush();
+
+private:
+    struct Node;
+    Node& Open(uint64_t address);
+    bool WriteBlock(Node& node);
+    bool WriteTail(Node& node, bool reset);
+
+    std::string root_;
+    std::unordered_map<uint64_t, std::unique_ptr<Node>> nodes_;
+};
+
+/**
+ * Header of one block, as stored.
+ */
+struct StoreBlock {
+    uint32_t count;         //Values in the block
+    uint32_t first;
+    uint32_t min;
+    uint32_t max;
+    int64_t minDelta;       //Smallest difference between successive values
+    uint32_t bits;          //Width of each packed difference, 0 to 33
+    uint32_t bytes;         //Payload length, a multiple of 8
+};
+
+/**
+ * Values decoded by a scan.  16-bit fields are in word[field].
+ */
+struct ScanColumns {
+    std::vector<uint32_t> time;
+    std::vector<uint32_t> count;
+    std::vector<uint16_t> word[kFields];
+    size_t rows = 0;
+
+    //batt, temp, UV and vis for Calibrate()
+    RawColumns Raw() const;
+};
+
+struct ScanStats {
+    size_t blocksRead = 0;      //Blocks decoded, all columns
+    size_t blocksSkipped = 0;   //Time blocks outside the range
+};
+
+/**
+ * Read only view of one node's columns as they were when it was opened.
+ */
+class NodeReader {
+public:
+    NodeReader() = default;
+    ~NodeReader();
+    NodeReader(const NodeReader&) = delete;
+    NodeReader& operator=(const NodeReader&) = delete;
+
+    /**
+     * Maps the node's column files.
+     * @return false if the node has no time column
+     */
+    bool Open(const std::string& root, uint64_t address);
+    size_t Samples() const { return samples_; }
+    size_t Blocks() const;
+    uint32_t FirstTime() const;
+    uint32_t LastTime() const;
+
+    /**
+     * Decodes the fields in mask (1<<kFieldBatt etc., time is always
+     * included) of the samples with from <= time <= to.
+     */
+    size_t Scan(uint32_t from, uint32_t to, unsigned mask, ScanColumns& out, ScanStats* stats = nullptr) const;
+
+    /**
+     * Min and max of field over from <= time <= to, decoding only the
+     * blocks the range cuts.
+     * @return false if there are no samples in the range
+     */
+    bool MinMax(Field field, uint32_t from, uint32_t to, uint32_t& min, uint32_t& max,
+                ScanStats* stats = nullptr) const;
+
+private:
+    struct Column {
+        const uint8_t* map = nullptr;
+        size_t length = 0;
+        std::vector<size_t> offsets;    //Of each block header
+        std::vector<uint64_t> tail;     //The tail samples encoded as a block
+        std::vector<uint64_t> zeros;    //In place of a missing file, see ZeroBlocks()
+    };
+    const StoreBlock& Block(int field, size_t k) const;
+    void Decode(int field, size_t k, uint32_t* out) const;
+
+    Column columns_[kFields];
+    std::vector<size_t> starts_;        //Sample index of each block
+    size_t fileBlocks_ = 0;             //Blocks in the files, the tail is after them
+    size_t samples_ = 0;
+};
+
+/**
+ * Addresses of the nodes under root.
+ */
+std::vector<uint64_t> StoreNodes(const std::string& root);
+
+} // namespace gateway
+
+#endif /* INC_GATEWAY_STORE_H */
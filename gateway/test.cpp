@@ -0,0 +1,916 @@
+/**
+ * test.cpp
+ * Regression checks for the gateway library.  Frames come from the
+ * simulator's golden v5 packets (../sim/golden) so the decoder is checked
+ * against what the firmware actually builds.
+ *   uvgwtest [sim golden directory]
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include "calibrate.h"
+#include "capture.h"
+#include "crc16.h"
+#include "frame.h"
+#include "loadgen.h"
+#include "nodes.h"
+#include "pipeline.h"
+#include "queue.h"
+#include "receiver.h"
+#include "store.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <sys/stat.h>
+#include <vector>
+
+using namespace gateway;
+
+namespace {
+
+unsigned failures = 0;
+std::string goldenDir = "../sim/golden";
+
+void Check(bool ok, const char* what){
+    if(!ok){
+        failures++;
+        std::fprintf(stderr, "FAIL: %s\n", what);
+    }
+}
+
+std::vector<uint8_t> Hex(const char* hex){
+    std::vector<uint8_t> bytes;
+    unsigned value;
+    while(std::sscanf(hex, "%2x", &value)==1){
+        bytes.push_back((uint8_t)value);
+        hex += 2;
+    }
+    return bytes;
+}
+
+//A sendLog() packet from the simulator after three wakes under UVLO: ID1 0x22,
+//first count 64, two records
+const char kLogPacket[] = "3200226EDA82333366F5E6050000004002004076DC600190012C003200280258004176DC600190012C"
+                          "0032002802580019CC";
+
+//A log packet as sendLog() builds it, UVA of each record as MakeFrame()
+std::vector<uint8_t> MakeLogFrame(uint64_t address, const std::vector<uint32_t>& counts){
+    std::vector<uint8_t> f(kFrameLength, 0);
+    f[0] = kFrameLength;
+    f[2] = kFrameLogId1;
+    for(int i=0;i<8;i++){
+        f[3+i] = (uint8_t)(address>>(56-8*i));
+    }
+    f[11] = kFrameVersion;
+    for(int i=0;i<4;i++){
+        f[12+i] = (uint8_t)(counts[0]>>(24-8*i));
+    }
+    f[16] = (uint8_t)counts.size();
+    for(size_t k=0;k<counts.size();k++){
+        uint8_t* r = f.data()+kLogRecordsOffset+k*kLogRecordLength;
+        uint16_t uva = (uint16_t)(address*100+counts[k]);
+        r[0] = (uint8_t)(counts[k]>>8);
+        r[1] = (uint8_t)counts[k];
+        r[5] = (uint8_t)(uva>>8);
+        r[6] = (uint8_t)uva;
+    }
+    uint16_t crc = Crc16(f.data(), kFrameCrcOffset);
+    f[48] = (uint8_t)crc;
+    f[49] = (uint8_t)(crc>>8);
+    return f;
+}
+
+std::vector<std::vector<uint8_t>> ReadHexLines(const std::string& path){
+    std::vector<std::vector<uint8_t>> lines;
+    FILE* f = std::fopen(path.c_str(), "r");
+    if(!f){
+        Check(false, ("open "+path).c_str());
+        return lines;
+    }
+    char text[1024];
+    while(std::fgets(text, sizeof text, f)){
+        const char* hex = std::strrchr(text, ' ');
+        lines.push_back(Hex(hex ? hex+1 : text));
+    }
+    std::fclose(f);
+    return lines;
+}
+
+void TestCrc(){
+    const uint8_t* check = (const uint8_t*)"123456789";
+    Check(Crc16(check, 9)==0x4B37, "CRC16 check value");
+    Check(Crc16Bytewise(check, 9)==0x4B37, "bytewise CRC16 check value");
+    uint8_t data[300];
+    for(unsigned i=0;i<sizeof data;i++){
+        data[i] = (uint8_t)(i*31+7);
+    }
+    for(size_t length=0;length<sizeof data;length++){
+        if(Crc16(data, length)!=Crc16Bytewise(data, length)){
+            Check(false, "slice-by-8 against bytewise");
+            break;
+        }
+    }
+    const uint8_t* four[4] = {data, data+1, data+2, data+3};
+    uint16_t crc[4];
+    Crc16x4(four, 45, crc);
+    for(int k=0;k<4;k++){
+        Check(crc[k]==Crc16Bytewise(data+k, 45), "Crc16x4 against bytewise");
+    }
+}
+
+//Inputs of the golden packets, as in sim/bench.c
+struct Expected {
+    uint32_t count;
+    uint16_t batt, temp, uva, uvb, comp1, comp2, vis;
+};
+const Expected expected[] = {
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {1, 525, 512, 400, 300, 50, 40, 600},
+    {0x01020304, 0x03FF, 0x0200, 0x1234, 0x5678, 0x9ABC, 0xDEF0, 0xBEEF},
+    {0xFFFFFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF},
+};
+
+void TestDecode(){
+    std::vector<std::vector<uint8_t>> packets = ReadHexLines(goldenDir+"/packets-v5.txt");
+    Check(packets.size()==4, "four golden packets");
+    if(packets.size()!=4){
+        return;
+    }
+    //Five copies of each so both the four-wide and the single paths are used
+    std::vector<uint8_t> frames;
+    for(int copy=0;copy<5;copy++){
+        for(const std::vector<uint8_t>& p : packets){
+            frames.insert(frames.end(), p.begin(), p.end());
+        }
+    }
+    size_t rows = frames.size()/kFrameLength;
+    ReadingBuffer buffer(rows, true);
+    const ReadingColumns& c = buffer.Columns();
+    Check(DecodeFrames(frames.data(), rows, kFrameLength, c)==rows, "golden packets all good");
+    for(size_t row=0;row<rows;row++){
+        const Expected& e = expected[row%4];
+        Check(c.status[row]==kFrameOk && c.address[row]==0x6EDA82333366F5E6ull && c.id0[row]==0 && c.id1[row]==2 &&
+              c.version[row]==5, "decoded header");
+        Check(c.count[row]==e.count && c.batt[row]==e.batt && c.temp[row]==e.temp && c.uva[row]==e.uva &&
+              c.uvb[row]==e.uvb && c.comp1[row]==e.comp1 && c.comp2[row]==e.comp2 && c.vis[row]==e.vis &&
+              c.v1[row]==0 && c.v2[row]==0, "decoded fields");
+    }
+    //Damage some frames
+    frames[1*kFrameLength+20] ^= 0x01;
+    frames[6*kFrameLength+0] = 49;
+    frames[7*kFrameLength+11] = 4;
+    frames[18*kFrameLength+49] ^= 0x80;
+    std::vector<const uint8_t*> scattered;
+    for(size_t row=0;row<rows;row++){
+        scattered.push_back(frames.data()+(rows-1-row)*kFrameLength);
+    }
+    Check(DecodeFrames(scattered.data(), rows, c)==rows-4, "damaged frames rejected");
+    Check(c.status[rows-1-1]==kFrameBadCrc, "bit flip is a CRC error");
+    Check(c.status[rows-1-6]==(kFrameBadCrc|kFrameBadLength), "bad length byte");
+    Check(c.status[rows-1-7]==(kFrameBadCrc|kFrameBadVersion), "bad version byte");
+    Check(c.status[rows-1-18]==kFrameBadCrc, "bad CRC byte");
+    Check(ValidateFrame(packets[2].data())==kFrameOk, "ValidateFrame");
+    //A log packet has a good CRC but is not a reading
+    std::vector<uint8_t> log = Hex(kLogPacket);
+    Check(log.size()==kFrameLength && ValidateFrame(log.data())==kFrameBadId, "log packet is not a reading");
+    Check(DecodeFrame(log.data(), c, 0)==kFrameBadId && IsLogFrame(c.status[0], c.id1[0]) &&
+          c.address[0]==0x6EDA82333366F5E6ull && c.count[0]==64, "log packet header");
+    Check(!IsLogFrame(kFrameOk, kFrameLogId1) && !IsLogFrame(kFrameBadId, 0x03), "IsLogFrame");
+    //Its records, as samplelog.c packed them
+    Check(DecodeLogFrame(log.data(), c, 0)==2, "log records");
+    bool records = true;
+    for(size_t row=0;row<2;row++){
+        records &= c.status[row]==kFrameOk && c.id1[row]==kFrameLogId1 && c.address[row]==0x6EDA82333366F5E6ull &&
+                   c.count[row]==64+row && c.batt[row]==475 && c.temp[row]==454 && c.uva[row]==400 &&
+                   c.uvb[row]==300 && c.comp1[row]==50 && c.comp2[row]==40 && c.vis[row]==600 && c.v1[row]==0;
+    }
+    Check(records, "log record fields");
+    Check(DecodeLogFrame(packets[0].data(), c, 0)==0, "a reading has no log records");
+    std::vector<uint8_t> wrapped = MakeLogFrame(1, {0x1FFFF, 0x20000});
+    Check(DecodeLogFrame(wrapped.data(), c, 0)==2 && c.count[0]==0x1FFFF && c.count[1]==0x20000,
+          "log counts past 16 bits");
+    //Encoding the decoded golden packets gives them back
+    bool same = true;
+    for(size_t row=0;row<4;row++){
+        uint8_t frame[kFrameLength];
+        DecodeFrame(packets[row].data(), c, row);
+        EncodeFrame(c, row, frame);
+        same &= std::memcmp(frame, packets[row].data(), kFrameLength)==0;
+    }
+    Check(same, "EncodeFrame");
+}
+
+bool Near(double a, double b, double tolerance){
+    return std::fabs(a-b)<=tolerance;
+}
+
+void TestCalibrate(){
+    //Two rows of the default node, one of a node with its own calibration
+    //and one of a node built with ADC_EXTRA_BITS 2
+    ReadingBuffer buffer(4);
+    const ReadingColumns& c = buffer.Columns();
+    for(size_t row=0;row<4;row++){
+        c.address[row] = row<2 ? 1 : row;
+        c.uva[row] = 400;
+        c.uvb[row] = 300;
+        c.comp1[row] = 50;
+        c.comp2[row] = 40;
+        c.vis[row] = 600;
+        c.batt[row] = 525;
+        c.temp[row] = 512;
+    }
+    c.uva[1] = 10; //Compensation takes it below zero
+    c.batt[3] = 525*4;
+    c.temp[3] = 512*4;
+    CalibrationTable table;
+    NodeCalibration other;
+    other.integrationMs = 200.0f;
+    other.bhMode = 0x11; //H-resolution mode 2
+    other.mtreg = 138;
+    other.ntcLowSide = true;
+    other.steinhartA = 1.125308852e-3f; //10k B3950 fitted at 0, 25 and 50C
+    other.steinhartB = 2.347236650e-4f;
+    other.steinhartC = 0.85663516e-7f;
+    table.Set(2, other);
+    NodeCalibration wide;
+    wide.adcBits = 12;
+    table.Set(3, wide);
+    float uva[4], uvb[4], uvi[4], lux[4], battery[4], temperature[4];
+    CalibratedColumns out = {uva, uvb, uvi, lux, battery, temperature};
+    Calibrate(c, 0, 4, table, out);
+    double uvaCalc = 400-2.22*50-1.33*40;
+    double uvbCalc = 300-2.95*50-1.74*40;
+    Check(Near(uva[0], uvaCalc/0.93, 0.01) && Near(uvb[0], uvbCalc/2.1, 0.01), "UVA and UVB irradiance");
+    Check(Near(uvi[0], (uvaCalc*0.001461+uvbCalc*0.002591)/2, 1e-5), "UV index");
+    Check(uva[1]==0.0f && Near(uvi[1], uvbCalc*0.002591/2, 1e-5), "compensation clamps at zero");
+    Check(Near(lux[0], 500.0, 0.01), "lux, H-resolution MTreg 69");
+    Check(Near(battery[0], 525*1.024/1023*4, 1e-4), "battery volts");
+    Check(Near(temperature[0], 25.04, 0.01), "NTC Beta at mid scale");
+    Check(Near(uva[2], uvaCalc/2/0.93, 0.01), "longer integration time");
+    Check(Near(lux[2], 600/1.2*69/138/2, 0.01), "lux, H-resolution 2 and MTreg 138");
+    Check(Near(temperature[2], 24.95, 0.01), "NTC Steinhart-Hart, low side");
+    Check(Near(battery[3], battery[0], 1e-4) && Near(temperature[3], temperature[0], 1e-3), "12-bit ADC readings");
+}
+
+//A node reporting every minute with slowly changing readings
+std::vector<Sample> MakeSamples(size_t n, uint32_t start){
+    std::mt19937 random(46);
+    std::vector<Sample> samples(n);
+    uint32_t level = 300;
+    for(size_t i=0;i<n;i++){
+        Sample& s = samples[i];
+        s.values[kFieldTime] = start+(uint32_t)i*60+(i>5000 ? 3600 : 0);  //An hour's gap
+        s.values[kFieldCount] = (uint32_t)i-(i>9000 ? 9000 : 0);           //And a reboot
+        level = std::min(1023u, std::max(1u, level+(uint32_t)(random()%9)-4));
+        for(int field=kFieldBatt;field<=kFieldVis;field++){
+            s.values[field] = (level*(field+1)/4) & 0xFFFF;
+        }
+        s.values[kFieldVis] = i%1440<720 ? 0xFFFF : 0;  //Extreme steps
+        s.values[kFieldFlags] = 0;
+    }
+    return samples;
+}
+
+void TestStore(){
+    char root[] = "/tmp/uvgwtest-XXXXXX";
+    Check(mkdtemp(root)!=nullptr, "temporary directory");
+    const uint64_t address = 0x6EDA82333366F5E6ull;
+    const uint32_t start = 1790000000;
+    std::vector<Sample> samples = MakeSamples(10000, start);
+    {
+        StoreWriter writer(root);
+        for(size_t i=0;i<6000;i++){
+            Check(writer.Append(address, samples[i]), "append");
+        }
+        Check(writer.Flush(), "flush");
+        writer.Append(2, samples[0]);
+    }
+    {
+        StoreWriter writer(root);   //Reopened, carries on from the tail
+        for(size_t i=6000;i<samples.size();i++){
+            writer.Append(address, samples[i]);
+        }
+    }
+    std::vector<uint64_t> nodes = StoreNodes(root);
+    Check(nodes.size()==2 && nodes[0]==2 && nodes[1]==address, "node directories");
+    NodeReader reader;
+    Check(reader.Open(root, address), "open node");
+    Check(reader.Samples()==samples.size() && reader.Blocks()==3, "blocks written");
+    Check(reader.FirstTime()==start && reader.LastTime()==samples.back().values[kFieldTime], "time span");
+    ScanColumns all;
+    Check(reader.Scan(0, UINT32_MAX, kAllFields, all)==samples.size(), "full scan");
+    bool same = true;
+    for(size_t i=0;i<samples.size();i++){
+        const uint32_t* v = samples[i].values;
+        same &= all.time[i]==v[kFieldTime] && all.count[i]==v[kFieldCount];
+        for(int field=kFieldBatt;field<kFields;field++){
+            same &= all.word[field][i]==v[field];
+        }
+    }
+    Check(same, "values read back");
+    //A day in the middle reads one or two blocks of the columns asked for
+    uint32_t from = start+4500*60;
+    uint32_t to = from+86400;
+    ScanColumns day;
+    ScanStats stats;
+    size_t rows = reader.Scan(from, to, 1u<<kFieldUva, day, &stats);
+    size_t expected = 0;
+    uint32_t min = UINT32_MAX, max = 0;
+    bool match = true;
+    for(const Sample& s : samples){
+        if(s.values[kFieldTime]>=from && s.values[kFieldTime]<=to){
+            match &= expected<rows && day.word[kFieldUva][expected]==s.values[kFieldUva];
+            min = std::min(min, s.values[kFieldTemp]);
+            max = std::max(max, s.values[kFieldTemp]);
+            expected++;
+        }
+    }
+    Check(rows==expected && match && day.word[kFieldBatt].empty(), "range scan");
+    Check(stats.blocksRead==2 && stats.blocksSkipped==2, "range scan reads only its blocks");
+    uint32_t storedMin, storedMax;
+    Check(reader.MinMax(kFieldTemp, from, to, storedMin, storedMax) && storedMin==min && storedMax==max, "MinMax");
+    Check(!reader.MinMax(kFieldTemp, 0, start-1, storedMin, storedMax), "MinMax of an empty range");
+    //A torn block at the end of a column is ignored, then cut off by the writer
+    std::string batt = std::string(root)+"/6EDA82333366F5E6/batt.col";
+    FILE* f = std::fopen(batt.c_str(), "ab");
+    std::fwrite(&samples[0], 1, 40, f);
+    std::fclose(f);
+    NodeReader torn;
+    Check(torn.Open(root, address) && torn.Samples()==samples.size(), "torn block ignored");
+    {
+        StoreWriter writer(root);
+        writer.Append(address, samples.back());
+    }
+    NodeReader appended;
+    Check(appended.Open(root, address) && appended.Samples()==samples.size()+1, "append after a torn block");
+    //A node heard once a minute and flushed after each sample, as the
+    //pipeline does, still gets full blocks, and the samples after the last
+    //one are read from the tail
+    {
+        StoreWriter writer(root);
+        for(size_t i=0;i<1440;i++){
+            writer.Append(3, samples[i]);
+            Check(writer.Flush(), "flush each sample");
+        }
+        NodeReader day;
+        struct stat s;
+        Check(day.Open(root, 3) && day.Samples()==1440 && day.Blocks()==1 &&
+              stat((std::string(root)+"/0000000000000003/uva.col").c_str(), &s)==0 && s.st_size==16,
+              "a day of flushes is all in the tail");
+        for(size_t i=1440;i<5000;i++){
+            writer.Append(3, samples[i]);
+            writer.Flush();
+        }
+    }
+    NodeReader flushed;
+    ScanColumns flushedAll;
+    bool flushedSame = flushed.Open(root, 3) && flushed.Samples()==5000 && flushed.Blocks()==2 &&
+                       flushed.Scan(0, UINT32_MAX, kAllFields, flushedAll)==5000;
+    for(size_t i=0;flushedSame && i<5000;i++){
+        flushedSame &= flushedAll.time[i]==samples[i].values[kFieldTime] &&
+                       flushedAll.word[kFieldVis][i]==samples[i].values[kFieldVis];
+    }
+    Check(flushedSame, "flushes alternating with appends make full blocks");
+    //A store from before the flags column reads as unflagged, and the writer
+    //fills the column in rather than cutting the node back to nothing
+    std::remove((std::string(root)+"/0000000000000003/flags.col").c_str());
+    NodeReader old;
+    ScanColumns oldAll;
+    bool unflagged = old.Open(root, 3) && old.Samples()==5000 && old.Blocks()==2 &&
+                     old.Scan(0, UINT32_MAX, kAllFields, oldAll)==5000;
+    for(size_t i=0;unflagged && i<5000;i++){
+        unflagged &= oldAll.word[kFieldFlags][i]==0 && oldAll.word[kFieldVis][i]==samples[i].values[kFieldVis];
+    }
+    Check(unflagged, "store without a flags column");
+    {
+        StoreWriter writer(root);
+        writer.Append(3, samples[5000]);
+    }
+    NodeReader upgraded;
+    ScanColumns upgradedAll;
+    Check(upgraded.Open(root, 3) && upgraded.Samples()==5001 &&
+          upgraded.Scan(0, UINT32_MAX, 1u<<kFieldFlags, upgradedAll)==5001 &&
+          std::count(upgradedAll.word[kFieldFlags].begin(), upgradedAll.word[kFieldFlags].end(), 0)==5001,
+          "writer fills in the flags column");
+    //A crash after a block is written but before the tail starts again
+    //leaves the block's samples in the tail, they are not read twice
+    std::string tail = std::string(root)+"/0000000000000004/tail.smp";
+    {
+        StoreWriter writer(root);
+        for(size_t i=0;i<kStoreBlockSamples-1;i++){
+            writer.Append(4, samples[i]);
+        }
+        writer.Flush();
+        std::system(("cp "+tail+" "+tail+".old").c_str());
+        writer.Append(4, samples[kStoreBlockSamples-1]);
+    }
+    std::rename((tail+".old").c_str(), tail.c_str());
+    NodeReader crashed;
+    Check(crashed.Open(root, 4) && crashed.Samples()==kStoreBlockSamples && crashed.Blocks()==1,
+          "stale tail after a block");
+    {
+        StoreWriter writer(root);
+        writer.Append(4, samples[kStoreBlockSamples]);
+    }
+    NodeReader resumed;
+    Check(resumed.Open(root, 4) && resumed.Samples()==kStoreBlockSamples+1 && resumed.Blocks()==2,
+          "writer drops the stale tail");
+    std::system(("rm -rf "+std::string(root)).c_str());
+}
+
+void TestNodes(){
+    NodeTable table(4);
+    const uint64_t a = 0x6EDA82333366F5E6ull;
+    uint32_t t = 1000;
+    Check(table.Track(a, 0, t)==kSequenceFirst, "first frame");
+    Check(table.Track(a, 0, t)==kSequenceDuplicate, "second receiver is a duplicate");
+    Check(table.Track(a, 1, t+=67)==kSequenceNext, "next frame");
+    Check(table.Track(a, 5, t+=268)==kSequenceGap, "gap");
+    Check(table.Track(a, 3, t+1)==kSequenceLate, "late frame");
+    Check(table.Track(a, 3, t+2)==kSequenceDuplicate, "late frame repeated");
+    Check(table.Track(a, 6, t+=67)==kSequenceNext && table.Track(a, 5, t+1)==kSequenceDuplicate, "window moves on");
+    NodeStats s;
+    Check(table.Lookup(a, s) && s.received==5 && s.duplicates==3 && s.late==1 && s.lost==2 && s.gaps==1,
+          "node stats");
+    //Restarted after 6 transmissions, count 0 is a reboot not a duplicate
+    Check(table.Track(a, 0, t+=80)==kSequenceReboot && table.Track(a, 0, t+1)==kSequenceDuplicate, "reboot");
+    Check(table.Lookup(a, s) && s.reboots==1 && s.highest==0, "reboot stats");
+    //The firmware's own resets: the count is checkpointed at start up and
+    //every 64, and a reset carries on 64 past the checkpoint, so a node
+    //reset after counts 0-2 and again after 64-65 sends 0, 1, 2, 64, 65, 128
+    //(uvsim -e gives 0, 64, 128 over three boots)
+    const uint64_t r = a+2;
+    t = 5000;
+    Check(table.Track(r, 0, t)==kSequenceFirst && table.Track(r, 1, t+=67)==kSequenceNext &&
+          table.Track(r, 2, t+=67)==kSequenceNext, "before the reset");
+    //Hung, then the watchdog reset it and it sends as soon as it boots
+    Check(table.Track(r, 64, t+=70)==kSequenceReboot && table.Track(r, 65, t+=67)==kSequenceNext &&
+          table.Track(r, 128, t+=67)==kSequenceReboot, "reset carries on past the checkpoint");
+    Check(table.Lookup(r, s) && s.reboots==2 && s.gaps==0 && s.lost==0 && s.highest==128, "reset stats");
+    //The same jumps a cycle per count apart are frames lost, even on a
+    //node running 10% fast
+    Check(table.Track(r, 130, t+=2*58)==kSequenceGap && table.Track(r, 129, t+1)==kSequenceLate &&
+          table.Track(r, 194, t+=64*58)==kSequenceGap && table.Track(r, 200, t+=67)==kSequenceReboot,
+          "gaps are not resets");
+    //Nor is a jump with no silence, as from a file read faster than real time
+    Check(table.Track(r, 202, t+1)==kSequenceGap, "no silence is a gap");
+    Check(table.Lookup(r, s) && s.reboots==3 && s.gaps==3 && s.lost==64, "gap stats");
+    const uint64_t b = a+1;
+    Check(table.Track(b, 0xFFFFFFFE, t)==kSequenceFirst && table.Track(b, 0xFFFFFFFF, t+=67)==kSequenceNext &&
+          table.Track(b, 1, t+=134)==kSequenceGap && table.Track(b, 0, t+1)==kSequenceLate &&
+          table.Track(b, 0xFFFFFFFF, t+2)==kSequenceDuplicate, "count wraps");
+    Check(table.Lookup(b, s) && s.wraps==1 && s.reboots==0 && s.lost==0 && s.highest==1, "wrap stats");
+    //A frame from before the first one heard is late but was never lost
+    Check(table.Track(7, 10, t)==kSequenceFirst && table.Track(7, 9, t+1)==kSequenceLate, "late before first");
+    Check(table.Lookup(7, s) && s.lost==0 && !table.Lookup(8, s), "lost only counts gaps");
+    //Four receivers feeding 20000 nodes from four threads, every frame
+    //should be kept once
+    NodeTable shared;
+    const uint32_t kNodes = 20000, kCounts = 20;
+    std::vector<std::thread> receivers;
+    for(int r=0;r<4;r++){
+        receivers.emplace_back([&shared, r]{
+            for(uint32_t c=0;c<kCounts;c++){
+                for(uint32_t n=0;n<kNodes;n++){
+                    uint32_t node = (n*7919+r*1013)%kNodes;
+                    shared.Track(0x6EDA820000000000ull+node, c, 1000+c*67+(node & 15));
+                }
+            }
+        });
+    }
+    for(std::thread& receiver : receivers){
+        receiver.join();
+    }
+    NodeStats total = shared.Totals();
+    Check(shared.Nodes()==kNodes && total.received==kNodes*kCounts && total.duplicates==3*kNodes*kCounts,
+          "concurrent dedup");
+    Check(total.lost==0 && total.reboots==0 && total.late==0, "concurrent sequence");
+}
+
+//A v5 frame from a node, as buildPacket() makes it
+std::vector<uint8_t> MakeFrame(uint64_t address, uint32_t count, uint16_t uva){
+    std::vector<uint8_t> f(kFrameLength, 0);
+    f[0] = kFrameLength;
+    f[2] = 2;
+    for(int i=0;i<8;i++){
+        f[3+i] = (uint8_t)(address>>(56-8*i));
+    }
+    f[11] = kFrameVersion;
+    for(int i=0;i<4;i++){
+        f[12+i] = (uint8_t)(count>>(24-8*i));
+    }
+    f[24] = (uint8_t)(uva>>8);
+    f[25] = (uint8_t)uva;
+    uint16_t crc = Crc16(f.data(), kFrameCrcOffset);
+    f[48] = (uint8_t)crc;
+    f[49] = (uint8_t)(crc>>8);
+    return f;
+}
+
+
+void TestReceiver(){
+    std::vector<uint8_t> stream = {0x00, 0x55, 0x55};  //Noise before the first sync
+    uint8_t encoded[255+kReceiverOverhead];
+    for(uint32_t i=0;i<3;i++){
+        std::vector<uint8_t> f = MakeFrame(0x6EDA82333366F5E6ull, i, 400);
+        size_t n = ReceiverEncode(f.data(), kFrameLength, 0x50, (int8_t)-8, encoded);
+        if(i==1){
+            encoded[20] ^= 0x10; //Checksum fails
+        }
+        stream.insert(stream.end(), encoded, encoded+n);
+    }
+    const uint8_t other[] = {3, 0x12, 0x34};
+    size_t n = ReceiverEncode(other, 3, 0x60, 10, encoded);
+    stream.insert(stream.end(), encoded, encoded+n);
+    for(size_t piece : {stream.size(), (size_t)1, (size_t)7}){
+        ReceiverParser parser;
+        std::vector<uint32_t> counts;
+        size_t others = 0;
+        bool fields = true;
+        for(size_t i=0;i<stream.size();i+=piece){
+            parser.Feed(stream.data()+i, std::min(piece, stream.size()-i),
+                        [&](const uint8_t* p, size_t length, uint8_t rssi, int8_t snr){
+                if(length!=kFrameLength){
+                    others++;
+                    fields &= length==3 && p[1]==0x12 && rssi==0x60 && snr==10;
+                    return;
+                }
+                counts.push_back(p[15]);
+                fields &= rssi==0x50 && snr==-8 && ValidateFrame(p)==kFrameOk;
+            });
+        }
+        Check(counts.size()==2 && counts[0]==0 && counts[1]==2 && others==1 && fields, "receiver frames");
+        Check(parser.BadChecksums()==1 && parser.Frames()==3, "receiver checksum");
+    }
+    Check(Near(RssiDbm(0x50, -8), 80-157-2, 1e-6), "RSSI in dBm");
+}
+
+void TestQueue(){
+    BoundedQueue<uint32_t> queue(64);
+    Check(queue.Capacity()==64, "queue capacity");
+    uint32_t value = 0;
+    Check(!queue.TryPop(value), "empty queue");
+    for(uint32_t i=0;i<64;i++){
+        queue.TryPush(i);
+    }
+    Check(!queue.TryPush(64) && queue.Size()==64, "full queue");
+    Check(queue.TryPop(value) && value==0, "first in first out");
+    while(queue.TryPop(value)){
+    }
+    //Two producers and two consumers, every item comes out once
+    constexpr uint32_t kItems = 200000;
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint32_t> popped{0};
+    std::vector<std::thread> threads;
+    for(int p=0;p<2;p++){
+        threads.emplace_back([&queue, p]{
+            Backoff backoff;
+            for(uint32_t i=p;i<kItems;i+=2){
+                while(!queue.TryPush(i)){
+                    backoff.Wait();
+                }
+                backoff.Reset();
+            }
+        });
+    }
+    for(int c=0;c<2;c++){
+        threads.emplace_back([&]{
+            Backoff backoff;
+            uint32_t item;
+            while(popped.load()<kItems){
+                if(queue.TryPop(item)){
+                    sum += item;
+                    popped++;
+                    backoff.Reset();
+                }
+                else{
+                    backoff.Wait();
+                }
+            }
+        });
+    }
+    for(std::thread& thread : threads){
+        thread.join();
+    }
+    Check(popped==kItems && sum==(uint64_t)kItems*(kItems-1)/2, "concurrent queue");
+}
+
+void TestPipeline(){
+    //Two receivers each hear 100 frames 67s apart from 3 nodes, more than
+    //the sequence window, and one frame is damaged at one of them.  Node 1
+    //misses counts 10 and 11 and sends them in a log packet after count 14.
+    //The frames are submitted in time order with their receive times, as
+    //uvreplay does
+    char root[] = "/tmp/uvgwtest-XXXXXX";
+    Check(mkdtemp(root)!=nullptr, "temporary directory");
+    std::string dir = root;
+    constexpr uint32_t kCounts = 100;
+    PipelineConfig config;
+    config.storeRoot = dir+"/store";
+    config.batch = 8;
+    config.batches = 4;
+    config.queueFrames = 16;
+    Pipeline pipeline(config);
+    std::string error;
+    Check(pipeline.Start(error), "pipeline start");
+    auto submit = [&](const std::vector<uint8_t>& frame, uint64_t seconds, uint16_t receiver){
+        RxFrame r;
+        r.timeNs = seconds*1000000000ull+receiver*1000;
+        r.receiver = receiver;
+        r.rssi = 0x50;
+        r.snr = 20;
+        std::memcpy(r.payload, frame.data(), kFrameLength);
+        pipeline.Submit(r);
+    };
+    const uint64_t kStart = 1790000000;
+    for(uint32_t count=0;count<kCounts;count++){
+        for(uint64_t node=1;node<=3;node++){
+            if(node==1 && (count==10 || count==11)){
+                continue;
+            }
+            for(uint16_t receiver=0;receiver<2;receiver++){
+                std::vector<uint8_t> frame = MakeFrame(node, count, (uint16_t)(node*100+count));
+                if(receiver==1 && node==2 && count==5){
+                    frame[30] ^= 1;
+                }
+                submit(frame, kStart+count*67+node, receiver);
+            }
+            if(node==1 && count==14){
+                submit(MakeLogFrame(1, {10, 11}), kStart+count*67+node+1, 0);
+                submit(MakeLogFrame(1, {10, 11}), kStart+count*67+node+1, 1);
+            }
+        }
+    }
+    pipeline.Finish();
+    const PipelineStats& s = pipeline.Stats();
+    Check(s.read.items==6*kCounts-2 && s.badFrames==1 && s.logPackets==2 && s.logRecords==2 &&
+          s.duplicates==3*kCounts-1, "pipeline frame counts");
+    Check(s.decode.items==6*kCounts-2 && s.calibrate.items==6*kCounts+2 && s.store.items==3*kCounts &&
+          s.storeErrors==0, "pipeline stage counts");
+    Check(s.LatencyPercentile(1.0)>0, "pipeline latency");
+    NodeStats total = pipeline.Nodes().Totals();
+    Check(pipeline.Nodes().Nodes()==3 && total.lost==0 && total.reboots==0, "pipeline sequence");
+    bool stored = true;
+    for(uint64_t node=1;node<=3;node++){
+        NodeReader reader;
+        ScanColumns columns;
+        stored &= reader.Open(config.storeRoot, node) && reader.Scan(0, UINT32_MAX, kAllFields, columns)==kCounts;
+        //Two decode workers, so rows can be stored a batch out of order
+        std::vector<bool> seen(kCounts);
+        for(size_t i=0;stored && i<kCounts;i++){
+            uint32_t count = columns.count[i];
+            stored &= count<kCounts && columns.word[kFieldUva][i]==node*100+count && !seen[count];
+            seen[count] = true;
+            //Logged samples timed from their counts, within a few seconds
+            //of when they were sent as the cycle is 67s not kCycleSeconds
+            bool logged = node==1 && (count==10 || count==11);
+            int64_t late = (int64_t)columns.time[i]-(int64_t)(kStart+count*67+node);
+            stored &= columns.word[kFieldFlags][i]==(logged ? kSampleTimeFromCount : 0) &&
+                      (logged ? late>=-12 && late<=12 : late==0);
+        }
+    }
+    Check(stored, "pipeline stored every frame once");
+    //A receiver stream file with a packet from another sensor type and a
+    //log packet from a node with a 12-bit ADC, whose 10-bit records are
+    //stored at 12 bits.  Two files would be read out of step, so are
+    //refused.
+    std::string path = dir+"/rx.bin";
+    FILE* f = std::fopen(path.c_str(), "wb");
+    uint8_t encoded[255+kReceiverOverhead];
+    for(uint32_t count=0;count<5;count++){
+        std::vector<uint8_t> frame = MakeFrame(4, count, (uint16_t)count);
+        std::fwrite(encoded, 1, ReceiverEncode(frame.data(), kFrameLength, 0x50, 20, encoded), f);
+    }
+    const uint8_t other[] = {3, 0x12, 0x34};
+    std::fwrite(encoded, 1, ReceiverEncode(other, 3, 0x60, 10, encoded), f);
+    std::vector<uint8_t> log = Hex(kLogPacket);
+    std::fwrite(encoded, 1, ReceiverEncode(log.data(), kFrameLength, 0x50, 20, encoded), f);
+    std::fclose(f);
+    PipelineConfig file;
+    file.sources = {"file:"+path};
+    file.storeRoot = dir+"/file";
+    NodeCalibration wide;
+    wide.adcBits = 12;
+    file.calibration.Set(0x6EDA82333366F5E6ull, wide);
+    Pipeline fromFile(file);
+    Check(fromFile.Start(error), "pipeline start");
+    fromFile.Finish();
+    const PipelineStats& fs = fromFile.Stats();
+    Check(fs.read.items==6 && fs.otherPackets==1 && fs.badFrames==0 && fs.logPackets==1 && fs.logRecords==2 &&
+          fs.store.items==7 && fromFile.Nodes().Nodes()==2, "receiver file counts");
+    NodeReader logged;
+    ScanColumns loggedRows;
+    Check(logged.Open(file.storeRoot, 0x6EDA82333366F5E6ull) &&
+          logged.Scan(0, UINT32_MAX, kAllFields, loggedRows)==2 && loggedRows.word[kFieldBatt][0]==475*4 &&
+          loggedRows.word[kFieldTemp][1]==454*4 && loggedRows.word[kFieldFlags][1]==kSampleTimeFromCount,
+          "log records stored at the node's ADC width");
+    file.sources = {path, "file:"+path};
+    Pipeline twoFiles(file);
+    Check(!twoFiles.Start(error) && !error.empty(), "two receiver files refused");
+    std::system(("rm -rf "+dir).c_str());
+}
+
+void TestLoadgen(){
+    LoadConfig config;
+    Check(Near(config.Airtime(), 0.09754, 1e-5), "airtime of a 50 byte packet at SF7");
+    Check(Near(LoRaAirtime(12, 125000, 1, 8, true, false, true, 50), 2.30195, 1e-4), "airtime at SF12");
+    //Sensitivity, capture and lock on, times in airtimes
+    std::vector<Reception> r = {
+        {0.0, 1.0, -90, false},     //Alone
+        {2.0, 3.0, -130, false},    //Too weak, but still interferes
+        {2.5, 3.5, -100, false},    //Captures over the weak one
+        {5.0, 6.0, -100, false},    //Locked on, lost to the stronger one below
+        {5.5, 6.5, -80, false},     //Stronger but after the first preamble
+        {8.0, 9.0, -100, false},    //Lost, the next captures in its preamble
+        {8.05, 9.05, -90, false},
+        {10.0, 11.0, -100, false},  //Two of the same level, both lost
+        {10.5, 11.5, -100, false},
+    };
+    size_t received = ResolveReceptions(r, 0.13, -123, 6);
+    const bool expected[] = {true, false, true, false, false, false, true, false, false};
+    bool match = received==3;
+    for(size_t i=0;i<r.size();i++){
+        match &= r[i].received==expected[i];
+    }
+    Check(match, "capture and lock on");
+    //Few nodes deliver nearly everything, many do not, and runs repeat
+    config.nodes = 20;
+    config.seconds = 3600;
+    config.receivers = 2;
+    config.rssiMinDbm = -110;
+    std::vector<RxFrame> heard;
+    bool valid = true;
+    LoadResult few = RunLoad(config, [&](uint32_t receiver, uint64_t timeNs, uint8_t rssi, int8_t snr,
+                                         const uint8_t* f){
+        valid &= ValidateFrame(f)==kFrameOk;
+        RxFrame r;
+        r.timeNs = timeNs;
+        r.receiver = (uint16_t)receiver;
+        r.rssi = rssi;
+        r.snr = snr;
+        std::memcpy(r.payload, f, kFrameLength);
+        heard.push_back(r);
+    });
+    Check(valid && few.cycles>1000 && few.Pdr()>0.95, "light load delivered");
+    LoadResult again = RunLoad(config);
+    Check(again.received==few.received && again.collided==few.collided, "repeatable");
+    config.nodes = 2000;
+    config.seconds = 600;
+    config.receivers = 1;
+    Check(RunLoad(config).Pdr()<0.2, "overloaded channel");
+    //Both receivers' frames through the pipeline in time order, as uvreplay
+    //merges their captures, store each frame once
+    std::stable_sort(heard.begin(), heard.end(), [](const RxFrame& x, const RxFrame& y){ return x.timeNs<y.timeNs; });
+    PipelineConfig pipe;
+    Pipeline pipeline(pipe);
+    std::string error;
+    Check(pipeline.Start(error), "pipeline start");
+    for(const RxFrame& r : heard){
+        pipeline.Submit(r);
+    }
+    pipeline.Finish();
+    Check(pipeline.Stats().store.items==few.received && pipeline.Stats().badFrames==0 &&
+          pipeline.Stats().read.items==few.receptions, "load through the pipeline");
+}
+
+void TestCapture(){
+    char root[] = "/tmp/uvgwtest-XXXXXX";
+    Check(mkdtemp(root)!=nullptr, "temporary directory");
+    std::string dir = root;
+    std::string path = dir+"/a.uvcap";
+    constexpr uint64_t kStart = 1790000000000000000ull;
+    constexpr uint64_t kStep = 1000000;     //1ms
+    //2500 packets, 2 complete index blocks, then 600 more after reopening
+    CaptureWriter writer;
+    std::string error;
+    Check(writer.Open(path, error), "capture create");
+    RxFrame frame;
+    for(uint32_t i=0;i<3100;i++){
+        if(i==2500){
+            Check(writer.Close() && writer.Open(path, error) && writer.Records()==2500, "capture reopen");
+        }
+        std::vector<uint8_t> f = MakeFrame(1+i%3, i/3, (uint16_t)i);
+        frame.timeNs = kStart+i*kStep;
+        frame.receiver = (uint16_t)(i%2);
+        frame.rssi = (uint8_t)i;
+        frame.snr = (int8_t)(i%64-32);
+        std::memcpy(frame.payload, f.data(), kFrameLength);
+        writer.Append(frame);
+    }
+    Check(writer.Close(), "capture close");
+    struct stat s;
+    Check(stat(path.c_str(), &s)==0 && s.st_size==(off_t)(kCaptureHeader+3100*sizeof(CaptureRecord)) &&
+          stat((path+".idx").c_str(), &s)==0 && s.st_size==(off_t)(kCaptureHeader+3*sizeof(CaptureIndexEntry)),
+          "capture sizes");
+    CaptureReader reader;
+    Check(reader.Open(path, error) && reader.Records()==3100 && reader.IndexedBlocks()==3, "capture open");
+    reader.Frame(2345, frame);
+    Check(frame.timeNs==kStart+2345*kStep && frame.receiver==1 && frame.rssi==(uint8_t)2345 &&
+          frame.snr==2345%64-32 && std::memcmp(frame.payload, MakeFrame(1+2345%3, 2345/3, 2345).data(),
+                                               kFrameLength)==0, "capture record");
+    Check(reader.Seek(0)==0 && reader.Seek(kStart+1500*kStep)==1500 && reader.Seek(kStart+1500*kStep+1)==1501 &&
+          reader.Seek(kStart+3099*kStep)==3099 && reader.Seek(kStart+3100*kStep)==3100, "capture seek");
+
+    //A torn record is cut off and a lost index rebuilt
+    FILE* f = std::fopen(path.c_str(), "ab");
+    std::fwrite("torn", 1, 4, f);
+    std::fclose(f);
+    std::remove((path+".idx").c_str());
+    CaptureReader unindexed;
+    Check(unindexed.Open(path, error) && unindexed.Records()==3100 && unindexed.IndexedBlocks()==0 &&
+          unindexed.Seek(kStart+2000*kStep)==2000, "capture without index");
+    Check(writer.Open(path, error) && writer.Records()==3100 && writer.Close(), "capture repair");
+    CaptureReader repaired;
+    Check(repaired.Open(path, error) && repaired.IndexedBlocks()==3 && stat(path.c_str(), &s)==0 &&
+          s.st_size==(off_t)(kCaptureHeader+3100*sizeof(CaptureRecord)), "capture repaired");
+
+    //A second capture between the first's records, merged in time order
+    std::string other = dir+"/b.uvcap";
+    Check(writer.Open(other, error), "capture create");
+    for(uint32_t i=0;i<100;i++){
+        frame.timeNs = kStart+i*kStep+kStep/2;
+        frame.receiver = 2;
+        writer.Append(frame);
+    }
+    writer.Close();
+    CaptureReader second;
+    Check(second.Open(other, error), "capture open");
+    ReplayConfig replay;
+    replay.speed = 0;
+    replay.fromNs = kStart+50*kStep;
+    replay.toNs = kStart+149*kStep;
+    std::vector<uint64_t> times;
+    uint64_t replayed = ReplayCaptures({&repaired, &second}, replay, [&](const RxFrame& r){ times.push_back(r.timeNs); });
+    Check(replayed==150 && times.size()==150 && std::is_sorted(times.begin(), times.end()) &&
+          times.front()==kStart+50*kStep, "replay merge and range");
+    //200ms of capture at 10 times
+    replay.speed = 10;
+    replay.fromNs = 0;
+    replay.toNs = kStart+200*kStep;
+    auto start = std::chrono::steady_clock::now();
+    ReplayCaptures({&repaired}, replay, [](const RxFrame&){});
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    Check(elapsed>=0.019 && elapsed<0.5, "replay pacing");
+
+    //Recorded by the pipeline and replayed into another gives the same store
+    std::string stream = dir+"/rx.bin";
+    f = std::fopen(stream.c_str(), "wb");
+    uint8_t encoded[kFrameLength+kReceiverOverhead];
+    for(uint32_t count=0;count<50;count++){
+        for(uint64_t node=1;node<=4;node++){
+            std::vector<uint8_t> packet = MakeFrame(node, count, (uint16_t)count);
+            std::fwrite(encoded, 1, ReceiverEncode(packet.data(), kFrameLength, 0x50, 20, encoded), f);
+        }
+    }
+    std::fclose(f);
+    PipelineConfig config;
+    config.sources = {stream};
+    config.capture = dir+"/recorded.uvcap";
+    {
+        Pipeline pipeline(config);
+        Check(pipeline.Start(error), "pipeline start");
+        pipeline.Finish();
+        Check(pipeline.Stats().captureErrors==0, "pipeline capture");
+    }
+    CaptureReader recorded;
+    Check(recorded.Open(config.capture, error) && recorded.Records()==200, "pipeline recorded");
+    config.sources.clear();
+    config.capture.clear();
+    config.storeRoot = dir+"/store";
+    Pipeline pipeline(config);
+    Check(pipeline.Start(error), "pipeline start");
+    replay.speed = 0;
+    replay.toNs = UINT64_MAX;
+    ReplayCaptures({&recorded}, replay, [&](const RxFrame& r){ pipeline.Submit(r); });
+    pipeline.Finish();
+    Check(pipeline.Stats().read.items==200 && pipeline.Stats().store.items==200 && pipeline.Stats().badFrames==0 &&
+          StoreNodes(config.storeRoot).size()==4, "replay into the pipeline");
+    std::system(("rm -rf "+dir).c_str());
+}
+
+} // namespace
+
+int main(int argc, char** argv){
+    if(argc>1){
+        goldenDir = argv[1];
+    }
+    TestCrc();
+    TestDecode();
+    TestCalibrate();
+    TestStore();
+    TestNodes();
+    TestReceiver();
+    TestQueue();
+    TestPipeline();
+    TestLoadgen();
+    TestCapture();
+    std::printf("%s: %u failure%s\n", failures ? "FAILED" : "passed", failures, failures==1 ? "" : "s");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,102 @@
+/**
+ * uvgateway.cpp
+ * Gateway ingest: receiver streams in, node history out (see pipeline.h).
+ *   uvgateway [-d store dir] [-w decode workers] [-b batch] [-t batch wait us]
+ *             [-q frame queue] [-n batches] [-f flush s] [-o readings.csv]
+ *             [-i stats interval s] [-c capture] source...
+ * -o - writes the calibrated readings to stdout.  -c records every frame
+ * read to a capture (appending), for uvreplay.
+ * Sources are serial:/dev/ttyUSB0[:baud], udp:port or a file.  Runs until
+ * the file has been read or, with serial or UDP sources, until SIGINT or
+ * SIGTERM.  A file is stamped with the time it is read, so only one can be
+ * given; replay captures of several receivers with uvreplay instead.  Stage
+ * statistics go to stderr.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include "pipeline.h"
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <unistd.h>
+
+using namespace gateway;
+
+namespace {
+
+Pipeline* running = nullptr;
+
+void OnSignal(int){
+    if(running){
+        running->RequestStop();
+    }
+}
+
+void Usage(){
+    std::fprintf(stderr, "usage: uvgateway [-d store] [-w workers] [-b batch] [-t batch_wait_us] [-q queue]\n"
+                         "                 [-n batches] [-f flush_s] [-o readings.csv] [-i interval_s] [-c capture]\n"
+                         "                 source...\n");
+    std::exit(2);
+}
+
+} // namespace
+
+int main(int argc, char** argv){
+    PipelineConfig config;
+    double interval = 10.0;
+    int option;
+    while((option = getopt(argc, argv, "d:w:b:t:q:n:f:o:i:c:h"))!=-1){
+        switch(option){
+            case 'd': config.storeRoot = optarg; break;
+            case 'w': config.workers = std::strtoul(optarg, nullptr, 0); break;
+            case 'b': config.batch = std::strtoul(optarg, nullptr, 0); break;
+            case 't': config.batchWaitUs = (unsigned)std::strtoul(optarg, nullptr, 0); break;
+            case 'q': config.queueFrames = std::strtoul(optarg, nullptr, 0); break;
+            case 'n': config.batches = std::strtoul(optarg, nullptr, 0); break;
+            case 'f': config.flushSeconds = (unsigned)std::strtoul(optarg, nullptr, 0); break;
+            case 'o':
+                config.readings = std::string(optarg)=="-" ? stdout : std::fopen(optarg, "w");
+                if(!config.readings){
+                    std::perror(optarg);
+                    return 1;
+                }
+                break;
+            case 'i': interval = std::atof(optarg); break;
+            case 'c': config.capture = optarg; break;
+            default: Usage();
+        }
+    }
+    if(optind>=argc){
+        Usage();
+    }
+    config.sources.assign(argv+optind, argv+argc);
+    Pipeline pipeline(config);
+    std::string error;
+    if(!pipeline.Start(error)){
+        std::fprintf(stderr, "uvgateway: %s\n", error.c_str());
+        return 1;
+    }
+    running = &pipeline;
+    std::signal(SIGINT, OnSignal);
+    std::signal(SIGTERM, OnSignal);
+    auto start = std::chrono::steady_clock::now();
+    auto next = start+std::chrono::duration<double>(interval);
+    while(!pipeline.InputDone()){
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        if(interval>0 && std::chrono::steady_clock::now()>=next){
+            pipeline.PrintStats(stderr, std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count());
+            next += std::chrono::duration<double>(interval);
+        }
+    }
+    pipeline.Finish();
+    running = nullptr;
+    pipeline.PrintStats(stderr, std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count());
+    if(config.readings && config.readings!=stdout){
+        std::fclose(config.readings);
+    }
+    return pipeline.Stats().storeErrors || pipeline.Stats().captureErrors ? 1 : 0;
+}
@@ -0,0 +1,207 @@
+/**
+ * uvloadgen.cpp
+ * Synthetic sensor network load (see loadgen.h).
+ *   uvloadgen [-n nodes] [-H hours] [-R receivers] [-r seed] [-s start spread s]
+ *             [-m jitter|slots|none] [-L] [-c capture dB] [-w wdt spread]
+ *             [-o prefix] [-C capture] [-u host:port] [-x speed]
+ *   uvloadgen -N 10,100,1000 [options]   packet delivery ratio against nodes
+ * -o writes each receiver's stream to prefix0.bin, prefix1.bin ...  (streams
+ * carry no times, so uvgateway takes only one of them).  -u sends it as UDP
+ * datagrams to port, port+1 ... at speed times real time (0 for as fast as
+ * possible).  -C writes every receiver's packets to one capture
+ * (capture.h), for uvreplay.  -L turns listen before talk off.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include "capture.h"
+#include "loadgen.h"
+#include "receiver.h"
+
+#include <arpa/inet.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <netdb.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace gateway;
+
+namespace {
+
+void Usage(){
+    std::fprintf(stderr, "usage: uvloadgen [-n nodes | -N n1,n2,...] [-H hours] [-R receivers] [-r seed]\n"
+                         "                 [-s start_spread_s] [-m jitter|slots|none] [-L] [-c capture_db]\n"
+                         "                 [-w wdt_spread] [-o prefix] [-C capture] [-u host:port] [-x speed]\n");
+    std::exit(2);
+}
+
+void PrintHeader(){
+    std::printf("%8s %8s %10s %10s %9s %9s %9s %9s %7s %7s\n", "nodes", "G", "cycles", "received", "lbt_defer",
+                "lbt_drop", "collided", "weak", "pdr", "aloha");
+}
+
+void PrintResult(uint32_t nodes, const LoadResult& r){
+    std::printf("%8u %8.4f %10llu %10llu %9llu %9llu %9llu %9llu %7.4f %7.4f\n", nodes, r.offeredLoad,
+                (unsigned long long)r.cycles, (unsigned long long)r.received, (unsigned long long)r.lbtDeferred,
+                (unsigned long long)r.lbtGaveUp, (unsigned long long)r.collided, (unsigned long long)r.weak, r.Pdr(),
+                std::exp(-2.0*r.offeredLoad));
+}
+
+} // namespace
+
+int main(int argc, char** argv){
+    LoadConfig config;
+    std::vector<uint32_t> sweep;
+    std::string prefix;
+    std::string capturePath;
+    std::string udp;
+    double speed = 1.0;
+    int option;
+    while((option = getopt(argc, argv, "n:N:H:R:r:s:m:Lc:w:o:C:u:x:h"))!=-1){
+        switch(option){
+            case 'n': config.nodes = (uint32_t)std::strtoul(optarg, nullptr, 0); break;
+            case 'N':
+                for(char* p = optarg;*p;){
+                    sweep.push_back((uint32_t)std::strtoul(p, &p, 0));
+                    if(*p==','){
+                        p++;
+                    }
+                    else if(*p){
+                        Usage();
+                    }
+                }
+                break;
+            case 'H': config.seconds = std::atof(optarg)*3600.0; break;
+            case 'R': config.receivers = (uint32_t)std::strtoul(optarg, nullptr, 0); break;
+            case 'r': config.seed = std::strtoull(optarg, nullptr, 0); break;
+            case 's': config.startSpread = std::atof(optarg); break;
+            case 'm':
+                if(!std::strcmp(optarg, "jitter")){
+                    config.schedule = kScheduleJitter;
+                }
+                else if(!std::strcmp(optarg, "slots")){
+                    config.schedule = kScheduleSlots;
+                }
+                else if(!std::strcmp(optarg, "none")){
+                    config.schedule = kScheduleNone;
+                }
+                else{
+                    Usage();
+                }
+                break;
+            case 'L': config.lbt = false; break;
+            case 'c': config.captureDb = std::atof(optarg); break;
+            case 'w': config.wdtSpread = std::atof(optarg); break;
+            case 'o': prefix = optarg; break;
+            case 'C': capturePath = optarg; break;
+            case 'u': udp = optarg; break;
+            case 'x': speed = std::atof(optarg); break;
+            default: Usage();
+        }
+    }
+    if(optind<argc || config.receivers<1){
+        Usage();
+    }
+    std::fprintf(stderr, "uvloadgen: airtime %.2fms, %.1f hours, %u receiver%s, seed %llu\n", config.Airtime()*1e3,
+                 config.seconds/3600.0, config.receivers, config.receivers==1 ? "" : "s",
+                 (unsigned long long)config.seed);
+    if(!sweep.empty()){
+        PrintHeader();
+        for(uint32_t nodes : sweep){
+            config.nodes = nodes;
+            PrintResult(nodes, RunLoad(config));
+            std::fflush(stdout);
+        }
+        return 0;
+    }
+
+    std::vector<FILE*> files;
+    for(uint32_t r=0;!prefix.empty() && r<config.receivers;r++){
+        std::string path = prefix+std::to_string(r)+".bin";
+        files.push_back(std::fopen(path.c_str(), "wb"));
+        if(!files.back()){
+            std::perror(path.c_str());
+            return 1;
+        }
+    }
+    CaptureWriter capture;
+    std::string error;
+    if(!capturePath.empty() && !capture.Open(capturePath, error)){
+        std::fprintf(stderr, "uvloadgen: %s\n", error.c_str());
+        return 1;
+    }
+    int sock = -1;
+    std::vector<struct sockaddr_in> targets;
+    if(!udp.empty()){
+        size_t colon = udp.rfind(':');
+        if(colon==std::string::npos){
+            Usage();
+        }
+        struct addrinfo hints = {};
+        struct addrinfo* found;
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_DGRAM;
+        if(getaddrinfo(udp.substr(0, colon).c_str(), nullptr, &hints, &found)!=0){
+            std::fprintf(stderr, "uvloadgen: cannot resolve %s\n", udp.c_str());
+            return 1;
+        }
+        int port = std::atoi(udp.c_str()+colon+1);
+        for(uint32_t r=0;r<config.receivers;r++){
+            struct sockaddr_in target = *(struct sockaddr_in*)found->ai_addr;
+            target.sin_port = htons((uint16_t)(port+r));
+            targets.push_back(target);
+        }
+        freeaddrinfo(found);
+        sock = socket(AF_INET, SOCK_DGRAM, 0);
+    }
+    auto start = std::chrono::steady_clock::now();
+    uint64_t firstNs = 0;
+    uint8_t encoded[kFrameLength+kReceiverOverhead];
+    LoadResult result = RunLoad(config, [&](uint32_t receiver, uint64_t timeNs, uint8_t rssi, int8_t snr,
+                                            const uint8_t* frame){
+        size_t n = ReceiverEncode(frame, kFrameLength, rssi, snr, encoded);
+        if(!files.empty()){
+            std::fwrite(encoded, 1, n, files[receiver]);
+        }
+        if(!capturePath.empty()){
+            RxFrame rx;
+            rx.timeNs = timeNs;
+            rx.ingestNs = 0;
+            rx.receiver = (uint16_t)receiver;
+            rx.rssi = rssi;
+            rx.snr = snr;
+            std::memcpy(rx.payload, frame, kFrameLength);
+            capture.Append(rx);
+        }
+        if(sock>=0){
+            if(!firstNs){
+                firstNs = timeNs;
+                start = std::chrono::steady_clock::now();
+            }
+            if(speed>0){
+                std::this_thread::sleep_until(start+std::chrono::nanoseconds((uint64_t)((timeNs-firstNs)/speed)));
+            }
+            sendto(sock, encoded, n, 0, (struct sockaddr*)&targets[receiver], sizeof targets[receiver]);
+        }
+    });
+    for(FILE* f : files){
+        std::fclose(f);
+    }
+    if(!capturePath.empty() && !capture.Close()){
+        std::perror(capturePath.c_str());
+        return 1;
+    }
+    if(sock>=0){
+        close(sock);
+    }
+    PrintHeader();
+    PrintResult(config.nodes, result);
+    return 0;
+}
@@ -0,0 +1,140 @@
+/**
+ * uvreplay.cpp
+ * Replays captures (see capture.h) into the ingest pipeline, as uvgateway
+ * would have taken them from its receivers.
+ *   uvreplay [-x speed | -a] [-s from] [-e to] [-d store dir] [-w decode workers]
+ *            [-b batch] [-o readings.csv] [-i stats interval s] capture...
+ *   uvreplay -p [-s from] [-e to] capture...    lists the packets
+ * -x replays at speed times the original (1 by default), -a as fast as the
+ * pipeline takes them.  -s and -e limit the replay to Unix times.  Several
+ * captures, say one per receiver, are merged in time order.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include "capture.h"
+#include "pipeline.h"
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <unistd.h>
+
+using namespace gateway;
+
+namespace {
+
+std::atomic<bool> stop{false};
+
+void OnSignal(int){
+    stop.store(true, std::memory_order_relaxed);
+}
+
+void Usage(){
+    std::fprintf(stderr, "usage: uvreplay [-x speed | -a] [-s from] [-e to] [-d store] [-w workers] [-b batch]\n"
+                         "                [-o readings.csv] [-i interval_s] capture...\n"
+                         "       uvreplay -p [-s from] [-e to] capture...\n");
+    std::exit(2);
+}
+
+void Print(const RxFrame& f){
+    static ReadingBuffer buffer(1);
+    const ReadingColumns& c = buffer.Columns();
+    uint8_t status = DecodeFrame(f.payload, c, 0);
+    std::printf("%llu.%09llu %u %6.1f %5.2f %016llX %10u %s\n", (unsigned long long)(f.timeNs/1000000000ull),
+                (unsigned long long)(f.timeNs%1000000000ull), f.receiver, RssiDbm(f.rssi, f.snr), f.snr*0.25,
+                (unsigned long long)c.address[0], c.count[0],
+                status==kFrameOk ? "ok" : IsLogFrame(status, c.id1[0]) ? "log" : "bad");
+}
+
+} // namespace
+
+int main(int argc, char** argv){
+    PipelineConfig config;
+    ReplayConfig replay;
+    double interval = 10.0;
+    bool print = false;
+    int option;
+    while((option = getopt(argc, argv, "x:as:e:d:w:b:o:i:ph"))!=-1){
+        switch(option){
+            case 'x': replay.speed = std::atof(optarg); break;
+            case 'a': replay.speed = 0; break;
+            case 's': replay.fromNs = (uint64_t)(std::atof(optarg)*1e9); break;
+            case 'e': replay.toNs = (uint64_t)(std::atof(optarg)*1e9); break;
+            case 'd': config.storeRoot = optarg; break;
+            case 'w': config.workers = std::strtoul(optarg, nullptr, 0); break;
+            case 'b': config.batch = std::strtoul(optarg, nullptr, 0); break;
+            case 'o':
+                config.readings = std::string(optarg)=="-" ? stdout : std::fopen(optarg, "w");
+                if(!config.readings){
+                    std::perror(optarg);
+                    return 1;
+                }
+                break;
+            case 'i': interval = std::atof(optarg); break;
+            case 'p': print = true; break;
+            default: Usage();
+        }
+    }
+    if(optind>=argc || replay.speed<0){
+        Usage();
+    }
+    std::vector<std::unique_ptr<CaptureReader>> readers;
+    std::vector<const CaptureReader*> captures;
+    uint64_t records = 0;
+    for(int i=optind;i<argc;i++){
+        readers.emplace_back(new CaptureReader);
+        std::string error;
+        if(!readers.back()->Open(argv[i], error)){
+            std::fprintf(stderr, "uvreplay: %s\n", error.c_str());
+            return 1;
+        }
+        captures.push_back(readers.back().get());
+        records += readers.back()->Records();
+    }
+    std::signal(SIGINT, OnSignal);
+    std::signal(SIGTERM, OnSignal);
+    if(print){
+        replay.speed = 0;
+        ReplayCaptures(captures, replay, Print, &stop);
+        return 0;
+    }
+
+    Pipeline pipeline(config);
+    std::string error;
+    if(!pipeline.Start(error)){
+        std::fprintf(stderr, "uvreplay: %s\n", error.c_str());
+        return 1;
+    }
+    std::fprintf(stderr, "uvreplay: %llu records in %zu capture%s\n", (unsigned long long)records, captures.size(),
+                 captures.size()==1 ? "" : "s");
+    std::atomic<bool> done{false};
+    uint64_t replayed = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::thread feeder([&]{
+        replayed = ReplayCaptures(captures, replay, [&](const RxFrame& f){ pipeline.Submit(f); }, &stop);
+        done = true;
+    });
+    auto next = start+std::chrono::duration<double>(interval);
+    while(!done){
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        if(interval>0 && std::chrono::steady_clock::now()>=next){
+            pipeline.PrintStats(stderr, std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count());
+            next += std::chrono::duration<double>(interval);
+        }
+    }
+    feeder.join();
+    pipeline.Finish();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    pipeline.PrintStats(stderr, seconds);
+    std::fprintf(stderr, "uvreplay: %llu frames in %.3fs, %.0f frames/s\n", (unsigned long long)replayed, seconds,
+                 seconds>0 ? replayed/seconds : 0.0);
+    if(config.readings && config.readings!=stdout){
+        std::fclose(config.readings);
+    }
+    return pipeline.Stats().storeErrors ? 1 : 0;
+}
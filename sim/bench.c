@@ -0,0 +1,360 @@
+/**
+ * bench.c
+ * Regression checks and benchmarks for the firmware's pure compute paths,
+ * built against the simulator:
+ *   - CRC16() against check values, and its speed against a bitwise CRC
+ *   - buildPacket() byte for byte against golden v5 packets
+ *   - LoRaSetFrequency()/LoRaGetFrequency() FRF values and round trip, with
+ *     the float arithmetic compared against an integer version
+ *   - a whole simulated run against golden packets (contents and times)
+ * Benchmark results are appended to a CSV file so runs can be compared.
+ *   uvbench [-q] [-g] [-r results.csv]
+ *   -q  regression checks only     -g  rewrite the golden files
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <xc.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "CRC16.h"
+#include "LoRa.h"
+#include "spi2.h"
+
+#ifndef BENCH_REVISION
+#define BENCH_REVISION "unknown"
+#endif
+#define BENCH_MIN_NS 200000000ULL  //Each benchmark runs for at least this long
+#define BENCH_PACKET 50
+#define BENCH_GOLDEN_PACKETS "golden/packets-v5.txt"
+#define BENCH_GOLDEN_RUN "golden/run-v5.txt"
+#define BENCH_RUN_CYCLES 5
+
+//Firmware globals used by buildPacket() (main.c, uv.c)
+extern uint8_t txData[BENCH_PACKET];
+extern uint32_t messageCount;
+extern uint16_t batt, temp, vis;
+extern uint16_t uvaReading, uvbReading, comp1Reading, comp2Reading;
+void buildPacket();
+
+typedef struct {
+    uint32_t count;
+    uint16_t batt, temp, uva, uvb, comp1, comp2, vis;
+} PacketInputs;
+
+static const PacketInputs packetInputs[] = {
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {1, 525, 512, 400, 300, 50, 40, 600},
+    {0x01020304, 0x03FF, 0x0200, 0x1234, 0x5678, 0x9ABC, 0xDEF0, 0xBEEF},
+    {0xFFFFFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF},
+};
+#define PACKET_INPUTS (sizeof packetInputs/sizeof packetInputs[0])
+
+//Channels checked for FRF, MHz
+static const float channels[] = {433.05f, 433.175f, 434.79f, 863.0f, 865.2f, 866.5f, 868.1f, 868.3f, 869.525f, 902.3f, 915.0f, 927.5f};
+#define CHANNELS (sizeof channels/sizeof channels[0])
+
+static uint32_t failures = 0;
+static uint8_t regenerate = 0;
+static FILE* results = NULL;
+static volatile uint32_t sink; //Keeps results of benchmarked code alive
+
+static void check(int ok, const char* what){
+    if(!ok){
+        failures++;
+        fprintf(stderr, "FAIL: %s\n", what);
+    }
+}
+
+static uint64_t hostNs(void){
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec*SIM_NS_PER_S + t.tv_nsec;
+}
+
+/**
+ * Prints and records one benchmark result.
+ * @param picNs Virtual PIC time per operation (bus and delays only), 0 if none
+ */
+static void record(const char* benchmark, const char* variant, uint32_t bytes, uint64_t ops, uint64_t ns, double picNs){
+    double nsPerOp = (double)ns/ops;
+    double mbPerS = bytes ? bytes*1.0e3/nsPerOp : 0;
+    printf("%-10s %-16s %6u B %12.1f ns/op %10.1f MB/s", benchmark, variant, bytes, nsPerOp, mbPerS);
+    if(picNs>0){
+        printf(" %10.1f us on the PIC", picNs/1000.0);
+    }
+    printf("\n");
+    if(results){
+        char date[32];
+        time_t now = time(NULL);
+        strftime(date, sizeof date, "%Y-%m-%dT%H:%M:%S", localtime(&now));
+        fprintf(results, "%s,%s,%s,%s,%u,%llu,%.2f,%.2f,%.2f\n", date, BENCH_REVISION, benchmark, variant,
+                bytes, (unsigned long long)ops, nsPerOp, mbPerS, picNs/1000.0);
+    }
+}
+
+//Bitwise CRC-16/MODBUS, the reference for the table in CRC16.c
+static unsigned short crcBitwise(const unsigned char* data, unsigned short length){
+    unsigned short crc = 0xFFFF;
+    while(length--){
+        crc ^= *data++;
+        for(uint8_t i=0;i<8;i++){
+            crc = (crc & 1) ? (crc>>1)^0xA001 : crc>>1;
+        }
+    }
+    return crc;
+}
+
+typedef unsigned short (*CrcFunction)(const unsigned char*, unsigned short);
+
+static void benchCrc(const char* variant, CrcFunction crc, const uint8_t* data, uint16_t length){
+    uint64_t ops = 0;
+    uint64_t start = hostNs();
+    uint64_t ns;
+    do{
+        for(uint32_t i=0;i<1000;i++){
+            sink += crc(data, length);
+        }
+        ops += 1000;
+        ns = hostNs()-start;
+    }while(ns<BENCH_MIN_NS);
+    record("crc16", variant, length, ops, ns, 0);
+}
+
+static void testCrc(uint8_t benchmark){
+    const unsigned char* check1 = (const unsigned char*)"123456789";
+    check(CRC16(check1, 9)==0x4B37, "CRC16 check value for 123456789");
+    check(CRC16(check1, 0)==0xFFFF, "CRC16 of nothing");
+    uint8_t data[4096];
+    for(uint16_t i=0;i<sizeof data;i++){
+        data[i] = (uint8_t)(i*7+(i>>8));
+    }
+    check(CRC16(data, sizeof data)==crcBitwise(data, sizeof data), "CRC16 table against bitwise");
+    if(benchmark){
+        benchCrc("table", CRC16, data, BENCH_PACKET-2);
+        benchCrc("bitwise", crcBitwise, data, BENCH_PACKET-2);
+        benchCrc("table", CRC16, data, sizeof data);
+        benchCrc("bitwise", crcBitwise, data, sizeof data);
+    }
+}
+
+static void packetLoad(const PacketInputs* in){
+    messageCount = in->count;
+    batt = in->batt;
+    temp = in->temp;
+    uvaReading = in->uva;
+    uvbReading = in->uvb;
+    comp1Reading = in->comp1;
+    comp2Reading = in->comp2;
+    vis = in->vis;
+}
+
+static void hexLine(FILE* f, const uint8_t* data, uint16_t length){
+    for(uint16_t i=0;i<length;i++){
+        fprintf(f, "%02X", data[i]);
+    }
+    fprintf(f, "\n");
+}
+
+static void testPackets(uint8_t benchmark){
+    FILE* golden = fopen(BENCH_GOLDEN_PACKETS, regenerate ? "w" : "r");
+    if(!golden){
+        check(0, "open " BENCH_GOLDEN_PACKETS);
+        return;
+    }
+    for(uint8_t i=0;i<PACKET_INPUTS;i++){
+        packetLoad(&packetInputs[i]);
+        buildPacket();
+        check(txData[0]==BENCH_PACKET && txData[11]==0x05, "packet length and version bytes");
+        uint16_t crc = CRC16(txData, BENCH_PACKET-2);
+        check(txData[48]==(crc & 0xFF) && txData[49]==crc>>8, "packet CRC16 in bytes 48 (LSB) and 49 (MSB)");
+        if(regenerate){
+            hexLine(golden, txData, BENCH_PACKET);
+            continue;
+        }
+        char line[2*BENCH_PACKET+8];
+        char built[2*BENCH_PACKET+8];
+        FILE* f = fmemopen(built, sizeof built, "w");
+        hexLine(f, txData, BENCH_PACKET);
+        fclose(f);
+        if(!fgets(line, sizeof line, golden) || strcmp(line, built)){
+            fprintf(stderr, "  expected %s  built    %s", line, built);
+            check(0, "buildPacket() against golden v5 packet");
+        }
+    }
+    fclose(golden);
+    if(benchmark){
+        uint64_t ops = 0;
+        uint64_t start = hostNs();
+        uint64_t ns;
+        do{
+            for(uint32_t i=0;i<1000;i++){
+                messageCount++;
+                buildPacket();
+                sink += txData[48];
+            }
+            ops += 1000;
+            ns = hostNs()-start;
+        }while(ns<BENCH_MIN_NS);
+        record("packet", "buildPacket", BENCH_PACKET, ops, ns, 0);
+    }
+}
+
+//FRF = f*2^19/32MHz as an integer: kHz*16384/1000, reduced to stay in 32 bits
+static uint32_t frfInteger(uint32_t kHz){
+    return kHz*2048u/125u;
+}
+
+static uint32_t frfFloat(float mhz){
+    return (uint32_t)(mhz*16384); //As LoRaSetFrequency()
+}
+
+static uint32_t frfRead(void){
+    return (uint32_t)SPI2ReadByte(FRF_MSB_REG)<<16 | (uint32_t)SPI2ReadByte(FRF_MID_REG)<<8 | SPI2ReadByte(FRF_LSB_REG);
+}
+
+static void testFrequency(uint8_t benchmark){
+    SimReset();
+    SPI2Start();
+    for(uint8_t i=0;i<CHANNELS;i++){
+        char what[64];
+        uint32_t exact = (uint32_t)((double)channels[i]*16384.0);
+        LoRaSetFrequency(channels[i]);
+        snprintf(what, sizeof what, "FRF for %.3fMHz", channels[i]);
+        check(frfRead()==exact, what);
+        snprintf(what, sizeof what, "LoRaGetFrequency() round trip at %.3fMHz", channels[i]);
+        check(LoRaGetFrequency()>channels[i]-61e-6f && LoRaGetFrequency()<=channels[i], what);
+        snprintf(what, sizeof what, "integer FRF within 1 step at %.3fMHz", channels[i]);
+        int32_t step = (int32_t)frfInteger((uint32_t)(channels[i]*1000.0+0.5))-(int32_t)frfFloat(channels[i]);
+        check(step>=-1 && step<=0, what); //The float can round above the kHz value
+    }
+    if(!benchmark){
+        return;
+    }
+    uint64_t ops = 0;
+    uint64_t start = hostNs();
+    uint64_t ns;
+    do{
+        for(uint32_t i=0;i<100000;i++){
+            sink += frfFloat(channels[i%CHANNELS]);
+        }
+        ops += 100000;
+        ns = hostNs()-start;
+    }while(ns<BENCH_MIN_NS);
+    record("frf", "float", 0, ops, ns, 0);
+    static uint32_t kHz[CHANNELS];
+    for(uint8_t i=0;i<CHANNELS;i++){
+        kHz[i] = (uint32_t)(channels[i]*1000.0+0.5);
+    }
+    ops = 0;
+    start = hostNs();
+    do{
+        for(uint32_t i=0;i<100000;i++){
+            sink += frfInteger(kHz[i%CHANNELS]);
+        }
+        ops += 100000;
+        ns = hostNs()-start;
+    }while(ns<BENCH_MIN_NS);
+    record("frf", "integer", 0, ops, ns, 0);
+    //Through the SPI model, the PIC time is the bus time
+    ops = 0;
+    uint64_t pic = simNow;
+    start = hostNs();
+    do{
+        for(uint32_t i=0;i<1000;i++){
+            LoRaSetFrequency(channels[i%CHANNELS]);
+        }
+        ops += 1000;
+        ns = hostNs()-start;
+    }while(ns<BENCH_MIN_NS);
+    record("frf", "LoRaSetFrequency", 0, ops, ns, (double)(simNow-pic)/ops);
+    ops = 0;
+    pic = simNow;
+    start = hostNs();
+    do{
+        for(uint32_t i=0;i<1000;i++){
+            sink += (uint32_t)LoRaGetFrequency();
+        }
+        ops += 1000;
+        ns = hostNs()-start;
+    }while(ns<BENCH_MIN_NS);
+    record("frf", "LoRaGetFrequency", 0, ops, ns, (double)(simNow-pic)/ops);
+}
+
+/**
+ * Whole firmware from power on with the default simulation, every packet
+ * (time sent and contents) must match.  Runs first, while the firmware's
+ * globals still have their reset values.
+ */
+static void testRun(uint8_t benchmark){
+    FILE* packets = tmpfile();
+    simConfig.cycles = BENCH_RUN_CYCLES;
+    simConfig.packetOut = packets;
+    uint64_t start = hostNs();
+    SimRun();
+    uint64_t ns = hostNs()-start;
+    simConfig.packetOut = NULL;
+    rewind(packets);
+    FILE* golden = fopen(BENCH_GOLDEN_RUN, regenerate ? "w" : "r");
+    if(!golden){
+        check(0, "open " BENCH_GOLDEN_RUN);
+        fclose(packets);
+        return;
+    }
+    char line[512];
+    char expected[512];
+    uint32_t count = 0;
+    while(fgets(line, sizeof line, packets)){
+        count++;
+        if(regenerate){
+            fputs(line, golden);
+        }
+        else if(!fgets(expected, sizeof expected, golden) || strcmp(line, expected)){
+            fprintf(stderr, "  expected %s  sent     %s", expected, line);
+            check(0, "simulated run against golden packets");
+        }
+    }
+    check(count==BENCH_RUN_CYCLES, "one packet per simulated wake cycle");
+    if(!regenerate && fgets(expected, sizeof expected, golden)){
+        check(0, "simulated run sent fewer packets than golden");
+    }
+    fclose(golden);
+    fclose(packets);
+    if(benchmark){
+        record("sim", "wake cycle", 0, BENCH_RUN_CYCLES, ns, (double)simNow/BENCH_RUN_CYCLES);
+    }
+}
+
+int main(int argc, char** argv){
+    uint8_t benchmark = 1;
+    const char* resultsPath = NULL;
+    int option;
+    while((option = getopt(argc, argv, "qgr:"))!=-1){
+        switch(option){
+            case 'q': benchmark = 0; break;
+            case 'g': regenerate = 1; break;
+            case 'r': resultsPath = optarg; break;
+            default:
+                fprintf(stderr, "usage: uvbench [-q] [-g] [-r results.csv]\n");
+                return 2;
+        }
+    }
+    if(benchmark && resultsPath){
+        uint8_t header = access(resultsPath, F_OK)!=0;
+        results = fopen(resultsPath, "a");
+        if(header && results){
+            fprintf(results, "date,revision,benchmark,variant,bytes,ops,ns_per_op,mb_per_s,pic_us_per_op\n");
+        }
+    }
+    testRun(benchmark);
+    testCrc(benchmark);
+    testPackets(benchmark);
+    testFrequency(benchmark);
+    if(results){
+        fclose(results);
+    }
+    printf("%s: %u failure%s\n", failures ? "FAILED" : "passed", failures, failures==1 ? "" : "s");
+    return failures ? 1 : 0;
+}
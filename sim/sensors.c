@@ -0,0 +1,253 @@
+/**
+ * sensors.c
+ * VEML6075 and BH1750 models on the simulated I2C bus.  Both are powered from
+ * the Q1 rail, NACK until they have had time to start up, and return counts
+ * from a light script held stepwise over virtual time.
+ * Script lines: seconds uva uvb comp1 comp2 lux, with the VEML6075 counts at
+ * 100ms integration.  '#' starts a comment.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <xc.h>
+#include <stdlib.h>
+#include <string.h>
+#include "VEML6075.h"
+#include "BH1750.h"
+
+#define SENSOR_NONE 0
+#define SENSOR_VEML6075 1
+#define SENSOR_BH1750 2
+#define BH1750_MTREG_DEFAULT 69
+#define BH1750_POWER_DOWN 0x00
+#define BH1750_POWER_ON 0x01
+#define BH1750_RESET 0x07
+
+typedef struct {
+    double seconds;
+    double uva;
+    double uvb;
+    double comp1;
+    double comp2;
+    double lux;
+} LightPoint;
+
+static LightPoint* light = NULL;
+static uint32_t lightCount = 0;
+static uint8_t powered = 0;
+static uint64_t poweredAt = 0;
+static uint8_t current = SENSOR_NONE;   //Device addressed since the last start
+static uint8_t reading = 0;
+static uint8_t byteIndex = 0;           //Bytes since the address
+
+static uint16_t vemlConf = 0x0001;
+static uint64_t vemlConfAt = 0;
+static uint8_t vemlCommand = 0;
+static uint8_t vemlLow = 0;
+
+static uint8_t bhMode = BH1750_POWER_DOWN;
+static uint8_t bhMtreg = BH1750_MTREG_DEFAULT;
+static uint64_t bhStart = 0;            //Start of the measurement in progress
+static uint16_t bhResult = 0;
+
+static const LightPoint* lightNow(void){
+    static const LightPoint defaults = {0, 400, 300, 50, 40, 500};
+    if(!lightCount){
+        return &defaults;
+    }
+    double seconds = simNow/1.0e9;
+    uint32_t i = 0;
+    while(i+1<lightCount && light[i+1].seconds<=seconds){
+        i++;
+    }
+    return &light[i];
+}
+
+static uint16_t clampCount(double count){
+    return count>65535 ? 65535 : count<0 ? 0 : (uint16_t)count;
+}
+
+/**
+ * Loads the light script.
+ * @param path  Script file, NULL for a constant default
+ */
+void SensorsLoad(const char* path){
+    free(light);
+    light = NULL;
+    lightCount = 0;
+    if(!path){
+        return;
+    }
+    FILE* f = fopen(path, "r");
+    if(!f){
+        fprintf(stderr, "sim: cannot open light script %s\n", path);
+        exit(1);
+    }
+    char line[256];
+    uint32_t size = 0;
+    while(fgets(line, sizeof line, f)){
+        LightPoint p;
+        if(line[0]=='#' || sscanf(line, "%lf %lf %lf %lf %lf %lf", &p.seconds, &p.uva, &p.uvb, &p.comp1, &p.comp2, &p.lux)!=6){
+            continue;
+        }
+        if(lightCount==size){
+            size = size ? size*2 : 16;
+            light = realloc(light, size*sizeof *light);
+        }
+        light[lightCount++] = p;
+    }
+    fclose(f);
+}
+
+void SensorsRail(uint8_t on){
+    powered = on;
+    poweredAt = simNow;
+    current = SENSOR_NONE;
+    vemlConf = 0x0001; //Shut down after power up
+    bhMode = BH1750_POWER_DOWN;
+    bhMtreg = BH1750_MTREG_DEFAULT;
+    bhResult = 0;
+}
+
+static uint8_t ready(uint32_t us){
+    return powered && simNow-poweredAt>=(uint64_t)us*1000;
+}
+
+/**
+ * Address byte after a start.
+ * @return 1 for ACK
+ */
+uint8_t SensorsAddress(uint8_t address){
+    current = SENSOR_NONE;
+    reading = address & 0x01;
+    byteIndex = 0;
+    if((address & 0xFE)==VEML6075_SLAVE_ADDRESS && ready(simConfig.vemlReadyUs)){
+        current = SENSOR_VEML6075;
+    }
+    if((address & 0xFE)==BH1750_ADDRESS_L && ready(simConfig.bhReadyUs)){
+        current = SENSOR_BH1750;
+    }
+    return current!=SENSOR_NONE;
+}
+
+static uint64_t bhMeasureNs(void){
+    uint64_t ms = (bhMode & 0x03)==0x03 ? 16 : 120;
+    return ms*1000000ULL*bhMtreg/BH1750_MTREG_DEFAULT;
+}
+
+static void bhUpdate(void){
+    if(bhMode<BH1750_CONT_HRES_MODE || simNow-bhStart<bhMeasureNs()){
+        return;
+    }
+    double count = lightNow()->lux*1.2*bhMtreg/BH1750_MTREG_DEFAULT;
+    if((bhMode & 0x03)==0x01){
+        count = count*2; //H-resolution mode 2
+    }
+    bhResult = clampCount(count);
+    if(bhMode & BH1750_ONETIME_HRES_MODE){
+        bhMode = BH1750_POWER_DOWN; //One time modes power down when done
+    }
+    else{
+        bhStart = simNow-(simNow-bhStart)%bhMeasureNs();
+    }
+}
+
+static void bhCommand(uint8_t command){
+    bhUpdate();
+    if((command & 0xF8)==BH1750_CHANGE_MEAS_TIME_H){
+        bhMtreg = (bhMtreg & 0x1F) | (command & 0x07)<<5;
+    }
+    else if((command & 0xE0)==BH1750_CHANGE_MEAS_TIME_L){
+        bhMtreg = (bhMtreg & 0xE0) | (command & 0x1F);
+    }
+    else if(command==BH1750_RESET){
+        bhResult = 0;
+    }
+    else if(command==BH1750_POWER_DOWN || command==BH1750_POWER_ON){
+        bhMode = command;
+    }
+    else{
+        bhMode = command;
+        bhStart = simNow;
+    }
+}
+
+static uint16_t vemlValue(uint8_t command){
+    if(command==VEML6075_UV_CONF_REG){
+        return vemlConf;
+    }
+    if(command==VEML6075_ID_REG){
+        return 0x0026;
+    }
+    uint32_t itMs = 50u<<((vemlConf>>4) & 0x07);
+    if(simNow-vemlConfAt<itMs*1000000ULL){
+        return 0; //First integration not finished
+    }
+    const LightPoint* p = lightNow();
+    double scale = itMs/100.0;
+    if(vemlConf & 0x08){
+        scale = scale/2; //High dynamic setting
+    }
+    switch(command){
+        case VEML6075_UVA_REG: return clampCount(p->uva*scale);
+        case VEML6075_UVB_REG: return clampCount(p->uvb*scale);
+        case VEML6075_UV_COMP1_REG: return clampCount(p->comp1*scale);
+        case VEML6075_UV_COMP2_REG: return clampCount(p->comp2*scale);
+        default: return 0;
+    }
+}
+
+/**
+ * Data byte from the master.
+ * @return 1 for ACK
+ */
+uint8_t SensorsWrite(uint8_t data){
+    if(current==SENSOR_NONE || reading){
+        return 0;
+    }
+    if(current==SENSOR_BH1750){
+        if(byteIndex==0){
+            bhCommand(data);
+        }
+    }
+    else if(byteIndex==0){
+        vemlCommand = data;
+    }
+    else if(byteIndex==1){
+        vemlLow = data;
+    }
+    else if(byteIndex==2 && vemlCommand==VEML6075_UV_CONF_REG){
+        uint16_t conf = (uint16_t)data<<8 | vemlLow;
+        if((conf^vemlConf) & 0x71){
+            vemlConfAt = simNow; //Integration restarts
+        }
+        vemlConf = conf;
+    }
+    byteIndex++;
+    return 1;
+}
+
+/**
+ * Data byte to the master, the bus floats high if nothing is addressed.
+ */
+uint8_t SensorsRead(void){
+    uint16_t value = 0xFFFF;
+    uint8_t byte = byteIndex++;
+    if(current==SENSOR_BH1750){
+        bhUpdate();
+        value = (uint16_t)(bhResult<<8 | bhResult>>8); //MSB first
+    }
+    else if(current==SENSOR_VEML6075){
+        value = vemlValue(vemlCommand);
+    }
+    return byte==0 ? (uint8_t)value : (uint8_t)(value>>8);
+}
+
+void SensorsStop(void){
+    current = SENSOR_NONE;
+}
+
+uint8_t SensorsBH1750Active(void){
+    bhUpdate();
+    return powered && bhMode>=BH1750_CONT_HRES_MODE;
+}
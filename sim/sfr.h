@@ -0,0 +1,682 @@
+/*
+ * File:   sfr.h
+ * Author: Andy Page
+ * Comments: PIC18F46K22 special function registers for the host build.
+ *           Only the registers and bit structures the firmware uses are
+ *           here.  Each register is one byte of simSfr[] and the bits
+ *           unions overlay it, so REG, REGbits.X and the single bit names
+ *           all change the same byte just as they do on the PIC.
+ * Revision history: 1, 19th October 2026
+ */
+
+#ifndef INC_SFR_H
+#define	INC_SFR_H
+
+#include <stdint.h>
+
+#define SIM_SFR_COUNT 65
+
+
+typedef union {
+    struct {
+        uint8_t ANSA0:1;
+        uint8_t ANSA1:1;
+        uint8_t ANSA2:1;
+        uint8_t ANSA3:1;
+        uint8_t :1;
+        uint8_t ANSA5:1;
+    };
+} ANSELAbits_t;
+#define ANSELA (simSfr[0])
+#define ANSELAbits (*(volatile ANSELAbits_t*)&simSfr[0])
+
+typedef union {
+    struct {
+        uint8_t ANSB0:1;
+        uint8_t ANSB1:1;
+        uint8_t ANSB2:1;
+        uint8_t ANSB3:1;
+        uint8_t ANSB4:1;
+        uint8_t ANSB5:1;
+    };
+} ANSELBbits_t;
+#define ANSELB (simSfr[1])
+#define ANSELBbits (*(volatile ANSELBbits_t*)&simSfr[1])
+
+typedef union {
+    struct {
+        uint8_t :2;
+        uint8_t ANSC2:1;
+        uint8_t ANSC3:1;
+        uint8_t ANSC4:1;
+        uint8_t ANSC5:1;
+        uint8_t ANSC6:1;
+        uint8_t ANSC7:1;
+    };
+} ANSELCbits_t;
+#define ANSELC (simSfr[2])
+#define ANSELCbits (*(volatile ANSELCbits_t*)&simSfr[2])
+
+typedef union {
+    struct {
+        uint8_t ANSD0:1;
+        uint8_t ANSD1:1;
+        uint8_t ANSD2:1;
+        uint8_t ANSD3:1;
+        uint8_t ANSD4:1;
+        uint8_t ANSD5:1;
+        uint8_t ANSD6:1;
+        uint8_t ANSD7:1;
+    };
+} ANSELDbits_t;
+#define ANSELD (simSfr[3])
+#define ANSELDbits (*(volatile ANSELDbits_t*)&simSfr[3])
+
+typedef union {
+    struct {
+        uint8_t ANSE0:1;
+        uint8_t ANSE1:1;
+        uint8_t ANSE2:1;
+    };
+} ANSELEbits_t;
+#define ANSELE (simSfr[4])
+#define ANSELEbits (*(volatile ANSELEbits_t*)&simSfr[4])
+
+typedef union {
+    struct {
+        uint8_t ADCMD:1;
+        uint8_t CMP1MD:1;
+        uint8_t CMP2MD:1;
+        uint8_t CTMUMD:1;
+    };
+} PMD2bits_t;
+#define PMD2 (simSfr[5])
+#define PMD2bits (*(volatile PMD2bits_t*)&simSfr[5])
+
+typedef union {
+    struct {
+        uint8_t CCP1MD:1;
+        uint8_t CCP2MD:1;
+        uint8_t CCP3MD:1;
+        uint8_t CCP4MD:1;
+        uint8_t CCP5MD:1;
+        uint8_t :1;
+        uint8_t MSSP1MD:1;
+        uint8_t MSSP2MD:1;
+    };
+} PMD1bits_t;
+#define PMD1 (simSfr[6])
+#define PMD1bits (*(volatile PMD1bits_t*)&simSfr[6])
+
+typedef union {
+    struct {
+        uint8_t TMR1MD:1;
+        uint8_t TMR2MD:1;
+        uint8_t TMR3MD:1;
+        uint8_t TMR4MD:1;
+        uint8_t TMR5MD:1;
+        uint8_t TMR6MD:1;
+        uint8_t UART1MD:1;
+        uint8_t UART2MD:1;
+    };
+} PMD0bits_t;
+#define PMD0 (simSfr[7])
+#define PMD0bits (*(volatile PMD0bits_t*)&simSfr[7])
+
+typedef union {
+    struct {
+        uint8_t :4;
+        uint8_t FVRS:2;
+        uint8_t FVRST:1;
+        uint8_t FVREN:1;
+    };
+} VREFCON0bits_t;
+#define VREFCON0 (simSfr[8])
+#define VREFCON0bits (*(volatile VREFCON0bits_t*)&simSfr[8])
+
+typedef union {
+    struct {
+        uint8_t SSPM:4;
+        uint8_t CKP:1;
+        uint8_t SSPEN:1;
+        uint8_t SSPOV:1;
+        uint8_t WCOL:1;
+    };
+} SSP2CON1bits_t;
+#define SSP2CON1 (simSfr[9])
+#define SSP2CON1bits (*(volatile SSP2CON1bits_t*)&simSfr[9])
+
+typedef union {
+    struct {
+        uint8_t BF:1;
+        uint8_t UA:1;
+        uint8_t R_nW:1;
+        uint8_t S:1;
+        uint8_t P:1;
+        uint8_t D_nA:1;
+        uint8_t CKE:1;
+        uint8_t SMP:1;
+    };
+} SSP2STATbits_t;
+#define SSP2STAT (simSfr[10])
+#define SSP2STATbits (*(volatile SSP2STATbits_t*)&simSfr[10])
+
+#define SSP2BUF (simSfr[11])
+
+typedef union {
+    struct {
+        uint8_t ABDEN:1;
+        uint8_t WUE:1;
+        uint8_t :1;
+        uint8_t BRG16:1;
+        uint8_t CKTXP:1;
+        uint8_t DTRXP:1;
+        uint8_t RCIDL:1;
+        uint8_t ABDOVF:1;
+    };
+} BAUDCON2bits_t;
+#define BAUDCON2 (simSfr[12])
+#define BAUDCON2bits (*(volatile BAUDCON2bits_t*)&simSfr[12])
+
+typedef union {
+    struct {
+        uint8_t RX9D:1;
+        uint8_t OERR:1;
+        uint8_t FERR:1;
+        uint8_t ADDEN:1;
+        uint8_t CREN:1;
+        uint8_t SREN:1;
+        uint8_t RX9:1;
+        uint8_t SPEN:1;
+    };
+} RCSTA2bits_t;
+#define RCSTA2 (simSfr[13])
+#define RCSTA2bits (*(volatile RCSTA2bits_t*)&simSfr[13])
+
+typedef union {
+    struct {
+        uint8_t TX9D:1;
+        uint8_t TRMT:1;
+        uint8_t BRGH:1;
+        uint8_t SENDB:1;
+        uint8_t SYNC:1;
+        uint8_t TXEN:1;
+        uint8_t TX9:1;
+        uint8_t CSRC:1;
+    };
+    struct {
+        uint8_t TX9D2:1;
+        uint8_t TRMT2:1;
+        uint8_t BRGH2:1;
+        uint8_t SENDB2:1;
+        uint8_t SYNC2:1;
+        uint8_t TXEN2:1;
+        uint8_t TX92:1;
+        uint8_t CSRC2:1;
+    };
+} TXSTA2bits_t;
+#define TXSTA2 (simSfr[14])
+#define TXSTA2bits (*(volatile TXSTA2bits_t*)&simSfr[14])
+
+#define TXREG2 (simSfr[15])
+
+#define SPBRG2 (simSfr[16])
+
+#define SPBRGH2 (simSfr[17])
+
+typedef union {
+    struct {
+        uint8_t RC0:1;
+        uint8_t RC1:1;
+        uint8_t RC2:1;
+        uint8_t RC3:1;
+        uint8_t RC4:1;
+        uint8_t RC5:1;
+        uint8_t RC6:1;
+        uint8_t RC7:1;
+    };
+} PORTCbits_t;
+#define PORTC (simSfr[18])
+#define PORTCbits (*(volatile PORTCbits_t*)&simSfr[18])
+
+typedef union {
+    struct {
+        uint8_t LATA0:1;
+        uint8_t LATA1:1;
+        uint8_t LATA2:1;
+        uint8_t LATA3:1;
+        uint8_t LATA4:1;
+        uint8_t LATA5:1;
+        uint8_t LATA6:1;
+        uint8_t LATA7:1;
+    };
+    struct {
+        uint8_t LA0:1;
+        uint8_t LA1:1;
+        uint8_t LA2:1;
+        uint8_t LA3:1;
+        uint8_t LA4:1;
+        uint8_t LA5:1;
+        uint8_t LA6:1;
+        uint8_t LA7:1;
+    };
+} LATAbits_t;
+#define LATA (simSfr[19])
+#define LATAbits (*(volatile LATAbits_t*)&simSfr[19])
+
+#define LATB (simSfr[20])
+
+typedef union {
+    struct {
+        uint8_t LATC0:1;
+        uint8_t LATC1:1;
+        uint8_t LATC2:1;
+        uint8_t LATC3:1;
+        uint8_t LATC4:1;
+        uint8_t LATC5:1;
+        uint8_t LATC6:1;
+        uint8_t LATC7:1;
+    };
+} LATCbits_t;
+#define LATC (simSfr[21])
+#define LATCbits (*(volatile LATCbits_t*)&simSfr[21])
+
+typedef union {
+    struct {
+        uint8_t LATD0:1;
+        uint8_t LATD1:1;
+        uint8_t LATD2:1;
+        uint8_t LATD3:1;
+        uint8_t LATD4:1;
+        uint8_t LATD5:1;
+        uint8_t LATD6:1;
+        uint8_t LATD7:1;
+    };
+} LATDbits_t;
+#define LATD (simSfr[22])
+#define LATDbits (*(volatile LATDbits_t*)&simSfr[22])
+
+typedef union {
+    struct {
+        uint8_t LATE0:1;
+        uint8_t LATE1:1;
+        uint8_t LATE2:1;
+    };
+} LATEbits_t;
+#define LATE (simSfr[23])
+#define LATEbits (*(volatile LATEbits_t*)&simSfr[23])
+
+typedef union {
+    struct {
+        uint8_t RA0:1;
+        uint8_t RA1:1;
+        uint8_t RA2:1;
+        uint8_t RA3:1;
+        uint8_t RA4:1;
+        uint8_t RA5:1;
+        uint8_t RA6:1;
+        uint8_t RA7:1;
+    };
+} TRISAbits_t;
+#define TRISA (simSfr[24])
+#define TRISAbits (*(volatile TRISAbits_t*)&simSfr[24])
+
+#define TRISB (simSfr[25])
+
+typedef union {
+    struct {
+        uint8_t RC0:1;
+        uint8_t RC1:1;
+        uint8_t RC2:1;
+        uint8_t RC3:1;
+        uint8_t RC4:1;
+        uint8_t RC5:1;
+        uint8_t RC6:1;
+        uint8_t RC7:1;
+    };
+} TRISCbits_t;
+#define TRISC (simSfr[26])
+#define TRISCbits (*(volatile TRISCbits_t*)&simSfr[26])
+
+typedef union {
+    struct {
+        uint8_t RD0:1;
+        uint8_t RD1:1;
+        uint8_t RD2:1;
+        uint8_t RD3:1;
+        uint8_t RD4:1;
+        uint8_t RD5:1;
+        uint8_t RD6:1;
+        uint8_t RD7:1;
+    };
+} TRISDbits_t;
+#define TRISD (simSfr[27])
+#define TRISDbits (*(volatile TRISDbits_t*)&simSfr[27])
+
+typedef union {
+    struct {
+        uint8_t RE0:1;
+        uint8_t RE1:1;
+        uint8_t RE2:1;
+    };
+} TRISEbits_t;
+#define TRISE (simSfr[28])
+#define TRISEbits (*(volatile TRISEbits_t*)&simSfr[28])
+
+typedef union {
+    struct {
+        uint8_t TUN:6;
+        uint8_t PLLEN:1;
+        uint8_t INTSRC:1;
+    };
+} OSCTUNEbits_t;
+#define OSCTUNE (simSfr[29])
+#define OSCTUNEbits (*(volatile OSCTUNEbits_t*)&simSfr[29])
+
+typedef union {
+    struct {
+        uint8_t TMR1IE:1;
+        uint8_t TMR2IE:1;
+        uint8_t CCP1IE:1;
+        uint8_t SSP1IE:1;
+        uint8_t TX1IE:1;
+        uint8_t RC1IE:1;
+        uint8_t ADIE:1;
+    };
+} PIE1bits_t;
+#define PIE1 (simSfr[30])
+#define PIE1bits (*(volatile PIE1bits_t*)&simSfr[30])
+
+typedef union {
+    struct {
+        uint8_t TMR1IF:1;
+        uint8_t TMR2IF:1;
+        uint8_t CCP1IF:1;
+        uint8_t SSP1IF:1;
+        uint8_t TX1IF:1;
+        uint8_t RC1IF:1;
+        uint8_t ADIF:1;
+    };
+} PIR1bits_t;
+#define PIR1 (simSfr[31])
+#define PIR1bits (*(volatile PIR1bits_t*)&simSfr[31])
+
+typedef union {
+    struct {
+        uint8_t CCP2IF:1;
+        uint8_t TMR3IF:1;
+        uint8_t HLVDIF:1;
+        uint8_t BCL1IF:1;
+        uint8_t EEIF:1;
+        uint8_t C2IF:1;
+        uint8_t C1IF:1;
+        uint8_t OSCFIF:1;
+    };
+} PIR2bits_t;
+#define PIR2 (simSfr[32])
+#define PIR2bits (*(volatile PIR2bits_t*)&simSfr[32])
+
+typedef union {
+    struct {
+        uint8_t TMR1GIE:1;
+        uint8_t TMR3GIE:1;
+        uint8_t TMR5GIE:1;
+        uint8_t CTMUIE:1;
+        uint8_t TX2IE:1;
+        uint8_t RC2IE:1;
+        uint8_t BCL2IE:1;
+        uint8_t SSP2IE:1;
+    };
+} PIE3bits_t;
+#define PIE3 (simSfr[33])
+#define PIE3bits (*(volatile PIE3bits_t*)&simSfr[33])
+
+typedef union {
+    struct {
+        uint8_t TMR1GIF:1;
+        uint8_t TMR3GIF:1;
+        uint8_t TMR5GIF:1;
+        uint8_t CTMUIF:1;
+        uint8_t TX2IF:1;
+        uint8_t RC2IF:1;
+        uint8_t BCL2IF:1;
+        uint8_t SSP2IF:1;
+    };
+} PIR3bits_t;
+#define PIR3 (simSfr[34])
+#define PIR3bits (*(volatile PIR3bits_t*)&simSfr[34])
+
+typedef union {
+    struct {
+        uint8_t RD:1;
+        uint8_t WR:1;
+        uint8_t WREN:1;
+        uint8_t WRERR:1;
+        uint8_t FREE:1;
+        uint8_t :1;
+        uint8_t CFGS:1;
+        uint8_t EEPGD:1;
+    };
+} EECON1bits_t;
+#define EECON1 (simSfr[35])
+#define EECON1bits (*(volatile EECON1bits_t*)&simSfr[35])
+
+#define EECON2 (simSfr[36])
+
+#define EEDATA (simSfr[37])
+
+#define EEADR (simSfr[38])
+
+typedef union {
+    struct {
+        uint8_t TMR3ON:1;
+        uint8_t T3RD16:1;
+        uint8_t nT3SYNC:1;
+        uint8_t T3SOSCEN:1;
+        uint8_t T3CKPS:2;
+        uint8_t TMR3CS:2;
+    };
+} T3CONbits_t;
+#define T3CON (simSfr[39])
+#define T3CONbits (*(volatile T3CONbits_t*)&simSfr[39])
+
+#define TMR3L (simSfr[40])
+
+#define TMR3H (simSfr[41])
+
+typedef union {
+    struct {
+        uint8_t T2CKPS:2;
+        uint8_t TMR2ON:1;
+        uint8_t T2OUTPS:4;
+    };
+} T2CONbits_t;
+#define T2CON (simSfr[42])
+#define T2CONbits (*(volatile T2CONbits_t*)&simSfr[42])
+
+#define PR2 (simSfr[43])
+
+typedef union {
+    struct {
+        uint8_t ADCS:3;
+        uint8_t ACQT:3;
+        uint8_t :1;
+        uint8_t ADFM:1;
+    };
+} ADCON2bits_t;
+#define ADCON2 (simSfr[44])
+#define ADCON2bits (*(volatile ADCON2bits_t*)&simSfr[44])
+
+typedef union {
+    struct {
+        uint8_t NVCFG:2;
+        uint8_t PVCFG:2;
+        uint8_t :3;
+        uint8_t TRIGSEL:1;
+    };
+} ADCON1bits_t;
+#define ADCON1 (simSfr[45])
+#define ADCON1bits (*(volatile ADCON1bits_t*)&simSfr[45])
+
+typedef union {
+    struct {
+        uint8_t :1;
+        uint8_t GO_NOT_DONE:1;
+    };
+    struct {
+        uint8_t ADON:1;
+        uint8_t GO_nDONE:1;
+        uint8_t CHS:5;
+    };
+} ADCON0bits_t;
+#define ADCON0 (simSfr[46])
+#define ADCON0bits (*(volatile ADCON0bits_t*)&simSfr[46])
+
+#define ADRESL (simSfr[47])
+
+#define ADRESH (simSfr[48])
+
+typedef union {
+    struct {
+        uint8_t SEN1:1;
+        uint8_t ADMSK1:1;
+        uint8_t ADMSK2:1;
+        uint8_t ADMSK3:1;
+        uint8_t ACKEN1:1;
+        uint8_t ACKDT1:1;
+        uint8_t ACKSTAT1:1;
+        uint8_t GCEN1:1;
+    };
+    struct {
+        uint8_t :1;
+        uint8_t RSEN1:1;
+        uint8_t PEN1:1;
+        uint8_t RCEN1:1;
+        uint8_t ADMSK41:1;
+        uint8_t ADMSK51:1;
+    };
+} SSP1CON2bits_t;
+#define SSP1CON2 (simSfr[49])
+#define SSP1CON2bits (*(volatile SSP1CON2bits_t*)&simSfr[49])
+
+#define SSP1CON1 (simSfr[50])
+
+#define SSP1STAT (simSfr[51])
+
+#define SSP1ADD (simSfr[52])
+
+#define SSP1BUF (simSfr[53])
+#define SSPBUF (simSfr[53])
+
+#define T1GCON (simSfr[54])
+
+typedef union {
+    struct {
+        uint8_t TMR1ON:1;
+        uint8_t T1RD16:1;
+        uint8_t nT1SYNC:1;
+        uint8_t T1SOSCEN:1;
+        uint8_t T1CKPS:2;
+        uint8_t TMR1CS:2;
+    };
+} T1CONbits_t;
+#define T1CON (simSfr[55])
+#define T1CONbits (*(volatile T1CONbits_t*)&simSfr[55])
+
+#define TMR1L (simSfr[56])
+
+#define TMR1H (simSfr[57])
+
+typedef union {
+    struct {
+        uint8_t nBOR:1;
+        uint8_t nPOR:1;
+        uint8_t nPD:1;
+        uint8_t nTO:1;
+        uint8_t nRI:1;
+        uint8_t :1;
+        uint8_t SBOREN:1;
+        uint8_t IPEN:1;
+    };
+} RCONbits_t;
+#define RCON (simSfr[58])
+#define RCONbits (*(volatile RCONbits_t*)&simSfr[58])
+
+typedef union {
+    struct {
+        uint8_t LFIOFS:1;
+        uint8_t MFIOFS:1;
+        uint8_t PRISD:1;
+        uint8_t SOSCGO:1;
+        uint8_t MFIOSEL:1;
+        uint8_t :1;
+        uint8_t SOSCRUN:1;
+        uint8_t PLLRDY:1;
+    };
+} OSCCON2bits_t;
+#define OSCCON2 (simSfr[59])
+#define OSCCON2bits (*(volatile OSCCON2bits_t*)&simSfr[59])
+
+typedef union {
+    struct {
+        uint8_t SCS:2;
+        uint8_t HFIOFS:1;
+        uint8_t OSTS:1;
+        uint8_t IRCF:3;
+        uint8_t IDLEN:1;
+    };
+} OSCCONbits_t;
+#define OSCCON (simSfr[60])
+#define OSCCONbits (*(volatile OSCCONbits_t*)&simSfr[60])
+
+typedef union {
+    struct {
+        uint8_t T0PS:3;
+        uint8_t PSA:1;
+        uint8_t T0SE:1;
+        uint8_t T0CS:1;
+        uint8_t T08BIT:1;
+        uint8_t TMR0ON:1;
+    };
+} T0CONbits_t;
+#define T0CON (simSfr[61])
+#define T0CONbits (*(volatile T0CONbits_t*)&simSfr[61])
+
+#define TMR0L (simSfr[62])
+
+#define TMR0H (simSfr[63])
+
+typedef union {
+    struct {
+        uint8_t RBIF:1;
+        uint8_t INT0IF:1;
+        uint8_t TMR0IF:1;
+        uint8_t RBIE:1;
+        uint8_t INT0IE:1;
+        uint8_t TMR0IE:1;
+        uint8_t PEIE_GIEL:1;
+        uint8_t GIE_GIEH:1;
+    };
+    struct {
+        uint8_t :1;
+        uint8_t INT0F:1;
+        uint8_t T0IF:1;
+        uint8_t :1;
+        uint8_t INT0E:1;
+        uint8_t T0IE:1;
+        uint8_t PEIE:1;
+        uint8_t GIE:1;
+    };
+} INTCONbits_t;
+#define INTCON (simSfr[64])
+#define INTCONbits (*(volatile INTCONbits_t*)&simSfr[64])
+
+#define ACKDT1 (SSP1CON2bits.ACKDT1)
+#define ACKEN1 (SSP1CON2bits.ACKEN1)
+#define RCEN1 (SSP1CON2bits.RCEN1)
+#define SSP2IF (PIR3bits.SSP2IF)
+#define TRMT2 (TXSTA2bits.TRMT2)
+
+extern volatile uint8_t simSfr[SIM_SFR_COUNT];
+
+#endif	/* INC_SFR_H */
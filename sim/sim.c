@@ -0,0 +1,657 @@
+/**
+ * sim.c
+ * Simulator core: virtual clock, oscillator, timers 0/1/3, ADC with the FVR,
+ * data EEPROM, USART2, interrupts, sleep and the watchdog, and the MSSP1 and
+ * MSSP2 front ends that pass bytes to sensors.c and sx1276.c.  The firmware
+ * tells us about register writes through SimKick() (hal.h).
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <xc.h>
+#include <math.h>
+#include <setjmp.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_FVR_SETTLE_NS 25000ULL     //FVR start-up (FVRST)
+#define SIM_EEPROM_WRITE_NS 4000000ULL //Data EEPROM write time
+#define SIM_FRC_TAD_NS 1700.0          //ADC FRC clock period
+#define SIM_ISR_CYCLES 30              //Interrupt entry, handler and exit
+#define SIM_ISR_LIMIT 100000           //Interrupts in a row before giving up
+#define SIM_NTC_R25 10000.0            //RT1
+#define SIM_NTC_BETA 3950.0
+#define SIM_NTC_SERIES 10000.0         //R14
+#define SIM_PIC_RUN 0
+#define SIM_PIC_IDLE 1
+#define SIM_PIC_SLEEPING 2
+
+volatile uint8_t simSfr[SIM_SFR_COUNT];
+SimConfig simConfig = {
+    10,         //cycles
+    3.0,        //batteryV
+    0.25,       //batteryDivider, 2.1V reads 525 (DEFAULT_UVLO)
+    20.0,       //temperatureC
+    31250.0,    //lfintoscHz
+    1000,       //crystalStartUs
+    500,        //vemlReadyUs
+    200,        //bhReadyUs
+    0.0,        //cadBusy
+    NULL, NULL, NULL, NULL, NULL
+};
+uint64_t simNow = 0;
+SimCycle simCycle;
+
+extern void FirmwareMain(void);
+extern void interruptHandler(void);
+
+static jmp_buf simExit;
+static uint8_t simClock = SIM_CLOCK_XTAL;
+static uint8_t picMode = SIM_PIC_RUN;
+static uint8_t inInterrupt = 0;
+static uint8_t railOn = 0;
+static uint8_t i2cAddressNext = 0;   //Next SSP1BUF write follows a start
+static uint8_t spiActive = 0;
+static uint64_t wdtClearedAt = 0;
+static uint64_t fvrOnAt = 0;
+static uint64_t adcDoneAt = 0;
+static double timer0Cycles = 0;     //Instruction cycles not yet counted by the prescalers
+static double timer1Cycles = 0;
+static double timer3Cycles = 0;
+static uint8_t eeprom[256];
+static const char* stateNames[SIM_STATES] = {
+    "pic_run_hf", "pic_run_xtal", "pic_run_lf", "pic_idle_hf", "pic_idle_xtal",
+    "pic_idle_lf", "pic_sleep", "rail_on", "bh1750_active", "radio_sleep",
+    "radio_standby", "radio_tx", "radio_rx", "radio_cad", "led_green", "led_red"
+};
+
+static uint64_t cyclesToNs(double cycles){
+    return (uint64_t)ceil(cycles*4.0e9/SimFosc());
+}
+
+static uint64_t watchdogNs(void){
+    return (uint64_t)(128.0*16384.0/simConfig.lfintoscHz*1.0e9); //WDTPS 1:16384 of 4ms nominal
+}
+
+/**
+ * Current Fosc in Hz.
+ */
+double SimFosc(void){
+    if(simClock==SIM_CLOCK_XTAL){
+        return 16000000.0;
+    }
+    if(simClock==SIM_CLOCK_LF){
+        return simConfig.lfintoscHz;
+    }
+    return 16000000.0/(1u<<(7-OSCCONbits.IRCF)); //HFINTOSC postscaler
+}
+
+uint8_t SimClock(void){
+    return simClock;
+}
+
+void SimFault(const char* message){
+    static uint32_t reported = 0;
+    simCycle.faults++;
+    if(reported<20){
+        fprintf(stderr, "sim: cycle %u at %.6fs: %s\n", simCycle.number, simNow/1.0e9, message);
+        reported++;
+    }
+}
+
+/**
+ * Pins that are watched rather than kicked: Q1 (RA2, low is on) and the LEDs.
+ */
+static void samplePins(void){
+    uint8_t rail = !TRISAbits.RA2 && !LATAbits.LATA2;
+    if(rail!=railOn){
+        railOn = rail;
+        SensorsRail(rail);
+    }
+}
+
+static void addStateTime(uint64_t ns){
+    uint8_t pic;
+    if(picMode==SIM_PIC_SLEEPING){
+        pic = SIM_PIC_SLEEP;
+    }
+    else{
+        pic = (picMode==SIM_PIC_IDLE ? SIM_PIC_IDLE_HF : SIM_PIC_RUN_HF) + simClock;
+    }
+    simCycle.stateNs[pic] += ns;
+    if(railOn){
+        simCycle.stateNs[SIM_RAIL_ON] += ns;
+    }
+    if(SensorsBH1750Active()){
+        simCycle.stateNs[SIM_BH1750_ACTIVE] += ns;
+    }
+    simCycle.stateNs[SIM_RADIO_SLEEP+Sx1276State()] += ns;
+    if(LATEbits.LATE1 && !TRISEbits.RE1){
+        simCycle.stateNs[SIM_LED_GREEN] += ns;
+    }
+    if(LATEbits.LATE2 && !TRISEbits.RE2){
+        simCycle.stateNs[SIM_LED_RED] += ns;
+    }
+}
+
+/**
+ * Counts a 16-bit timer on by a number of instruction cycles.
+ * @return 1 if it overflowed
+ */
+static uint8_t timerCount(volatile uint8_t* low, volatile uint8_t* high, double* pending, double cycles, uint16_t prescale){
+    *pending = *pending + cycles;
+    uint64_t ticks = (uint64_t)(*pending/prescale);
+    *pending = *pending - (double)ticks*prescale;
+    uint64_t value = ((uint64_t)*high<<8 | *low) + ticks;
+    *low = (uint8_t)value;
+    *high = (uint8_t)(value>>8);
+    return value>0xFFFF;
+}
+
+static void timersAdvance(uint64_t ns){
+    if(picMode==SIM_PIC_SLEEPING){
+        return; //Fosc stops in sleep
+    }
+    double cycles = ns*SimFosc()/4.0e9;
+    if(T0CONbits.TMR0ON && !T0CONbits.T0CS){
+        uint16_t prescale = T0CONbits.PSA ? 1 : 2u<<T0CONbits.T0PS;
+        if(T0CONbits.T08BIT){
+            uint8_t zero = 0;
+            if(timerCount(&TMR0L, &zero, &timer0Cycles, cycles, prescale) || zero){
+                INTCONbits.TMR0IF = 1;
+            }
+        }
+        else if(timerCount(&TMR0L, &TMR0H, &timer0Cycles, cycles, prescale)){
+            INTCONbits.TMR0IF = 1;
+        }
+    }
+    if(T1CONbits.TMR1ON && !PMD0bits.TMR1MD && T1CONbits.TMR1CS<2){
+        double c = T1CONbits.TMR1CS ? cycles*4 : cycles;
+        if(timerCount(&TMR1L, &TMR1H, &timer1Cycles, c, 1u<<T1CONbits.T1CKPS)){
+            PIR1bits.TMR1IF = 1;
+        }
+    }
+    if(T3CONbits.TMR3ON && !PMD0bits.TMR3MD && T3CONbits.TMR3CS<2){
+        double c = T3CONbits.TMR3CS ? cycles*4 : cycles;
+        if(timerCount(&TMR3L, &TMR3H, &timer3Cycles, c, 1u<<T3CONbits.T3CKPS)){
+            PIR2bits.TMR3IF = 1;
+        }
+    }
+}
+
+/**
+ * Time to the next Timer1 overflow, or 0 if it isn't running.
+ */
+static uint64_t timer1OverflowNs(void){
+    if(!T1CONbits.TMR1ON || PMD0bits.TMR1MD || T1CONbits.TMR1CS>=2){
+        return 0;
+    }
+    double ticks = 0x10000 - ((uint16_t)TMR1H<<8 | TMR1L);
+    double cycles = ticks*(1u<<T1CONbits.T1CKPS) - timer1Cycles;
+    if(T1CONbits.TMR1CS){
+        cycles = cycles/4;
+    }
+    return cyclesToNs(cycles);
+}
+
+static double adcInput(uint8_t channel){
+    if(channel==0){
+        return simConfig.batteryV*simConfig.batteryDivider;
+    }
+    if(channel==1){
+        double kelvin = simConfig.temperatureC+273.15;
+        double ntc = SIM_NTC_R25*exp(SIM_NTC_BETA*(1.0/kelvin-1.0/298.15));
+        return simConfig.batteryV*SIM_NTC_SERIES/(SIM_NTC_SERIES+ntc);
+    }
+    return 0;
+}
+
+static void adcComplete(void){
+    double vref = simConfig.batteryV;
+    if(ADCON1bits.PVCFG==0b10){
+        if(!VREFCON0bits.FVREN || !VREFCON0bits.FVRST){
+            SimFault("ADC uses the FVR before it is ready");
+        }
+        vref = 1.024*(1u<<(VREFCON0bits.FVRS-1));
+    }
+    long result = lround(adcInput(ADCON0bits.CHS)/vref*1023.0);
+    if(result>1023){
+        result = 1023;
+    }
+    if(result<0){
+        result = 0;
+    }
+    if(ADCON2bits.ADFM){
+        ADRESH = (uint8_t)(result>>8);
+        ADRESL = (uint8_t)result;
+    }
+    else{
+        ADRESH = (uint8_t)(result>>2);
+        ADRESL = (uint8_t)(result<<6);
+    }
+    ADCON0bits.GO_NOT_DONE = 0;
+    PIR1bits.ADIF = 1;
+    adcDoneAt = 0;
+}
+
+/**
+ * Notices a conversion that has just been started and works out when it ends.
+ */
+static void adcCheck(void){
+    if(!ADCON0bits.GO_NOT_DONE || adcDoneAt){
+        return;
+    }
+    if(!ADCON0bits.ADON || PMD2bits.ADCMD){
+        SimFault("ADC started while turned off");
+        ADCON0bits.GO_NOT_DONE = 0;
+        return;
+    }
+    static const uint8_t acquire[8] = {0, 2, 4, 6, 8, 12, 16, 20};
+    static const uint8_t divide[8] = {2, 8, 32, 0, 4, 16, 64, 0};
+    double tad = SIM_FRC_TAD_NS;
+    if(divide[ADCON2bits.ADCS]){
+        tad = divide[ADCON2bits.ADCS]*1.0e9/SimFosc();
+    }
+    adcDoneAt = simNow + (uint64_t)((acquire[ADCON2bits.ACQT]+12)*tad);
+}
+
+static void fvrCheck(void){
+    if(!VREFCON0bits.FVREN){
+        VREFCON0bits.FVRST = 0;
+        fvrOnAt = 0;
+    }
+    else if(!VREFCON0bits.FVRST){
+        if(!fvrOnAt){
+            fvrOnAt = simNow;
+        }
+        else if(simNow-fvrOnAt>=SIM_FVR_SETTLE_NS){
+            VREFCON0bits.FVRST = 1;
+        }
+    }
+}
+
+/**
+ * Runs any interrupts that are enabled and pending, as the PIC would at the
+ * next instruction.
+ */
+static void interruptService(void){
+    if(inInterrupt || !INTCONbits.GIE){
+        return;
+    }
+    for(uint32_t n=0;n<SIM_ISR_LIMIT;n++){
+        uint8_t pending = INTCONbits.PEIE && ((PIE3bits.TX2IE && PIR3bits.TX2IF) ||
+                (PIE1bits.ADIE && PIR1bits.ADIF) || (PIE1bits.TMR1IE && PIR1bits.TMR1IF));
+        if(!pending){
+            return;
+        }
+        inInterrupt = 1;
+        SimAdvance(cyclesToNs(SIM_ISR_CYCLES));
+        interruptHandler();
+        inInterrupt = 0;
+    }
+    SimFault("interrupt flag never cleared");
+}
+
+/**
+ * Moves the virtual clock on, stopping at each radio and ADC event so that
+ * the time in each state is right.
+ * @param ns    Time to add
+ */
+void SimAdvance(uint64_t ns){
+    samplePins();
+    adcCheck();
+    while(ns>0){
+        uint64_t step = ns;
+        uint64_t next = Sx1276NextEvent();
+        if(next>simNow && next-simNow<step){
+            step = next-simNow;
+        }
+        if(adcDoneAt>simNow && adcDoneAt-simNow<step){
+            step = adcDoneAt-simNow;
+        }
+        addStateTime(step);
+        timersAdvance(step);
+        simNow = simNow + step;
+        ns = ns - step;
+        Sx1276Advance();
+        if(adcDoneAt && simNow>=adcDoneAt){
+            adcComplete();
+        }
+        fvrCheck();
+    }
+    if(picMode!=SIM_PIC_SLEEPING && simNow-wdtClearedAt>watchdogNs()){
+        SimFault("watchdog expired while awake, the PIC would reset");
+        wdtClearedAt = simNow;
+    }
+    interruptService();
+}
+
+void SimDelayCycles(uint32_t cycles){
+    SimAdvance(cyclesToNs(cycles));
+}
+
+void SimClearWatchdog(void){
+    wdtClearedAt = simNow;
+}
+
+static void sspDisabled(const char* module){
+    char message[64];
+    snprintf(message, sizeof message, "%s used while turned off", module);
+    SimFault(message);
+}
+
+/**
+ * MSSP1 in I2C master mode.  Control bits complete straight away (after the
+ * bus time) and SSP1IF is set, as the firmware polls for it.
+ */
+static void i2cKick(void){
+    if(PMD1bits.MSSP1MD || !(SSP1CON1 & 0x20)){
+        sspDisabled("MSSP1");
+    }
+    double bitNs = 4.0*(SSP1ADD+1)*1.0e9/SimFosc(); //SCL period
+    uint64_t ns;
+    if(SSP1CON2bits.SEN1 || SSP1CON2bits.RSEN1){
+        SSP1CON2bits.SEN1 = 0;
+        SSP1CON2bits.RSEN1 = 0;
+        i2cAddressNext = 1;
+        simCycle.i2cTransactions++;
+        ns = (uint64_t)bitNs;
+    }
+    else if(SSP1CON2bits.PEN1){
+        SSP1CON2bits.PEN1 = 0;
+        SensorsStop();
+        ns = (uint64_t)bitNs;
+    }
+    else if(RCEN1){
+        RCEN1 = 0;
+        SSP1BUF = SensorsRead();
+        simCycle.i2cBytes++;
+        ns = (uint64_t)(8*bitNs);
+    }
+    else if(ACKEN1){
+        ACKEN1 = 0;
+        ns = (uint64_t)bitNs;
+    }
+    else{
+        uint8_t ack = i2cAddressNext ? SensorsAddress(SSP1BUF) : SensorsWrite(SSP1BUF);
+        i2cAddressNext = 0;
+        SSP1CON2bits.ACKSTAT1 = !ack;
+        if(!ack){
+            simCycle.i2cNacks++;
+        }
+        simCycle.i2cBytes++;
+        ns = (uint64_t)(9*bitNs);
+    }
+    SimAdvance(ns+cyclesToNs(SIM_OVERHEAD_CYCLES));
+    PIR1bits.SSP1IF = 1;
+}
+
+/**
+ * MSSP2 in SPI master mode, one byte each way with the radio.
+ */
+static void spiKick(void){
+    if(PMD1bits.MSSP2MD || !SSP2CON1bits.SSPEN){
+        sspDisabled("MSSP2");
+    }
+    static const uint8_t divide[3] = {4, 16, 64};
+    double clocks = SSP2CON1bits.SSPM<3 ? divide[SSP2CON1bits.SSPM] : 8.0*(PR2+1);
+    if(!spiActive){
+        spiActive = 1;
+        simCycle.spiTransactions++;
+    }
+    uint8_t reply = 0xFF;
+    if(!LATDbits.LATD3){
+        reply = Sx1276Transfer(SSP2BUF);
+    }
+    simCycle.spiBytes++;
+    SimAdvance((uint64_t)(8*clocks*1.0e9/SimFosc())+cyclesToNs(SIM_OVERHEAD_CYCLES));
+    SSP2BUF = reply;
+    SSP2IF = 1;
+}
+
+static void oscKick(void){
+    if(OSCCONbits.SCS==0b00){
+        if(!OSCCON2bits.PRISD){
+            OSCCONbits.OSTS = 0; //No crystal drive, stays on the old clock
+            return;
+        }
+        if(simClock!=SIM_CLOCK_XTAL){
+            SimAdvance((uint64_t)simConfig.crystalStartUs*1000); //Runs on the old clock until OST expires
+        }
+        simClock = SIM_CLOCK_XTAL;
+        OSCCONbits.OSTS = 1;
+    }
+    else if(OSCCONbits.SCS & 0b10){
+        simClock = (OSCCONbits.IRCF==0 && !OSCTUNEbits.INTSRC) ? SIM_CLOCK_LF : SIM_CLOCK_HF;
+        OSCCONbits.OSTS = 0;
+        OSCCONbits.HFIOFS = OSCCONbits.IRCF!=0;
+    }
+}
+
+static void eepromKick(void){
+    if(EECON1bits.RD){
+        EECON1bits.RD = 0;
+        EEDATA = eeprom[EEADR];
+    }
+    if(EECON1bits.WR){
+        if(!EECON1bits.WREN){
+            SimFault("EEPROM write without WREN");
+        }
+        else{
+            eeprom[EEADR] = EEDATA;
+            simCycle.eepromWrites++;
+            SimAdvance(SIM_EEPROM_WRITE_NS); //Firmware polls WR
+        }
+        EECON1bits.WR = 0;
+        PIR2bits.EEIF = 1;
+    }
+}
+
+/**
+ * TXREG2 written.  The UART is modelled as infinitely fast so debug output
+ * never holds the firmware up (the real one is buffered by the ring in
+ * usart2.c), TX2IF stays set.
+ */
+static void usartKick(void){
+    if(!RCSTA2bits.SPEN || PMD0bits.UART2MD){
+        SimFault("USART2 written while turned off");
+        return;
+    }
+    simCycle.uartBytes++;
+    if(simConfig.uartOut){
+        fputc(TXREG2, simConfig.uartOut);
+    }
+    PIR3bits.TX2IF = 1;
+}
+
+void SimKick(unsigned char peripheral){
+    samplePins();
+    if(peripheral==HAL_SSP1){
+        i2cKick();
+    }
+    else if(peripheral==HAL_SSP2){
+        spiKick();
+    }
+    else if(peripheral==HAL_SPI2_NSS){
+        if(LATDbits.LATD3){
+            Sx1276Deselect();
+            spiActive = 0;
+        }
+    }
+    else if(peripheral==HAL_OSC){
+        oscKick();
+    }
+    else if(peripheral==HAL_EEPROM){
+        eepromKick();
+    }
+    else if(peripheral==HAL_USART2){
+        usartKick();
+    }
+    else if(peripheral==HAL_LORA_RESET){
+        if(!TRISCbits.RC6 && !LATCbits.LATC6){
+            Sx1276Reset();
+        }
+    }
+    SimAdvance(cyclesToNs(SIM_OVERHEAD_CYCLES)); //Also runs pending interrupts (HAL_INTERRUPT)
+}
+
+void SimCycleHeader(FILE* out){
+    fprintf(out, "cycle,start_s,awake_us,spi_bytes,spi_transactions,i2c_bytes,i2c_transactions,i2c_nacks,eeprom_writes,uart_bytes,packets,pa_config,faults");
+    for(uint8_t i=0;i<SIM_STATES;i++){
+        fprintf(out, ",%s_us", stateNames[i]);
+    }
+    fprintf(out, "\n");
+}
+
+static void cycleWrite(FILE* out){
+    fprintf(out, "%u,%.6f,%.1f,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u", simCycle.number, simCycle.startNs/1.0e9,
+            simCycle.awakeNs/1000.0, simCycle.spiBytes, simCycle.spiTransactions, simCycle.i2cBytes,
+            simCycle.i2cTransactions, simCycle.i2cNacks, simCycle.eepromWrites, simCycle.uartBytes,
+            simCycle.packets, simCycle.paConfig, simCycle.faults);
+    for(uint8_t i=0;i<SIM_STATES;i++){
+        fprintf(out, ",%.1f", simCycle.stateNs[i]/1000.0);
+    }
+    fprintf(out, "\n");
+}
+
+void SimPacketSent(const uint8_t* data, uint8_t length){
+    simCycle.packets++;
+    if(simConfig.packetOut){
+        fprintf(simConfig.packetOut, "%.6f ", simNow/1.0e9);
+        for(uint8_t i=0;i<length;i++){
+            fprintf(simConfig.packetOut, "%02X", data[i]);
+        }
+        fprintf(simConfig.packetOut, "\n");
+    }
+}
+
+/**
+ * SLEEP().  In Idle the core waits for Timer1 or the ADC, in full sleep for
+ * the ADC (FRC) or the watchdog.  A watchdog sleep ends the wake cycle.
+ */
+void SimSleep(void){
+    SimAdvance(cyclesToNs(1));
+    wdtClearedAt = simNow; //SLEEP clears the watchdog
+    adcCheck();
+    uint8_t adcWake = adcDoneAt && PIE1bits.ADIE && INTCONbits.PEIE;
+    if((PIE1bits.ADIE && PIR1bits.ADIF) || (PIE1bits.TMR1IE && PIR1bits.TMR1IF)){
+        return; //Wakes straight away
+    }
+    if(OSCCONbits.IDLEN){
+        uint64_t wait = watchdogNs();
+        uint64_t timer1 = timer1OverflowNs();
+        if(timer1 && PIE1bits.TMR1IE && INTCONbits.PEIE && timer1<wait){
+            wait = timer1;
+        }
+        if(adcWake && adcDoneAt-simNow<wait){
+            wait = adcDoneAt-simNow;
+        }
+        picMode = SIM_PIC_IDLE;
+        SimAdvance(wait);
+        picMode = SIM_PIC_RUN;
+        return;
+    }
+    if(adcWake){
+        picMode = SIM_PIC_SLEEPING;
+        SimAdvance(adcDoneAt-simNow);
+        picMode = SIM_PIC_RUN;
+        return;
+    }
+    //Watchdog sleep, end of this wake cycle
+    simCycle.awakeNs = simNow-simCycle.startNs;
+    picMode = SIM_PIC_SLEEPING;
+    SimAdvance(watchdogNs());
+    picMode = SIM_PIC_RUN;
+    RCONbits.nTO = 0; //Watchdog wake from sleep
+    RCONbits.nPD = 0;
+    wdtClearedAt = simNow;
+    if(simConfig.cycleOut){
+        cycleWrite(simConfig.cycleOut);
+    }
+    if(simCycle.number+1>=simConfig.cycles){
+        longjmp(simExit, 1);
+    }
+    uint32_t number = simCycle.number+1;
+    memset(&simCycle, 0, sizeof simCycle);
+    simCycle.number = number;
+    simCycle.startNs = simNow;
+}
+
+/**
+ * Power on reset values for the registers the firmware relies on.
+ */
+static void sfrReset(void){
+    memset((void*)simSfr, 0, sizeof simSfr);
+    ANSELA = 0x2F;
+    ANSELB = 0x3F;
+    ANSELC = 0xFC;
+    ANSELD = 0xFF;
+    ANSELE = 0x07;
+    TRISA = 0xFF;
+    TRISB = 0xFF;
+    TRISC = 0xFF;
+    TRISD = 0xFF;
+    TRISE = 0x07;
+    RCON = 0x1C; //nRI, nTO, nPD set, nPOR and nBOR clear
+    OSCCONbits.IRCF = 0b011;
+    OSCCONbits.OSTS = 1; //FOSC=HSMP, IESO=OFF, running from the crystal
+    PORTCbits.RC3 = 1; //I2C pull ups
+    PORTCbits.RC4 = 1;
+    PIR3bits.TX2IF = 1;
+    TRMT2 = 1;
+    LATDbits.LATD3 = 1;
+}
+
+static void eepromFile(const char* mode){
+    if(!simConfig.eepromFile){
+        return;
+    }
+    FILE* f = fopen(simConfig.eepromFile, mode);
+    if(!f){
+        return; //No image yet, start blank
+    }
+    if(mode[0]=='r'){
+        if(fread(eeprom, 1, sizeof eeprom, f)!=sizeof eeprom){
+            memset(eeprom, 0xFF, sizeof eeprom);
+        }
+    }
+    else{
+        fwrite(eeprom, 1, sizeof eeprom, f);
+    }
+    fclose(f);
+}
+
+/**
+ * Power on reset of the PIC and the models, without running the firmware.
+ * Lets firmware functions be called directly (bench.c).
+ */
+void SimReset(void){
+    sfrReset();
+    memset(eeprom, 0xFF, sizeof eeprom);
+    eepromFile("rb");
+    SensorsLoad(simConfig.lightScript);
+    Sx1276Reset();
+    simNow = 0;
+    simClock = SIM_CLOCK_XTAL;
+    picMode = SIM_PIC_RUN;
+    railOn = 0;
+    spiActive = 0;
+    wdtClearedAt = 0;
+    fvrOnAt = 0;
+    adcDoneAt = 0;
+    memset(&simCycle, 0, sizeof simCycle);
+}
+
+/**
+ * Runs the firmware from power on for simConfig.cycles wake cycles.
+ */
+void SimRun(void){
+    SimReset();
+    if(simConfig.cycleOut){
+        SimCycleHeader(simConfig.cycleOut);
+    }
+    if(simConfig.cycles>0 && setjmp(simExit)==0){
+        FirmwareMain();
+    }
+    eepromFile("wb");
+}
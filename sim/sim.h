@@ -0,0 +1,125 @@
+/*
+ * File:   sim.h
+ * Author: Andy Page
+ * Comments: Host simulator for the PIC18F46K22 UV/visible sensor.  The
+ *           firmware is built unchanged for Linux against sfr.h and runs
+ *           against models of the clock, timers, ADC, EEPROM, MSSP1 (I2C
+ *           with a VEML6075 and a BH1750 on the Q1 rail), MSSP2 (SPI to an
+ *           SX1276) and USART2.  A virtual clock is charged for every delay,
+ *           bus transaction, EEPROM write and sleep, and the time spent in
+ *           each power state is recorded per wake cycle.
+ * Revision history: 1, 19th October 2026
+ */
+
+#ifndef INC_SIM_H
+#define	INC_SIM_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define SIM_NS_PER_S 1000000000ULL
+#define SIM_OVERHEAD_CYCLES 20  //Instruction cycles charged for the code around each register operation
+
+//Power states, time in each is kept per wake cycle (see SimCycle)
+#define SIM_PIC_RUN_HF 0        //Running from HFINTOSC 16MHz
+#define SIM_PIC_RUN_XTAL 1      //Running from the 16MHz crystal
+#define SIM_PIC_RUN_LF 2        //Running from LFINTOSC 31kHz
+#define SIM_PIC_IDLE_HF 3       //Idle (SLEEP with IDLEN set), peripherals on HFINTOSC
+#define SIM_PIC_IDLE_XTAL 4
+#define SIM_PIC_IDLE_LF 5
+#define SIM_PIC_SLEEP 6         //Full sleep, watchdog only
+#define SIM_RAIL_ON 7           //Q1 on: sensors, battery divider and NTC divider powered
+#define SIM_BH1750_ACTIVE 8     //BH1750 measuring
+#define SIM_RADIO_SLEEP 9
+#define SIM_RADIO_STANDBY 10
+#define SIM_RADIO_TX 11
+#define SIM_RADIO_RX 12
+#define SIM_RADIO_CAD 13
+#define SIM_LED_GREEN 14
+#define SIM_LED_RED 15
+#define SIM_STATES 16
+
+//Clocks the PIC can be running from
+#define SIM_CLOCK_HF 0
+#define SIM_CLOCK_XTAL 1
+#define SIM_CLOCK_LF 2
+
+/**
+ * One wake cycle, from the watchdog wake (or reset) to the next full sleep.
+ * The sleep that follows is included in stateNs[SIM_PIC_SLEEP].
+ */
+typedef struct {
+    uint32_t number;
+    uint64_t startNs;           //Virtual time at wake
+    uint64_t awakeNs;           //Wake to full sleep
+    uint32_t spiBytes;
+    uint32_t spiTransactions;
+    uint32_t i2cBytes;          //Address and data bytes
+    uint32_t i2cTransactions;   //Start conditions (repeated starts included)
+    uint32_t i2cNacks;
+    uint32_t eepromWrites;
+    uint32_t uartBytes;
+    uint32_t packets;           //Packets the radio finished sending
+    uint8_t paConfig;           //PA_CONFIG_REG during the last transmission
+    uint8_t faults;             //Peripheral used while turned off by PMD, watchdog expiry
+    uint64_t stateNs[SIM_STATES];
+} SimCycle;
+
+/**
+ * Simulation inputs, set before SimRun().
+ */
+typedef struct {
+    uint32_t cycles;            //Wake cycles to run
+    double batteryV;            //Battery (and Vdd) voltage
+    double batteryDivider;      //R4/R13 ratio seen on AN0
+    double temperatureC;        //NTC temperature
+    double lfintoscHz;          //Actual LFINTOSC frequency (watchdog and low power delays)
+    uint32_t crystalStartUs;    //Crystal start-up time
+    uint32_t vemlReadyUs;       //VEML6075 power up to first ACK
+    uint32_t bhReadyUs;         //BH1750 power up to first ACK
+    double cadBusy;             //Probability that CAD finds the channel busy
+    const char* lightScript;    //Light levels over time, NULL for the defaults
+    const char* eepromFile;     //Data EEPROM image loaded at start and saved at the end
+    FILE* uartOut;              //USART2 bytes, NULL to discard
+    FILE* packetOut;            //Transmitted packets as hex lines, NULL to discard
+    FILE* cycleOut;             //One CSV line per wake cycle, NULL to discard
+} SimConfig;
+
+extern SimConfig simConfig;
+extern uint64_t simNow;         //Virtual time (ns)
+extern SimCycle simCycle;       //Cycle in progress
+
+//Called by the firmware (hal.h and xc.h)
+void SimKick(unsigned char);
+void SimDelayCycles(uint32_t);
+void SimSleep(void);
+void SimClearWatchdog(void);
+
+//Simulator core
+void SimReset(void);
+void SimRun(void);
+void SimAdvance(uint64_t);
+double SimFosc(void);
+uint8_t SimClock(void);
+void SimFault(const char*);
+void SimPacketSent(const uint8_t*, uint8_t);
+void SimCycleHeader(FILE*);
+
+//SX1276 model (sx1276.c)
+void Sx1276Reset(void);
+uint8_t Sx1276Transfer(uint8_t);
+void Sx1276Deselect(void);
+void Sx1276Advance(void);
+uint64_t Sx1276NextEvent(void);
+uint8_t Sx1276State(void);      //0 sleep to 4 CAD, add SIM_RADIO_SLEEP
+
+//I2C devices on the Q1 rail (sensors.c)
+void SensorsLoad(const char*);
+void SensorsRail(uint8_t);
+uint8_t SensorsAddress(uint8_t);
+uint8_t SensorsWrite(uint8_t);
+uint8_t SensorsRead(void);
+void SensorsStop(void);
+uint8_t SensorsBH1750Active(void);
+
+#endif	/* INC_SIM_H */
@@ -0,0 +1,68 @@
+/**
+ * simmain.c
+ * Command line for the simulator.
+ *   uvsim [-n cycles] [-l light script] [-b battery V] [-t temperature C]
+ *         [-f LFINTOSC Hz] [-c CAD busy probability] [-e eeprom image]
+ *         [-u uart file] [-p packet file] [-o cycle csv]
+ * Prints a summary of the run on stderr.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "sim.h"
+
+static FILE* openOutput(const char* path){
+    if(!strcmp(path, "-")){
+        return stdout;
+    }
+    FILE* f = fopen(path, "w");
+    if(!f){
+        fprintf(stderr, "uvsim: cannot write %s\n", path);
+        exit(1);
+    }
+    return f;
+}
+
+static void usage(void){
+    fprintf(stderr, "usage: uvsim [-n cycles] [-l light] [-b volts] [-t celsius] [-f lfintosc_hz]\n"
+                    "             [-c cad_busy] [-e eeprom.bin] [-u uart.bin] [-p packets.txt] [-o cycles.csv]\n");
+    exit(2);
+}
+
+int main(int argc, char** argv){
+    int option;
+    while((option = getopt(argc, argv, "n:l:b:t:f:c:e:u:p:o:h"))!=-1){
+        switch(option){
+            case 'n': simConfig.cycles = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'l': simConfig.lightScript = optarg; break;
+            case 'b': simConfig.batteryV = atof(optarg); break;
+            case 't': simConfig.temperatureC = atof(optarg); break;
+            case 'f': simConfig.lfintoscHz = atof(optarg); break;
+            case 'c': simConfig.cadBusy = atof(optarg); break;
+            case 'e': simConfig.eepromFile = optarg; break;
+            case 'u': simConfig.uartOut = openOutput(optarg); break;
+            case 'p': simConfig.packetOut = openOutput(optarg); break;
+            case 'o': simConfig.cycleOut = openOutput(optarg); break;
+            default: usage();
+        }
+    }
+    if(optind<argc){
+        usage();
+    }
+    SimRun();
+    fprintf(stderr, "uvsim: %u cycles, %.3fs virtual time\n", simConfig.cycles, simNow/(double)SIM_NS_PER_S);
+    if(simConfig.uartOut){
+        fclose(simConfig.uartOut);
+    }
+    if(simConfig.packetOut && simConfig.packetOut!=simConfig.uartOut){
+        fclose(simConfig.packetOut);
+    }
+    if(simConfig.cycleOut && simConfig.cycleOut!=simConfig.uartOut && simConfig.cycleOut!=simConfig.packetOut){
+        fclose(simConfig.cycleOut);
+    }
+    return 0;
+}
@@ -0,0 +1,216 @@
+/**
+ * sx1276.c
+ * SX1276 (RFM95W) model for the simulator: register map, FIFO, op modes and
+ * the IRQ flags the firmware polls.  Transmissions take the LoRa time on air,
+ * CAD takes about 1.3 symbols and RX single times out after SYMB_TIMEOUT
+ * symbols.  Nothing is ever received.
+ * Author: Andy Page
+ * Version: 1, 19th October 2026
+ */
+
+#include <xc.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "LoRa.h"
+
+#define SX_STATE_SLEEP 0
+#define SX_STATE_STANDBY 1
+#define SX_STATE_TX 2
+#define SX_STATE_RX 3
+#define SX_STATE_CAD 4
+
+static uint8_t reg[0x80];
+static uint8_t fifo[256];
+static uint8_t address = 0;
+static uint8_t writing = 0;
+static uint8_t first = 1;       //Next byte is the address
+static uint8_t state = SX_STATE_STANDBY;
+static uint64_t eventAt = 0;    //End of TX, CAD or the RX window, 0 for none
+
+static double bandwidthHz(void){
+    static const double bandwidth[10] = {7800, 10400, 15600, 20800, 31250, 41700, 62500, 125000, 250000, 500000};
+    uint8_t bw = reg[MODEM_CONFIG_1_REG]>>4;
+    return bandwidth[bw<10 ? bw : 7];
+}
+
+static uint8_t spreadingFactor(void){
+    uint8_t sf = reg[MODEM_CONFIG_2_REG]>>4;
+    return sf<6 ? 6 : sf>12 ? 12 : sf;
+}
+
+static double symbolNs(void){
+    return (1u<<spreadingFactor())/bandwidthHz()*1.0e9;
+}
+
+/**
+ * LoRa time on air (SX1276 datasheet section 4.1.1.7).
+ */
+static uint64_t airtimeNs(uint8_t length){
+    uint8_t sf = spreadingFactor();
+    uint8_t cr = (reg[MODEM_CONFIG_1_REG]>>1) & 0x07;
+    uint8_t implicit = reg[MODEM_CONFIG_1_REG] & 0x01;
+    uint8_t crc = (reg[MODEM_CONFIG_2_REG]>>2) & 0x01;
+    uint8_t ldro = (reg[MODEM_CONFIG_3_REG]>>3) & 0x01;
+    uint16_t preamble = (uint16_t)reg[PREAMBLE_MSB_REG]<<8 | reg[PREAMBLE_LSB_REG];
+    double payload = ceil((8.0*length-4.0*sf+28+16*crc-20*implicit)/(4.0*(sf-2*ldro)))*(cr+4);
+    if(payload<0){
+        payload = 0;
+    }
+    return (uint64_t)((preamble+4.25+8+payload)*symbolNs());
+}
+
+static void toStandby(void){
+    reg[OP_MODE_REG] = (reg[OP_MODE_REG] & 0xF8) | STANDBY_MODE;
+    state = SX_STATE_STANDBY;
+    eventAt = 0;
+}
+
+static void opModeWrite(uint8_t value){
+    //LongRangeMode only changes in sleep, the chip ignores it otherwise
+    if(((value^reg[OP_MODE_REG]) & LORA_MODE) && (reg[OP_MODE_REG] & 0x07)!=SLEEP_MODE){
+        value = (value & ~LORA_MODE) | (reg[OP_MODE_REG] & LORA_MODE);
+    }
+    reg[OP_MODE_REG] = value;
+    eventAt = 0;
+    switch(value & 0x07){
+        case SLEEP_MODE:
+            state = SX_STATE_SLEEP;
+            memset(fifo, 0, sizeof fifo); //FIFO is cleared in sleep
+            break;
+        case TX_MODE:
+            state = SX_STATE_TX;
+            simCycle.paConfig = reg[PA_CONFIG_REG];
+            eventAt = simNow + airtimeNs(reg[PAYLOAD_LENGTH_REG]);
+            break;
+        case RX_CONT_MODE:
+            state = SX_STATE_RX;
+            break;
+        case RX_SINGLE_MODE:
+            state = SX_STATE_RX;
+            eventAt = simNow + (uint64_t)((((reg[MODEM_CONFIG_2_REG] & 0x03)<<8) | reg[SYMB_TIMEOUT_LSB_REG])*symbolNs());
+            break;
+        case CAD_MODE:
+            state = SX_STATE_CAD;
+            eventAt = simNow + (uint64_t)(1.3*symbolNs());
+            break;
+        default:
+            state = SX_STATE_STANDBY; //Standby and the synthesiser modes
+            break;
+    }
+}
+
+static void registerWrite(uint8_t a, uint8_t value){
+    if(a==FIFO_REG){
+        fifo[reg[FIFO_ADD_PTR_REG]++] = value;
+    }
+    else if(a==OP_MODE_REG){
+        opModeWrite(value);
+    }
+    else if(a==IRQ_FLAGS_REG){
+        reg[IRQ_FLAGS_REG] &= ~value; //Write 1 to clear
+    }
+    else if(a!=VERSION_REG && a!=RX_NB_BYTES_REG && a!=MODEM_STAT_REG){
+        reg[a] = value;
+    }
+}
+
+static uint8_t registerRead(uint8_t a){
+    if(a==FIFO_REG){
+        return fifo[reg[FIFO_ADD_PTR_REG]++];
+    }
+    return reg[a];
+}
+
+void Sx1276Reset(void){
+    memset(reg, 0, sizeof reg);
+    memset(fifo, 0, sizeof fifo);
+    reg[OP_MODE_REG] = 0x09;
+    reg[FRF_MSB_REG] = 0x6C;
+    reg[FRF_MID_REG] = 0x80;
+    reg[PA_CONFIG_REG] = 0x4F;
+    reg[PA_RAMP_REG] = 0x09;
+    reg[OCP_REG] = 0x2B;
+    reg[LNA_REG] = 0x20;
+    reg[FIFO_TX_BASE_ADDR_REG] = 0x80;
+    reg[MODEM_CONFIG_1_REG] = 0x72;
+    reg[MODEM_CONFIG_2_REG] = 0x70;
+    reg[SYMB_TIMEOUT_LSB_REG] = 0x64;
+    reg[PREAMBLE_LSB_REG] = 0x08;
+    reg[PAYLOAD_LENGTH_REG] = 0x01;
+    reg[MAX_PAYLOAD_LENGTH_REG] = 0xFF;
+    reg[SYNC_VALUE_REG] = 0x12;
+    reg[VERSION_REG] = 0x12;
+    reg[PA_DAC_REG] = 0x84;
+    state = SX_STATE_STANDBY;
+    eventAt = 0;
+    first = 1;
+}
+
+/**
+ * One SPI byte while nSS is low.
+ * @param data  Byte from the PIC
+ * @return Byte to the PIC
+ */
+uint8_t Sx1276Transfer(uint8_t data){
+    if(first){
+        first = 0;
+        address = data & 0x7F;
+        writing = data & 0x80;
+        return 0;
+    }
+    uint8_t reply = 0;
+    if(writing){
+        registerWrite(address, data);
+    }
+    else{
+        reply = registerRead(address);
+    }
+    if(address!=FIFO_REG){
+        address = (address+1) & 0x7F; //Burst access
+    }
+    return reply;
+}
+
+void Sx1276Deselect(void){
+    first = 1;
+}
+
+/**
+ * Completes TX, CAD or the RX window once the virtual clock reaches it.
+ */
+void Sx1276Advance(void){
+    if(!eventAt || simNow<eventAt){
+        return;
+    }
+    if(state==SX_STATE_TX){
+        uint8_t base = reg[FIFO_TX_BASE_ADDR_REG];
+        uint8_t packet[256];
+        for(uint16_t i=0;i<reg[PAYLOAD_LENGTH_REG];i++){
+            packet[i] = fifo[(uint8_t)(base+i)];
+        }
+        reg[IRQ_FLAGS_REG] |= IRQ_TX_DONE;
+        toStandby();
+        SimPacketSent(packet, reg[PAYLOAD_LENGTH_REG]);
+    }
+    else if(state==SX_STATE_CAD){
+        reg[IRQ_FLAGS_REG] |= IRQ_CAD_DONE;
+        if(rand()<simConfig.cadBusy*RAND_MAX){
+            reg[IRQ_FLAGS_REG] |= IRQ_CAD_DETECTED;
+        }
+        toStandby();
+    }
+    else if(state==SX_STATE_RX){
+        reg[IRQ_FLAGS_REG] |= IRQ_RX_TIMEOUT;
+        toStandby();
+    }
+    eventAt = 0;
+}
+
+uint64_t Sx1276NextEvent(void){
+    return eventAt ? eventAt : UINT64_MAX;
+}
+
+uint8_t Sx1276State(void){
+    return state;
+}
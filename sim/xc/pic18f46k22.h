@@ -0,0 +1,8 @@
+/*
+ * File:   pic18f46k22.h
+ * Author: Andy Page
+ * Comments: Host stand-in, everything is in xc.h.
+ * Revision history: 1, 19th October 2026
+ */
+
+#include <xc.h>
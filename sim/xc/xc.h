@@ -0,0 +1,29 @@
+/*
+ * File:   xc.h
+ * Author: Andy Page
+ * Comments: Host stand-in for the XC8 <xc.h>, used only by the simulator
+ *           build.  SFRs come from sfr.h, delays charge the virtual clock
+ *           in instruction cycles (so they stretch at 31kHz as they do on
+ *           the PIC) and SLEEP() hands over to the simulator.
+ * Revision history: 1, 19th October 2026
+ */
+
+#ifndef INC_XC_H
+#define	INC_XC_H
+
+#include <stdint.h>
+#include <stdio.h>  //Before the putchar rename below
+#include "sfr.h"
+#include "sim.h"
+#include "hal.h"
+
+#define putchar FirmwarePutchar //usart2.c has its own putchar(char)
+
+#define __delay_us(x) SimDelayCycles((uint32_t)((x)*(_XTAL_FREQ/4000000.0)))
+#define __delay_ms(x) SimDelayCycles((uint32_t)((x)*(_XTAL_FREQ/4000.0)))
+#define SLEEP() SimSleep()
+#define CLRWDT() SimClearWatchdog()
+#define NOP()
+#define __interrupt(x)
+
+#endif	/* INC_XC_H */
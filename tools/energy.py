@@ -0,0 +1,182 @@
+#!/usr/bin/env python3
+"""
+energy.py
+Charge per wake cycle and battery life from a timing profile.  The profile is
+either the per-cycle CSV written by the simulator (sim/, -o cycles.csv) or the
+phase times sent by a PROFILE build (packet bytes 34 to 47, see profile.h) in
+a packets file of hex lines.  Currents for each state come from currents.txt.
+
+Usage:
+    python3 energy.py cycles.csv
+    python3 energy.py --interval 300 --pa 0x8C cycles.csv
+    python3 energy.py --profile packets.txt
+    python3 energy.py before.csv after.csv      (ranks the runs by charge)
+Author: Andy Page
+Version: 1, 19th October 2026
+"""
+
+import argparse
+import csv
+import os
+
+CURRENTS = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'currents.txt')
+PROFILE_OFFSET = 34
+PROFILE_BITS = 14
+PROFILE_UNIT_S = 200e-6
+HOURS_PER_YEAR = 8766.0
+
+# Power states in each profile.h phase.  Low power delays are counted as idle
+# on LFINTOSC, the TxDone wait polls with __delay_ms on HFINTOSC.
+PROFILE_PHASES = [
+    ('init', ['pic_run_hf', 'rail_on']),
+    ('bh1750', ['pic_idle_lf', 'rail_on', 'bh1750_active']),
+    ('veml6075', ['pic_idle_lf', 'rail_on']),
+    ('adc', ['pic_run_hf', 'rail_on']),
+    ('radio_start', ['pic_run_hf', 'radio_standby']),
+    ('fifo', ['pic_run_hf', 'radio_standby', 'radio_cad', 'led_red']),
+    ('tx_wait', ['pic_run_hf', 'radio_tx']),
+    ('sleep_entry', ['pic_run_hf']),
+]
+PROFILE_BYTES = len(PROFILE_PHASES) * PROFILE_BITS // 8
+
+
+def load_currents(path):
+    """Returns ({state: uA}, {pa_config: uA}, {setting: value})."""
+    states, pa, battery = {}, {}, {}
+    with open(path) as f:
+        for line in f:
+            fields = line.split('#')[0].split()
+            if len(fields) == 3 and fields[0] == 'pa':
+                pa[int(fields[1], 0)] = float(fields[2])
+            elif len(fields) == 2 and fields[0] in ('battery_mah', 'self_discharge'):
+                battery[fields[0]] = float(fields[1])
+            elif len(fields) == 2:
+                states[fields[0]] = float(fields[1])
+    return states, pa, battery
+
+
+def read_sim(path):
+    """One {state: seconds} per wake cycle from a simulator CSV, plus
+    'awake', 'period' (wake to wake) and 'pa' (PA_CONFIG_REG during TX).
+    The watchdog sleep is left out of the states, it is charged separately
+    for the reporting interval."""
+    cycles = []
+    with open(path, newline='') as f:
+        for row in csv.DictReader(f):
+            cycle = {k[:-3]: float(v) / 1e6 for k, v in row.items() if k.endswith('_us')}
+            period = sum(v for k, v in cycle.items() if k.startswith('pic_'))
+            awake = float(row['awake_us']) / 1e6
+            cycle.pop('awake')
+            cycle['pic_sleep'] -= period - awake  # Leaves sleeps during ADC conversions
+            cycle['radio_sleep'] = max(cycle['radio_sleep'] - (period - awake), 0.0)
+            cycle.update(awake=awake, period=period, pa=int(row['pa_config']))
+            cycles.append(cycle)
+    return cycles
+
+
+def read_profile(path, interval, pa):
+    """One {state: seconds} per packet from the profile.h phase times."""
+    cycles = []
+    with open(path) as f:
+        for line in f:
+            fields = line.split()
+            if not fields:
+                continue
+            data = bytes.fromhex(fields[-1])
+            if len(data) < PROFILE_OFFSET + PROFILE_BYTES:
+                continue
+            packed = int.from_bytes(data[PROFILE_OFFSET:PROFILE_OFFSET + PROFILE_BYTES], 'big')
+            cycle = {}
+            awake = 0.0
+            for i, (_, states) in enumerate(PROFILE_PHASES):
+                shift = (len(PROFILE_PHASES) - 1 - i) * PROFILE_BITS
+                seconds = (packed >> shift & ((1 << PROFILE_BITS) - 1)) * PROFILE_UNIT_S
+                awake += seconds
+                for state in states:
+                    cycle[state] = cycle.get(state, 0.0) + seconds
+            cycle.update(awake=awake, period=max(interval, awake), pa=pa)
+            cycles.append(cycle)
+    return cycles
+
+
+def state_current(state, pa, states, pa_table):
+    if state == 'radio_tx':
+        if pa not in pa_table:
+            raise SystemExit('energy.py: no TX current for PA_CONFIG 0x%02X in currents.txt' % pa)
+        return pa_table[pa]
+    return states.get(state, 0.0)
+
+
+def analyse(cycles, states, pa_table, pa_override):
+    """Mean seconds and microcoulombs per cycle for each state while awake,
+    mean awake time and mean period."""
+    time, charge = {}, {}
+    for cycle in cycles:
+        pa = pa_override if pa_override is not None else cycle['pa']
+        for state, seconds in cycle.items():
+            if state in ('awake', 'period', 'pa'):
+                continue
+            time[state] = time.get(state, 0.0) + seconds / len(cycles)
+            uc = seconds * state_current(state, pa, states, pa_table)
+            charge[state] = charge.get(state, 0.0) + uc / len(cycles)
+    awake = sum(c['awake'] for c in cycles) / len(cycles)
+    period = sum(c['period'] for c in cycles) / len(cycles)
+    return time, charge, awake, period
+
+
+def life_years(average_ua, battery):
+    """Battery life, self discharge taken as a fixed current."""
+    mah = battery.get('battery_mah', 7000.0)
+    leak_ua = mah * 1000.0 * battery.get('self_discharge', 0.0) / 100.0 / HOURS_PER_YEAR
+    return mah * 1000.0 / (average_ua + leak_ua) / HOURS_PER_YEAR
+
+
+def report(name, cycles, args, states, pa_table, battery):
+    time, charge, awake, period = analyse(cycles, states, pa_table, args.pa)
+    interval = args.interval or period
+    sleep = max(interval - awake, 0.0)
+    awake_uc = sum(charge.values())
+    sleep_uc = states.get('pic_sleep', 0.0) * sleep
+    total_uc = awake_uc + sleep_uc
+    average_ua = total_uc / interval
+    years = life_years(average_ua, battery)
+    print('%s: %d cycles, awake %.1f ms, reporting every %.1f s' % (name, len(cycles), awake * 1e3, interval))
+    print('  %-16s %12s %10s %12s %7s' % ('state', 'ms/cycle', 'uA', 'uC/cycle', 'share'))
+    rows = [(state, time[state], charge[state]) for state in charge if time[state] > 0]
+    rows.append(('watchdog sleep', sleep, sleep_uc))
+    for state, seconds, uc in sorted(rows, key=lambda r: -r[2]):
+        print('  %-16s %12.2f %10.1f %12.2f %6.1f%%' % (state, seconds * 1e3, uc / seconds if seconds else 0.0,
+                                                       uc, 100.0 * uc / total_uc))
+    print('  %-16s %12s %10s %12.2f' % ('total', '', '', total_uc))
+    print('  awake %.2f uC, sleep %.2f uC, average %.2f uA, %.2f years on %.0f mAh'
+          % (awake_uc, sleep_uc, average_ua, years, battery.get('battery_mah', 7000.0)))
+    return total_uc, average_ua, years
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Wake cycle charge and battery life')
+    parser.add_argument('inputs', nargs='+', help='simulator CSV files (or packet files with --profile)')
+    parser.add_argument('--profile', action='store_true', help='inputs are packets with profile.h phase times')
+    parser.add_argument('--interval', type=float, help='reporting interval in seconds (default: as profiled, 60 for --profile)')
+    parser.add_argument('--pa', type=lambda v: int(v, 0), help='PA_CONFIG_REG value for TX (default: as simulated, 0x8F for --profile)')
+    parser.add_argument('--currents', default=CURRENTS, help='current table (default: currents.txt)')
+    args = parser.parse_args()
+    states, pa_table, battery = load_currents(args.currents)
+    results = []
+    for path in args.inputs:
+        if args.profile:
+            cycles = read_profile(path, args.interval or 60.0, args.pa if args.pa is not None else 0x8F)
+        else:
+            cycles = read_sim(path)
+        if not cycles:
+            raise SystemExit('energy.py: no cycles in %s' % path)
+        results.append((path,) + report(path, cycles, args, states, pa_table, battery))
+        print()
+    if len(results) > 1:
+        print('%-32s %12s %10s %8s' % ('ranked', 'uC/cycle', 'uA', 'years'))
+        for path, uc, ua, years in sorted(results, key=lambda r: r[1]):
+            print('%-32s %12.2f %10.2f %8.2f' % (path, uc, ua, years))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""
+tracedecode.py
+Turns the binary debug trace from the sensor (DEBUG builds, USART2 at 57600)
+back into text.  Event names are read from trace.h so there is only one list.
+Bytes that are not part of a valid event (e.g. LoRaDumpRegisters() output)
+are passed through as text.
+
+Usage:
+    stty -F /dev/ttyUSB0 57600 raw && python3 tracedecode.py /dev/ttyUSB0
+    python3 tracedecode.py capture.bin
+    python3 tracedecode.py < capture.bin
+Author: Andy Page
+Version: 1, 19th October 2026
+"""
+
+import os
+import re
+import sys
+
+TRACE_H = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                       '..', 'PIC18F46K22_LoRA_UVVIS_V5.X', 'trace.h')
+FRAME_LENGTH = 5
+
+
+def load_events(path):
+    """Returns (sync byte, {id: (name, comment)}) from trace.h."""
+    sync = 0xA5
+    events = {}
+    pattern = re.compile(r'#define\s+TRACE_(\w+)\s+(0x[0-9A-Fa-f]+|\d+)\s*(?://\s*(.*))?')
+    with open(path, encoding='latin-1') as f:
+        for line in f:
+            m = pattern.match(line.strip())
+            if not m:
+                continue
+            name, value, comment = m.group(1), int(m.group(2), 0), (m.group(3) or '').strip()
+            if name == 'SYNC':
+                sync = value
+            else:
+                events[value] = (name, comment)
+    return sync, events
+
+
+def decode(data, sync, events, out):
+    """Decodes a complete byte string, returns the number of bytes used."""
+    i = 0
+    text = bytearray()
+    while i < len(data):
+        if data[i] == sync:
+            if len(data) - i < FRAME_LENGTH:
+                break  # Wait for the rest of the frame
+            eid, msb, lsb, check = data[i + 1:i + FRAME_LENGTH]
+            if (eid + msb + lsb) & 0xFF == check and eid in events:
+                if text:
+                    out.write(text.decode('latin-1'))
+                    text.clear()
+                name, comment = events[eid]
+                value = msb << 8 | lsb
+                out.write('%-14s %5u  0x%04X  %s\n' % (name, value, value, comment))
+                i += FRAME_LENGTH
+                continue
+        text.append(data[i])
+        i += 1
+    if text:
+        out.write(text.decode('latin-1'))
+    return i
+
+
+def main():
+    sync, events = load_events(os.environ.get('TRACE_H', TRACE_H))
+    stream = open(sys.argv[1], 'rb', buffering=0) if len(sys.argv) > 1 else sys.stdin.buffer
+    pending = b''
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            break
+        pending += chunk
+        used = decode(pending, sync, events, sys.stdout)
+        pending = pending[used:]
+        sys.stdout.flush()
+    if pending:
+        sys.stdout.write(pending.decode('latin-1'))
+
+
+if __name__ == '__main__':
+    main()